@@ -0,0 +1,589 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "itensor/all.h"
+#include "sample/src/ctmrg.h"
+#include "sample/src/trg.h"
+#include "sample/src/ising.h"
+#include "benchmark/json.h"
+#include "benchmark/compare.h"
+
+//
+// End-to-end benchmarks of the sample/ workloads
+//
+// Every workload runs with a fixed random seed and a fixed
+// Sweeps schedule whose bond dimensions are multiplied by
+// the scale. Each (workload,scale) runs in its own process
+// so that the peak resident memory is its own.
+//
+
+using namespace itensor;
+using std::string;
+using std::vector;
+using clock_type = std::chrono::steady_clock;
+
+double
+secondsSince(clock_type::time_point t0)
+    {
+    return std::chrono::duration<double>(clock_type::now()-t0).count();
+    }
+
+//Peak resident set size of this process in MB
+double
+peakRSS()
+    {
+    struct rusage r;
+    getrusage(RUSAGE_SELF,&r);
+#ifdef __APPLE__
+    return r.ru_maxrss/(1024.*1024.);
+#else
+    return r.ru_maxrss/1024.;
+#endif
+    }
+
+long
+matvecs()
+    {
+    return profiler().calls("dmrg sweep/davidson/product");
+    }
+
+//
+// Records the wall time, matrix-vector products
+// (Davidson iterations), energy, truncation error
+// and bond dimension of every sweep
+//
+class BenchObserver : public DMRGObserver
+    {
+    clock_type::time_point mark_ = clock_type::now();
+    long matvecs_ = 0;
+    Real sweep_te_ = 0.;
+    Json sweeps_ = Json::array();
+    public:
+
+    BenchObserver(MPS const& psi)
+      : DMRGObserver(psi,{"PrintEigs",false}),
+        matvecs_(matvecs())
+        { }
+
+    void
+    measure(Args const& args) override
+        {
+        DMRGObserver::measure(args);
+        sweep_te_ = std::max(sweep_te_,args.getReal("Truncerr",0.));
+        if(args.getInt("AtBond",1) != 1 || args.getInt("HalfSweep",0) != 2) return;
+
+        auto nmv = matvecs();
+        auto sw = Json::object();
+        sw["sweep"] = args.getInt("Sweep",0);
+        sw["time_s"] = secondsSince(mark_);
+        sw["matvecs"] = nmv-matvecs_;
+        sw["energy"] = args.getReal("Energy",0.);
+        sw["max_truncerr"] = sweep_te_;
+        sw["max_linkdim"] = maxLinkDim(psi());
+        sweeps_.push_back(sw);
+
+        mark_ = clock_type::now();
+        matvecs_ = nmv;
+        sweep_te_ = 0.;
+        }
+
+    Json const&
+    sweeps() const { return sweeps_; }
+    };
+
+//Sweeps with the bond dimensions of maxdims times scale
+Sweeps
+scaledSweeps(vector<int> const& maxdims,
+             int scale,
+             Real cutoff,
+             vector<Real> const& noise,
+             int niter = 2)
+    {
+    auto sweeps = Sweeps(maxdims.size());
+    for(auto n : range1(maxdims.size()))
+        {
+        sweeps.setmaxdim(n,scale*maxdims[n-1]);
+        sweeps.setcutoff(n,cutoff);
+        sweeps.setniter(n,niter);
+        sweeps.setnoise(n,n <= noise.size() ? noise[n-1] : 0.);
+        }
+    return sweeps;
+    }
+
+Json
+runDMRG(MPO const& H,
+        MPS const& psi0,
+        Sweeps const& sweeps)
+    {
+    profiler().enable(true);
+    auto psi = psi0;
+    auto obs = BenchObserver(psi);
+    auto t0 = clock_type::now();
+    auto mv0 = matvecs();
+    auto energy = dmrg(psi,H,sweeps,obs,{"Silent",true});
+    auto res = Json::object();
+    res["time_s"] = secondsSince(t0);
+    res["matvecs"] = matvecs()-mv0;
+    auto te = 0.;
+    for(auto& sw : obs.sweeps().elems()) te = std::max(te,sw.get("max_truncerr").number());
+    res["max_truncerr"] = te;
+    res["max_linkdim"] = maxLinkDim(psi);
+    res["energy"] = energy;
+    res["sweeps"] = obs.sweeps();
+    return res;
+    }
+
+//
+// Workloads
+//
+
+//sample/dmrg.cc: S=1 Heisenberg chain
+Json
+heisenberg(int scale)
+    {
+    auto N = 100;
+    auto sites = SpinOne(N);
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo +=     "Sz",j,"Sz",j+1;
+        }
+    auto H = toMPO(ampo);
+    auto state = InitState(sites);
+    for(auto i : range1(N)) state.set(i,i%2 == 1 ? "Up" : "Dn");
+    auto sweeps = scaledSweeps({10,20,40,40,40},scale,1E-10,{1E-7,1E-8});
+    return runDMRG(H,MPS(state),sweeps);
+    }
+
+//sample/hubbard_2d.cc: 6x3 Hubbard model, U=4
+Json
+hubbard2d(int scale)
+    {
+    auto Nx = 6, Ny = 3;
+    auto N = Nx*Ny;
+    auto sites = Electron(N);
+    auto ampo = AutoMPO(sites);
+    for(auto j : squareLattice(Nx,Ny,{"YPeriodic=",true}))
+        {
+        ampo += -1.,"Cdagup",j.s1,"Cup",j.s2;
+        ampo += -1.,"Cdagup",j.s2,"Cup",j.s1;
+        ampo += -1.,"Cdagdn",j.s1,"Cdn",j.s2;
+        ampo += -1.,"Cdagdn",j.s2,"Cdn",j.s1;
+        }
+    for(auto j : range1(N)) ampo += 4.,"Nupdn",j;
+    auto H = toMPO(ampo);
+    auto state = InitState(sites);
+    for(auto j : range1(N)) state.set(j,j%2 == 1 ? "Up" : "Dn");
+    auto sweeps = scaledSweeps({20,40,60,60,60},scale,1E-8,{1E-7,1E-8,1E-10});
+    return runDMRG(H,randomMPS(state),sweeps);
+    }
+
+//sample/exthubbard.cc with inputfile_exthubbard
+Json
+exthubbard(int scale)
+    {
+    auto N = 20, Npart = 10;
+    auto t1 = 1., t2 = 0.2, U = 1., V1 = 0.5;
+    auto sites = Electron(N);
+    auto ampo = AutoMPO(sites);
+    for(auto i : range1(N)) ampo += U,"Nupdn",i;
+    for(auto b : range1(N-1))
+        {
+        ampo += -t1,"Cdagup",b,"Cup",b+1;
+        ampo += -t1,"Cdagup",b+1,"Cup",b;
+        ampo += -t1,"Cdagdn",b,"Cdn",b+1;
+        ampo += -t1,"Cdagdn",b+1,"Cdn",b;
+        ampo += V1,"Ntot",b,"Ntot",b+1;
+        }
+    for(auto b : range1(N-2))
+        {
+        ampo += -t2,"Cdagup",b,"Cup",b+2;
+        ampo += -t2,"Cdagup",b+2,"Cup",b;
+        ampo += -t2,"Cdagdn",b,"Cdn",b+2;
+        ampo += -t2,"Cdagdn",b+2,"Cdn",b;
+        }
+    auto H = toMPO(ampo);
+    auto state = InitState(sites);
+    auto p = Npart;
+    for(int i = N; i >= 1; --i)
+        {
+        if(p > i)      { state.set(i,"UpDn"); p -= 2; }
+        else if(p > 0) { state.set(i,(i%2 == 1 ? "Up" : "Dn")); p -= 1; }
+        else           { state.set(i,"Emp"); }
+        }
+    auto sweeps = scaledSweeps({25,50,100,100,100},scale,1E-12,{1E-7,1E-8,1E-10});
+    return runDMRG(H,MPS(state),sweeps);
+    }
+
+//sample/ctmrg.cc: 2D Ising model at beta = 1.1 betac
+Json
+ctmrgIsing(int scale)
+    {
+    auto beta = 1.1*0.5*std::log(std::sqrt(2.)+1.);
+    auto maxdim = 8*scale;
+    auto nsteps = 20;
+    auto s = Index(2,"Site");
+    auto sh = addTags(s,"horiz");
+    auto sv = addTags(s,"vert");
+    auto T = ising(sh,sv,beta);
+    auto l = Index(1,"Link");
+    auto lh = addTags(l,"horiz");
+    auto lv = addTags(l,"vert");
+    auto Clu0 = ITensor(lv,lh);
+    Clu0.set(1,1,1.0);
+    auto Al0 = ITensor(lv,prime(lv),sh);
+    Al0.set(lv=1,prime(lv)=1,sh=1,1.0);
+
+    auto t0 = clock_type::now();
+    auto [Clu,Al] = ctmrg(T,Clu0,Al0,maxdim,nsteps);
+    auto time = secondsSince(t0);
+
+    lv = commonIndex(Clu,Al);
+    lh = uniqueIndex(Clu,Al);
+    auto Au = replaceInds(Al,{lv,prime(lv),sh},{lh,prime(lh),sv});
+    auto ACl = Al*Clu*dag(prime(Clu));
+    auto kappa = elt(prime(ACl*dag(prime(Au))*T*Au,-1)*dag(ACl));
+    auto Tsz = ising(sh,sv,beta,true);
+    auto m = elt(prime(ACl*dag(prime(Au))*Tsz*Au,-1)*dag(ACl))/kappa;
+
+    auto res = Json::object();
+    res["time_s"] = time;
+    res["steps"] = nsteps;
+    res["maxdim"] = maxdim;
+    res["kappa"] = kappa;
+    res["magnetization"] = m;
+    return res;
+    }
+
+//The same model with the library CTMRG, with symmetric
+//or directional (four-direction) moves
+Json
+ctmrgLibrary(int scale,
+             bool symmetric)
+    {
+    auto beta = 1.1*0.5*std::log(std::sqrt(2.)+1.);
+    auto maxdim = 8*scale;
+    auto nsteps = 20;
+    auto s = Index(2,"Site");
+    auto sh = addTags(s,"horiz");
+    auto sv = addTags(s,"vert");
+    auto T = ising(sh,sv,beta);
+
+    auto t0 = clock_type::now();
+    auto ctm = CTMRG(T,sh,sv,{"MaxDim",maxdim,
+                              "Cutoff",0.,
+                              "Boundary","Fixed",
+                              "Symmetric",symmetric});
+    ctm.run({"MaxIter",nsteps,"MinIter",nsteps});
+    auto time = secondsSince(t0);
+
+    auto res = Json::object();
+    res["time_s"] = time;
+    res["steps"] = nsteps;
+    res["steps_per_s"] = nsteps/time;
+    res["maxdim"] = maxdim;
+    res["kappa"] = ctm.kappa();
+    res["magnetization"] = ctm.expect(ising(sh,sv,beta,true));
+    return res;
+    }
+
+//sample/trg.cc: 2D Ising model at beta = 1.1 betac
+Json
+trgIsing(int scale)
+    {
+    auto beta = 1.1*0.5*std::log(std::sqrt(2.)+1.);
+    auto maxdim = 8*scale;
+    auto topscale = 20;
+    auto s = Index(2);
+    auto sh = addTags(s,"horiz");
+    auto sv = addTags(s,"vert");
+    auto A0 = ising(sh,sv,beta);
+
+    auto t0 = clock_type::now();
+    auto [A,z] = trg(A0,maxdim,topscale);
+    (void)A;
+
+    auto res = Json::object();
+    res["time_s"] = secondsSince(t0);
+    res["steps"] = topscale;
+    res["maxdim"] = maxdim;
+    res["kappa"] = z;
+    return res;
+    }
+
+//The same model with the library TRG or HOTRG, with the
+//randomized or full SVD. The time per scale at full bond
+//dimension divided by chi^6 (TRG) or chi^7 (HOTRG) is the
+//constant of the leading scaling, to compare across scales.
+Json
+trgLibrary(int scale,
+           string const& method,
+           string const& svdmethod)
+    {
+    auto beta = 1.1*0.5*std::log(std::sqrt(2.)+1.);
+    auto maxdim = 8*scale;
+    auto nscales = 20;
+    auto s = Index(2);
+    auto sh = addTags(s,"horiz");
+    auto sv = addTags(s,"vert");
+    auto A0 = ising(sh,sv,beta);
+
+    auto t0 = clock_type::now();
+    auto trg = TRG(A0,sh,sv,{"MaxDim",maxdim,
+                             "Method",method,
+                             "SVDMethod",svdmethod});
+    auto lz = trg.run({"NScales",nscales});
+    auto time = secondsSince(t0);
+
+    auto fulltime = 0.;
+    auto nfull = 0;
+    auto maxte = 0.;
+    auto scales = Json::array();
+    for(auto& sc : trg.scales())
+        {
+        if(sc.maxdim == maxdim)
+            {
+            fulltime += sc.time;
+            ++nfull;
+            }
+        maxte = std::max(maxte,sc.truncerr);
+        auto js = Json::object();
+        js["scale"] = sc.scale;
+        js["time_s"] = sc.time;
+        js["logz"] = sc.logZ;
+        js["truncerr"] = sc.truncerr;
+        js["maxdim"] = sc.maxdim;
+        scales.push_back(js);
+        }
+    auto power = method == "HOTRG" ? 7 : 6;
+
+    auto res = Json::object();
+    res["time_s"] = time;
+    res["steps"] = nscales;
+    res["maxdim"] = maxdim;
+    res["kappa"] = std::exp(lz);
+    res["max_truncerr"] = maxte;
+    if(nfull > 0)
+        {
+        res["time_per_scale"] = fulltime/nfull;
+        res["scaling_const"] = fulltime/nfull/std::pow(maxdim,power);
+        }
+    res["scales"] = scales;
+    return res;
+    }
+
+std::vector<std::pair<string,std::function<Json(int)>>>
+workloads()
+    {
+    return {{"heisenberg",heisenberg},
+            {"hubbard_2d",hubbard2d},
+            {"exthubbard",exthubbard},
+            {"ctmrg",ctmrgIsing},
+            {"ctmrg_sym",[](int scale) { return ctmrgLibrary(scale,true); }},
+            {"ctmrg_dir",[](int scale) { return ctmrgLibrary(scale,false); }},
+            {"trg",trgIsing},
+            {"trg_lib",[](int scale) { return trgLibrary(scale,"TRG","randomized"); }},
+            {"trg_lib_full",[](int scale) { return trgLibrary(scale,"TRG","gesdd"); }},
+            {"hotrg",[](int scale) { return trgLibrary(scale,"HOTRG","randomized"); }}};
+    }
+
+//
+// Runs f(scale) in a child process and returns its
+// result with the peak memory of the child
+//
+Json
+runIsolated(std::function<Json(int)> const& f,
+            int scale,
+            int seed)
+    {
+    int fd[2];
+    if(pipe(fd) != 0) Error("algbench: pipe failed");
+    auto pid = fork();
+    if(pid < 0) Error("algbench: fork failed");
+    if(pid == 0)
+        {
+        close(fd[0]);
+        seedRNG(seed);
+        auto res = f(scale);
+        res["peak_rss_mb"] = peakRSS();
+        auto ss = std::ostringstream();
+        res.write(ss,1);
+        auto str = ss.str();
+        auto written = write(fd[1],str.data(),str.size());
+        close(fd[1]);
+        _exit(written == ssize_t(str.size()) ? 0 : 1);
+        }
+    close(fd[1]);
+    auto text = string();
+    char buf[4096];
+    ssize_t n = 0;
+    while((n = read(fd[0],buf,sizeof(buf))) > 0) text.append(buf,n);
+    close(fd[0]);
+    int status = 0;
+    waitpid(pid,&status,0);
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0 || text.empty())
+        {
+        auto res = Json::object();
+        res["error"] = "run failed";
+        return res;
+        }
+    return Json::parse(text);
+    }
+
+//
+// Metrics of each run compared with a baseline: time,
+// memory and matvecs as costs, and the results of the
+// algorithm as values, named e.g. "heisenberg/scale=2/time_s"
+//
+vector<BenchMetric>
+runMetrics(Json const& results)
+    {
+    auto ms = vector<BenchMetric>();
+    for(auto& r : results.get("runs").elems())
+        {
+        auto run = format("%s/scale=%d",r.get("workload").str(),long(r.get("scale").number()));
+        if(!r.get("error").isNull())
+            {
+            auto m = BenchMetric();
+            m.name = run + "/time_s";
+            m.failed = true;
+            ms.push_back(m);
+            continue;
+            }
+        for(string metric : {"time_s","peak_rss_mb","matvecs"})
+            {
+            if(!r.get(metric).isNull()) ms.push_back({run+"/"+metric,r.get(metric).number()});
+            }
+        for(string metric : {"energy","kappa","magnetization"})
+            {
+            if(!r.get(metric).isNull()) ms.push_back({run+"/"+metric,r.get(metric).number(),false});
+            }
+        }
+    return ms;
+    }
+
+void
+usage()
+    {
+    println("Usage: algbench [options]");
+    println("  --workload=<name>  only run this workload (may be repeated)");
+    println("  --scales=<list>    bond dimension scales, e.g. 1,2,4 (default 1,2)");
+    println("  --seed=<n>         random seed (default 1)");
+    println("  --out=<file>       JSON output (default algbench_results.json)");
+    println("  --baseline=<file>  compare with results of an earlier run");
+    println("  --tolerance=<x>    flag time, memory or matvecs above (1+x)*baseline (default 0.15)");
+    println("  --value-tolerance=<x>  flag results with relative change above x (default 1E-6)");
+    println("  --list             list the workloads and exit");
+    }
+
+int
+main(int argc, char* argv[])
+    {
+    auto selected = vector<string>();
+    auto scales = vector<int>{1,2};
+    auto seed = 1;
+    auto out = string("algbench_results.json"),
+         baseline = string();
+    auto args = Args();
+    for(auto n : range(1,argc))
+        {
+        auto a = string(argv[n]);
+        auto eq = a.find('=');
+        auto key = a.substr(0,eq),
+             val = eq == string::npos ? string() : a.substr(eq+1);
+        if(key == "--workload") selected.push_back(val);
+        else if(key == "--scales")
+            {
+            scales.clear();
+            auto ss = std::istringstream(val);
+            auto item = string();
+            while(std::getline(ss,item,',')) scales.push_back(std::atoi(item.c_str()));
+            }
+        else if(key == "--seed") seed = std::atoi(val.c_str());
+        else if(key == "--out") out = val;
+        else if(key == "--baseline") baseline = val;
+        else if(key == "--tolerance") args.add("Tolerance",std::atof(val.c_str()));
+        else if(key == "--value-tolerance") args.add("ValueTolerance",std::atof(val.c_str()));
+        else if(key == "--list")
+            {
+            for(auto& w : workloads()) println(w.first);
+            return 0;
+            }
+        else
+            {
+            usage();
+            return key == "--help" ? 0 : 1;
+            }
+        }
+
+    auto now = std::time(nullptr);
+    char date[64] = "";
+    std::strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%S",std::localtime(&now));
+    char host[256] = "";
+    gethostname(host,sizeof(host));
+
+    auto results = Json::object();
+    results["context"]["date"] = date;
+    results["context"]["host"] = host;
+    results["context"]["seed"] = seed;
+    results["runs"] = Json::array();
+
+    printfln("%-12s %5s %10s %10s %9s %20s","workload","scale","time (s)","RSS (MB)","matvecs","result");
+    for(auto& w : workloads())
+        {
+        if(!selected.empty() && std::find(selected.begin(),selected.end(),w.first) == selected.end()) continue;
+        for(auto scale : scales)
+            {
+            auto r = Json::object();
+            r["workload"] = w.first;
+            r["scale"] = scale;
+            r["seed"] = seed;
+            auto res = runIsolated(w.second,scale,seed);
+            for(auto k : range(res.keys().size())) r[res.keys()[k]] = res.elems()[k];
+            if(!r.get("error").isNull())
+                {
+                printfln("%-12s %5d  FAILED",w.first,scale);
+                }
+            else
+                {
+                auto val = r.get("energy").isNull() ? r.get("kappa") : r.get("energy");
+                printfln("%-12s %5d %10.3f %10.1f %9d %20.12f",w.first,scale,
+                         r.get("time_s").number(),r.get("peak_rss_mb").number(),
+                         long(r.get("matvecs").number()),val.number());
+                }
+            results["runs"].push_back(r);
+            }
+        }
+
+    std::ofstream f(out.c_str());
+    if(!f.good()) Error("algbench: couldn't open " + out);
+    results.write(f);
+    f << "\n";
+    printfln("\nWrote %s",out);
+    if(baseline != "")
+        {
+        auto nreg = compareMetrics(runMetrics(results),runMetrics(Json::read(baseline)),args);
+        return nreg > 0 ? 2 : 0;
+        }
+    return 0;
+    }
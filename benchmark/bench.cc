@@ -0,0 +1,317 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <unistd.h>
+#ifdef ITENSOR_USE_OMP
+#include <omp.h>
+#endif
+#include "bench.h"
+#include "compare.h"
+#include "json.h"
+#include "itensor/util/print_macro.h"
+#include "itensor/util/iterate.h"
+
+namespace itensor {
+
+using std::string;
+using std::vector;
+
+Bench::
+Bench(string name,
+      std::map<string,long> params,
+      Args const& args)
+  : params_(std::move(params)),
+    min_time_(args.getReal("MinTime",0.1)),
+    reps_(args.getInt("Reps",5))
+    {
+    res_.name = name;
+    }
+
+long Bench::
+param(string const& name) const
+    {
+    auto it = params_.find(name);
+    if(it == params_.end()) Error("Bench: no parameter " + name + " in " + res_.name);
+    return it->second;
+    }
+
+void Bench::
+measure(std::function<void()> const& f)
+    {
+    using clock_type = std::chrono::steady_clock;
+    auto since = [](clock_type::time_point t0)
+        {
+        return std::chrono::duration<double>(clock_type::now()-t0).count();
+        };
+
+    //Warm up and find the number of calls
+    //taking at least min_time_
+    long niter = 1;
+    while(true)
+        {
+        auto t0 = clock_type::now();
+        for(long i = 0; i < niter; ++i) f();
+        auto t = since(t0);
+        if(t >= min_time_ || niter >= (1L<<30)) break;
+        auto next = t > 0. ? long(1.2*niter*min_time_/t) : 10*niter;
+        niter = std::min(std::max(next,niter+1),10*niter);
+        }
+
+    auto times = vector<double>(reps_);
+    for(auto& t : times)
+        {
+        auto t0 = clock_type::now();
+        for(long i = 0; i < niter; ++i) f();
+        t = since(t0)/niter;
+        }
+    std::sort(times.begin(),times.end());
+    res_.iterations = niter;
+    res_.reps = reps_;
+    res_.min = times.front();
+    res_.max = times.back();
+    res_.median = times[times.size()/2];
+    }
+
+void BenchRegistry::
+add(string name,
+    BenchFunction f,
+    vector<std::pair<string,vector<long>>> params)
+    {
+    entries_.push_back({name,f,params});
+    }
+
+//Calls f(name,params) for every combination of parameter values
+template<typename F>
+void
+forEachCase(string const& name,
+            vector<std::pair<string,vector<long>>> const& params,
+            F && f)
+    {
+    auto n = params.size();
+    auto pos = vector<size_t>(n,0);
+    for(auto& p : params) if(p.second.empty()) return;
+    while(true)
+        {
+        auto full = name;
+        auto vals = std::map<string,long>();
+        for(auto j : range(n))
+            {
+            auto v = params[j].second[pos[j]];
+            full += format("/%s=%d",params[j].first,v);
+            vals[params[j].first] = v;
+            }
+        f(full,vals);
+        //Advance the last parameter fastest
+        auto j = long(n)-1;
+        for(; j >= 0; --j)
+            {
+            if(++pos[j] < params[j].second.size()) break;
+            pos[j] = 0;
+            }
+        if(j < 0) break;
+        }
+    }
+
+vector<string> BenchRegistry::
+names() const
+    {
+    auto res = vector<string>();
+    for(auto& e : entries_)
+        {
+        forEachCase(e.name,e.params,[&res](string const& full, std::map<string,long> const&)
+            {
+            res.push_back(full);
+            });
+        }
+    return res;
+    }
+
+vector<BenchResult> BenchRegistry::
+run(Args const& args) const
+    {
+    auto filter = args.getString("Filter","");
+    auto res = vector<BenchResult>();
+    printfln("%-44s %10s %12s %12s %9s %9s","benchmark","iters","median (s)","min (s)","GFLOP/s","GB/s");
+    for(auto& e : entries_)
+        {
+        forEachCase(e.name,e.params,[&](string const& full, std::map<string,long> const& vals)
+            {
+            if(full.find(filter) == string::npos) return;
+            auto B = Bench(full,vals,args);
+            e.f(B);
+            auto& r = B.result();
+            printfln("%-44s %10d %12.4E %12.4E %9.3f %9.3f",r.name,r.iterations,r.median,r.min,
+                     r.flops > 0 ? 1E-9*r.flops/r.median : 0.,
+                     r.bytes > 0 ? 1E-9*r.bytes/r.median : 0.);
+            res.push_back(r);
+            });
+        }
+    return res;
+    }
+
+Tensor
+benchTensor(vector<size_t> const& dims)
+    {
+    auto r = Range(dims);
+    auto T = Tensor(vector<Real>(dim(r)),std::move(r));
+    randomize(T);
+    return T;
+    }
+
+void
+writeBenchJSON(string const& fname,
+               vector<BenchResult> const& results)
+    {
+    std::ofstream f(fname.c_str());
+    if(!f.good()) Error("writeBenchJSON: couldn't open file " + fname);
+
+    char host[256] = "";
+    gethostname(host,sizeof(host));
+    auto now = std::time(nullptr);
+    char date[64] = "";
+    std::strftime(date,sizeof(date),"%Y-%m-%dT%H:%M:%S",std::localtime(&now));
+    auto threads = 1;
+#ifdef ITENSOR_USE_OMP
+    threads = omp_get_max_threads();
+#endif
+
+    auto json = Json::object();
+    json["context"]["date"] = date;
+    json["context"]["host"] = host;
+    json["context"]["threads"] = threads;
+    json["benchmarks"] = Json::array();
+    for(auto& r : results)
+        {
+        auto j = Json::object();
+        j["name"] = r.name;
+        j["iterations"] = r.iterations;
+        j["reps"] = r.reps;
+        j["median_s"] = r.median;
+        j["min_s"] = r.min;
+        j["max_s"] = r.max;
+        j["gflops"] = r.flops > 0 ? 1E-9*r.flops/r.median : 0.;
+        j["gbytes_s"] = r.bytes > 0 ? 1E-9*r.bytes/r.median : 0.;
+        json["benchmarks"].push_back(j);
+        }
+    json.write(f);
+    f << "\n";
+    }
+
+vector<BenchResult>
+readBenchJSON(string const& fname)
+    {
+    auto json = Json::read(fname);
+    auto res = vector<BenchResult>();
+    for(auto& j : json.get("benchmarks").elems())
+        {
+        auto r = BenchResult();
+        r.name = j.get("name").str();
+        r.iterations = long(j.get("iterations").number());
+        r.reps = long(j.get("reps").number());
+        r.median = j.get("median_s").number();
+        r.min = j.get("min_s").number();
+        r.max = j.get("max_s").number();
+        if(r.name != "") res.push_back(r);
+        }
+    return res;
+    }
+
+int
+compareBench(vector<BenchResult> const& results,
+             vector<BenchResult> const& baseline,
+             Args const& args)
+    {
+    auto medians = [](vector<BenchResult> const& rs)
+        {
+        auto ms = vector<BenchMetric>();
+        for(auto& r : rs) ms.push_back({r.name,r.median});
+        return ms;
+        };
+    return compareMetrics(medians(results),medians(baseline),args);
+    }
+
+} //namespace itensor
+
+using namespace itensor;
+
+void
+usage()
+    {
+    println("Usage: benchmark [options]");
+    println("  --filter=<str>     only run benchmarks whose name contains str");
+    println("  --out=<file>       write results as JSON (default bench_results.json)");
+    println("  --baseline=<file>  compare with results of an earlier run");
+    println("  --tolerance=<x>    flag benchmarks slower than (1+x)*baseline (default 0.15)");
+    println("  --min-time=<s>     minimum time per repetition (default 0.1)");
+    println("  --reps=<n>         repetitions, the median is reported (default 5)");
+    println("  --list             list benchmark names and exit");
+    }
+
+int
+main(int argc, char* argv[])
+    {
+    auto args = Args();
+    auto out = string("bench_results.json"),
+         baseline = string();
+    auto list = false;
+    for(auto n : range(1,argc))
+        {
+        auto a = string(argv[n]);
+        auto eq = a.find('=');
+        auto key = a.substr(0,eq),
+             val = eq == string::npos ? string() : a.substr(eq+1);
+        if(key == "--filter")         args.add("Filter",val);
+        else if(key == "--out")       out = val;
+        else if(key == "--baseline")  baseline = val;
+        else if(key == "--tolerance") args.add("Tolerance",std::atof(val.c_str()));
+        else if(key == "--min-time")  args.add("MinTime",std::atof(val.c_str()));
+        else if(key == "--reps")      args.add("Reps",std::atoi(val.c_str()));
+        else if(key == "--list")      list = true;
+        else
+            {
+            usage();
+            return key == "--help" ? 0 : 1;
+            }
+        }
+
+    auto R = BenchRegistry();
+    addContractBenchmarks(R);
+    addTensorBenchmarks(R);
+    addQDenseBenchmarks(R);
+    addDecompBenchmarks(R);
+
+    if(list)
+        {
+        for(auto& n : R.names()) println(n);
+        return 0;
+        }
+
+    auto results = R.run(args);
+    if(out != "")
+        {
+        writeBenchJSON(out,results);
+        printfln("\nWrote %s",out);
+        }
+    if(baseline != "")
+        {
+        auto nslow = compareBench(results,readBenchJSON(baseline),args);
+        return nslow > 0 ? 2 : 0;
+        }
+    return 0;
+    }
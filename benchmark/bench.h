@@ -0,0 +1,182 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_BENCH_H
+#define __ITENSOR_BENCH_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "itensor/util/args.h"
+#include "itensor/tensor/ten.h"
+
+//
+// Minimal micro-benchmark harness
+//
+// A benchmark is a function taking a Bench object;
+// it does its setup and then calls B.measure(f) with
+// the code to time:
+//
+//     void
+//     benchGemm(Bench & B)
+//         {
+//         auto n = B.param("n");
+//         auto A = randomMat(n,n), ...
+//         B.setFlops(2.*n*n*n);
+//         B.measure([&]{ gemm(A,B,C); });
+//         }
+//
+// and is registered for a list of parameter values:
+//
+//     R.add("gemm/real",benchGemm,{{"n",{64,128,256}}});
+//
+// which runs it once for every combination of
+// parameters, named e.g. "gemm/real/n=128".
+//
+// measure(f) calls f repeatedly until at least
+// "MinTime" seconds have passed, repeats this "Reps"
+// times and keeps the median time per call.
+//
+
+namespace itensor {
+
+struct BenchResult
+    {
+    std::string name;
+    long iterations = 0;  //calls of f per repetition
+    long reps = 0;
+    double median = 0.,   //seconds per call
+           min = 0.,
+           max = 0.,
+           flops = 0.,    //per call (0 if not set)
+           bytes = 0.;
+    };
+
+class Bench
+    {
+    std::map<std::string,long> params_;
+    double min_time_ = 0.1;
+    long reps_ = 5;
+    BenchResult res_;
+    public:
+
+    Bench(std::string name,
+          std::map<std::string,long> params,
+          Args const& args);
+
+    long
+    param(std::string const& name) const;
+
+    //Work done by one call of the measured function,
+    //to report GFLOP/s and GB/s
+    void
+    setFlops(double f) { res_.flops = f; }
+
+    void
+    setBytes(double b) { res_.bytes = b; }
+
+    void
+    measure(std::function<void()> const& f);
+
+    BenchResult const&
+    result() const { return res_; }
+    };
+
+using BenchFunction = std::function<void(Bench&)>;
+
+class BenchRegistry
+    {
+    struct Entry
+        {
+        std::string name;
+        BenchFunction f;
+        std::vector<std::pair<std::string,std::vector<long>>> params;
+        };
+    std::vector<Entry> entries_;
+    public:
+
+    void
+    add(std::string name,
+        BenchFunction f,
+        std::vector<std::pair<std::string,std::vector<long>>> params = {});
+
+    //Runs the benchmarks whose name contains "Filter"
+    //(default: all) and prints a line for each
+    std::vector<BenchResult>
+    run(Args const& args = Args::global()) const;
+
+    //Names of all benchmarks with their parameters
+    std::vector<std::string>
+    names() const;
+    };
+
+//
+// JSON results
+//
+// {
+// "context": {"date": ..., "host": ..., "threads": ...},
+// "benchmarks": [
+//   {"name": ..., "iterations": ..., "reps": ..., "median_s": ...,
+//    "min_s": ..., "max_s": ..., "gflops": ..., "gbytes_s": ...},
+//   ...
+//   ]
+// }
+//
+
+void
+writeBenchJSON(std::string const& fname,
+               std::vector<BenchResult> const& results);
+
+//Reads back the name and timings of each benchmark
+//from a file written by writeBenchJSON
+std::vector<BenchResult>
+readBenchJSON(std::string const& fname);
+
+//
+// Compares median times with those of baseline and
+// prints the ratio for each benchmark present in both.
+// Benchmarks slower than (1+"Tolerance") times the
+// baseline (default Tolerance=0.15) are flagged; returns
+// the number of flagged benchmarks.
+//
+int
+compareBench(std::vector<BenchResult> const& results,
+             std::vector<BenchResult> const& baseline,
+             Args const& args = Args::global());
+
+//Tensor with the given extents and random elements
+Tensor
+benchTensor(std::vector<size_t> const& dims);
+
+//
+// Benchmark suites (one per file)
+//
+
+void
+addContractBenchmarks(BenchRegistry & R);
+
+void
+addTensorBenchmarks(BenchRegistry & R);
+
+void
+addQDenseBenchmarks(BenchRegistry & R);
+
+void
+addDecompBenchmarks(BenchRegistry & R);
+
+} //namespace itensor
+
+#endif
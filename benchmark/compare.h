@@ -0,0 +1,100 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_BENCH_COMPARE_H
+#define __ITENSOR_BENCH_COMPARE_H
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+#include "itensor/util/args.h"
+#include "itensor/util/print.h"
+
+namespace itensor {
+
+//
+// One measured quantity of a benchmark run, used by
+// both the micro-benchmarks and the end-to-end
+// benchmarks in ../bench to check for regressions.
+//
+// A cost (time, memory, ...) regresses if it grows by
+// more than a factor (1+"Tolerance"); a value (energy,
+// ...) if its relative change exceeds "ValueTolerance".
+// A failed run has failed set and is always flagged.
+//
+struct BenchMetric
+    {
+    std::string name;
+    double x = 0.;
+    bool cost = true;
+    bool failed = false;
+    };
+
+//
+// Prints each metric of results next to the metric of
+// the same name in baseline, if any, and returns the
+// number of regressions. Default Tolerance=0.15 and
+// ValueTolerance=1E-6.
+//
+int inline
+compareMetrics(std::vector<BenchMetric> const& results,
+               std::vector<BenchMetric> const& baseline,
+               Args const& args = Args::global())
+    {
+    auto tol = args.getReal("Tolerance",0.15);
+    auto vtol = args.getReal("ValueTolerance",1E-6);
+    auto base = std::map<std::string,BenchMetric>();
+    for(auto& m : baseline) base[m.name] = m;
+
+    auto nreg = 0;
+    printfln("\n%-48s %14s %14s %9s","benchmark","baseline","current","change");
+    for(auto& m : results)
+        {
+        auto it = base.find(m.name);
+        if(it == base.end()) continue;
+        auto& b = it->second;
+        if(m.failed)
+            {
+            printfln("%-48s  FAILED",m.name);
+            ++nreg;
+            }
+        else if(m.cost)
+            {
+            if(b.x <= 0.) continue;
+            auto ratio = m.x/b.x;
+            auto slow = ratio > 1.+tol;
+            if(slow) ++nreg;
+            printfln("%-48s %14.6g %14.6g %9.3f%s",m.name,b.x,m.x,ratio,
+                     slow ? "  SLOWER" : (ratio < 1.-tol ? "  faster" : ""));
+            }
+        else
+            {
+            auto rel = std::fabs(m.x-b.x)/std::max(std::fabs(b.x),1E-14);
+            auto changed = rel > vtol;
+            if(changed) ++nreg;
+            printfln("%-48s %14.10f %14.10f %9.2E%s",m.name,b.x,m.x,rel,
+                     changed ? "  CHANGED" : "");
+            }
+        }
+    if(nreg > 0) printfln("\n%d regression%s against the baseline",nreg,nreg == 1 ? "" : "s");
+    else         printfln("\nNo regressions (tolerance %.0f%%, value tolerance %.0E)",100*tol,vtol);
+    return nreg;
+    }
+
+} //namespace itensor
+
+#endif
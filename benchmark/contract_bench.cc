@@ -0,0 +1,74 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cmath>
+#include "bench.h"
+#include "itensor/tensor/contract.h"
+
+namespace itensor {
+
+//
+// Dense contract() of order-3 tensors with all extents d.
+// The labels determine whether contract has to permute
+// A, B or C before and after the GEMM.
+//
+struct ContractPattern
+    {
+    std::string name;
+    Labels ai, bi, ci;
+    };
+
+std::vector<ContractPattern>
+contractPatterns()
+    {
+    return {
+        //Contracted indices contiguous: plain GEMM
+        {"matrix",   {1,2,3},{2,3,4},{1,4}},
+        //Contracted indices at the front of A: transposed GEMM
+        {"transA",   {2,3,1},{2,3,4},{1,4}},
+        //Contracted indices not contiguous in A or in B
+        {"permA",    {2,1,3},{2,3,4},{1,4}},
+        {"permB",    {1,2,3},{2,4,3},{1,4}},
+        {"permAB",   {2,1,3},{2,4,3},{1,4}},
+        //Uncontracted indices of A and B interleaved in C
+        {"permC",    {1,2,3},{3,4,5},{1,4,2,5}},
+        };
+    }
+
+void
+addContractBenchmarks(BenchRegistry & R)
+    {
+    for(auto& p : contractPatterns())
+        {
+        auto f = [p](Bench & B)
+            {
+            auto d = B.param("d");
+            auto dims = [d](Labels const& l) { return std::vector<size_t>(l.size(),d); };
+            auto A = benchTensor(dims(p.ai)),
+                 Bt = benchTensor(dims(p.bi)),
+                 C = benchTensor(dims(p.ci));
+            //Number of contracted indices
+            auto ncon = (p.ai.size()+p.bi.size()-p.ci.size())/2;
+            B.setFlops(2*std::pow(double(d),double(p.ai.size()+p.bi.size()-ncon)));
+            B.setBytes(8.*(dim(A.range())+dim(Bt.range())+dim(C.range())));
+            B.measure([&]{ contract(A,p.ai,Bt,p.bi,C,p.ci); });
+            };
+        auto ds = p.ci.size() > 2 ? std::vector<long>{8,16,32}
+                                  : std::vector<long>{16,32,64};
+        R.add("contract/"+p.name,f,{{"d",ds}});
+        }
+    }
+
+} //namespace itensor
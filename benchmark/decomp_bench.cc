@@ -0,0 +1,67 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "bench.h"
+#include "itensor/tensor/algs.h"
+
+namespace itensor {
+
+//
+// Dense decompositions of n x n matrices
+//
+
+template<typename V>
+Mat<V>
+randomSquare(long n)
+    {
+    if constexpr (std::is_same_v<V,Real>) return randomMat(n,n);
+    else                                   return randomMatC(n,n);
+    }
+
+template<typename V>
+void
+benchSVD(Bench & B)
+    {
+    auto n = B.param("n");
+    auto M = randomSquare<V>(n);
+    Mat<V> U,V_;
+    Vector d;
+    B.measure([&]{ SVD(M,U,d,V_); });
+    }
+
+template<typename V>
+void
+benchDiagHermitian(Bench & B)
+    {
+    auto n = B.param("n");
+    auto M = randomSquare<V>(n);
+    if constexpr (std::is_same_v<V,Real>) M = M+transpose(M);
+    else                                   M = M+conj(transpose(M));
+    Mat<V> U;
+    Vector d;
+    B.measure([&]{ diagHermitian(M,U,d); });
+    }
+
+void
+addDecompBenchmarks(BenchRegistry & R)
+    {
+    auto ns = std::vector<long>{32,64,128,256};
+    R.add("svd/real",benchSVD<Real>,{{"n",ns}});
+    R.add("svd/cplx",benchSVD<Cplx>,{{"n",ns}});
+    R.add("diagHermitian/real",benchDiagHermitian<Real>,{{"n",ns}});
+    R.add("diagHermitian/cplx",benchDiagHermitian<Cplx>,{{"n",ns}});
+    }
+
+} //namespace itensor
@@ -0,0 +1,285 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_BENCH_JSON_H
+#define __ITENSOR_BENCH_JSON_H
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "itensor/util/print.h"
+#include "itensor/util/error.h"
+#include "itensor/util/iterate.h"
+
+namespace itensor {
+
+//
+// Small JSON value, enough to write the benchmark
+// results and read them back for comparisons.
+// Objects keep their keys in insertion order.
+//
+class Json
+    {
+    public:
+    enum Type { Null, Bool, Number, String, Array, Object };
+    private:
+    Type type_ = Null;
+    bool b_ = false;
+    double x_ = 0.;
+    std::string s_;
+    std::vector<Json> elems_;
+    std::vector<std::string> keys_;
+    public:
+
+    Json() { }
+    Json(bool b) : type_(Bool), b_(b) { }
+    Json(double x) : type_(Number), x_(x) { }
+    Json(long x) : type_(Number), x_(x) { }
+    Json(int x) : type_(Number), x_(x) { }
+    Json(std::string s) : type_(String), s_(std::move(s)) { }
+    Json(char const* s) : type_(String), s_(s) { }
+
+    static Json
+    array() { auto j = Json(); j.type_ = Array; return j; }
+
+    static Json
+    object() { auto j = Json(); j.type_ = Object; return j; }
+
+    Type
+    type() const { return type_; }
+
+    bool
+    isNull() const { return type_ == Null; }
+
+    double
+    number() const { return type_ == Number ? x_ : 0.; }
+
+    std::string const&
+    str() const { return s_; }
+
+    //Array elements, or object values in key order
+    std::vector<Json> const&
+    elems() const { return elems_; }
+
+    std::vector<std::string> const&
+    keys() const { return keys_; }
+
+    void
+    push_back(Json v)
+        {
+        if(type_ == Null) type_ = Array;
+        elems_.push_back(std::move(v));
+        }
+
+    //Object member (added if missing)
+    Json&
+    operator[](std::string const& key)
+        {
+        if(type_ == Null) type_ = Object;
+        for(auto n : range(keys_.size())) if(keys_[n] == key) return elems_[n];
+        keys_.push_back(key);
+        elems_.emplace_back();
+        return elems_.back();
+        }
+
+    //Object member, or a null value if missing
+    Json const&
+    get(std::string const& key) const
+        {
+        static const Json null;
+        for(auto n : range(keys_.size())) if(keys_[n] == key) return elems_[n];
+        return null;
+        }
+
+    void
+    write(std::ostream& s, int indent = 0) const;
+
+    static Json
+    parse(std::string const& text);
+
+    static Json
+    read(std::string const& fname);
+
+    private:
+
+    static Json
+    parseValue(std::string const& t, size_t & p);
+    };
+
+void inline
+writeJsonString(std::ostream& s, std::string const& str)
+    {
+    s << '"';
+    for(auto c : str)
+        {
+        if(c == '"' || c == '\\') s << '\\' << c;
+        else if(c == '\n') s << "\\n";
+        else s << c;
+        }
+    s << '"';
+    }
+
+void inline Json::
+write(std::ostream& s, int indent) const
+    {
+    auto pad = [&s](int n) { s << "\n" << std::string(2*n,' '); };
+    switch(type_)
+        {
+        case Null: s << "null"; break;
+        case Bool: s << (b_ ? "true" : "false"); break;
+        case Number: s << format("%.15g",x_); break;
+        case String: writeJsonString(s,s_); break;
+        case Array:
+            {
+            //Arrays of numbers on one line
+            auto flat = true;
+            for(auto& e : elems_) if(e.type_ == Array || e.type_ == Object) flat = false;
+            s << "[";
+            for(auto n : range(elems_.size()))
+                {
+                if(n > 0) s << (flat ? ", " : ",");
+                if(!flat) pad(indent+1);
+                elems_[n].write(s,indent+1);
+                }
+            if(!flat && !elems_.empty()) pad(indent);
+            s << "]";
+            break;
+            }
+        case Object:
+            {
+            s << "{";
+            for(auto n : range(elems_.size()))
+                {
+                if(n > 0) s << ",";
+                pad(indent+1);
+                writeJsonString(s,keys_[n]);
+                s << ": ";
+                elems_[n].write(s,indent+1);
+                }
+            if(!elems_.empty()) pad(indent);
+            s << "}";
+            break;
+            }
+        }
+    }
+
+Json inline Json::
+parseValue(std::string const& t, size_t & p)
+    {
+    auto skip = [&t,&p]() { while(p < t.size() && std::isspace(t[p])) ++p; };
+    auto expect = [&t,&p](char c)
+        {
+        if(p >= t.size() || t[p] != c) Error(format("Json: expected '%c' at position %d",c,p));
+        ++p;
+        };
+    auto parseString = [&t,&p,&expect]()
+        {
+        expect('"');
+        auto s = std::string();
+        while(p < t.size() && t[p] != '"')
+            {
+            if(t[p] == '\\' && p+1 < t.size())
+                {
+                ++p;
+                s.push_back(t[p] == 'n' ? '\n' : t[p]);
+                }
+            else
+                {
+                s.push_back(t[p]);
+                }
+            ++p;
+            }
+        expect('"');
+        return s;
+        };
+
+    skip();
+    if(p >= t.size()) Error("Json: unexpected end of input");
+    auto c = t[p];
+    if(c == '{')
+        {
+        ++p;
+        auto obj = Json::object();
+        skip();
+        if(t[p] == '}') { ++p; return obj; }
+        while(true)
+            {
+            skip();
+            auto key = parseString();
+            skip();
+            expect(':');
+            obj[key] = parseValue(t,p);
+            skip();
+            if(t[p] == ',') { ++p; continue; }
+            expect('}');
+            return obj;
+            }
+        }
+    if(c == '[')
+        {
+        ++p;
+        auto arr = Json::array();
+        skip();
+        if(t[p] == ']') { ++p; return arr; }
+        while(true)
+            {
+            arr.push_back(parseValue(t,p));
+            skip();
+            if(t[p] == ',') { ++p; continue; }
+            expect(']');
+            return arr;
+            }
+        }
+    if(c == '"') return Json(parseString());
+    if(t.compare(p,4,"true") == 0) { p += 4; return Json(true); }
+    if(t.compare(p,5,"false") == 0) { p += 5; return Json(false); }
+    if(t.compare(p,4,"null") == 0) { p += 4; return Json(); }
+    char* end = nullptr;
+    auto x = std::strtod(t.c_str()+p,&end);
+    if(end == t.c_str()+p) Error(format("Json: unexpected character '%c' at position %d",c,p));
+    p = end-t.c_str();
+    return Json(x);
+    }
+
+Json inline Json::
+parse(std::string const& text)
+    {
+    size_t p = 0;
+    return parseValue(text,p);
+    }
+
+Json inline Json::
+read(std::string const& fname)
+    {
+    std::ifstream f(fname.c_str());
+    if(!f.good()) Error("Json: couldn't open file " + fname);
+    auto ss = std::stringstream();
+    ss << f.rdbuf();
+    return parse(ss.str());
+    }
+
+inline std::ostream&
+operator<<(std::ostream& s, Json const& j)
+    {
+    j.write(s);
+    return s;
+    }
+
+} //namespace itensor
+
+#endif
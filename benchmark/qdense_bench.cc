@@ -0,0 +1,138 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cmath>
+#include "bench.h"
+#include "itensor/itensor.h"
+#include "itensor/util/contractstats.h"
+
+namespace itensor {
+
+//
+// QDense contractions of MPS-like tensors A(l,s,r)
+// whose link indices have total dimension D split over
+// 2*h+1 sectors Sz = -h,...,h with sizes following
+// one of these synthetic distributions:
+//   "uniform": all sectors the same size
+//   "peaked":  gaussian in Sz, as for ground states of
+//              spin chains at Sz=0
+//   "skewed":  half of D in the Sz=0 sector, the
+//              rest spread evenly (many small blocks)
+//
+
+std::vector<long>
+sectorSizes(std::string const& dist,
+            long D,
+            long nsec)
+    {
+    auto w = std::vector<Real>(nsec,1.);
+    auto h = nsec/2;
+    if(dist == "peaked")
+        {
+        auto sigma = std::max(1.,nsec/6.);
+        for(auto n : range(nsec)) w[n] = std::exp(-sqr(n-h)/(2*sqr(sigma)));
+        }
+    else if(dist == "skewed")
+        {
+        w[h] = nsec-1;
+        }
+    else if(dist != "uniform")
+        {
+        Error("sectorSizes: unknown distribution " + dist);
+        }
+    auto W = 0.;
+    for(auto x : w) W += x;
+    auto sizes = std::vector<long>(nsec);
+    auto total = 0l;
+    for(auto n : range(nsec))
+        {
+        sizes[n] = std::max(1l,long(std::round(D*w[n]/W)));
+        total += sizes[n];
+        }
+    //Absorb rounding in the central sector
+    sizes[h] = std::max(1l,sizes[h]+D-total);
+    return sizes;
+    }
+
+Index
+sectorIndex(std::string const& dist,
+            long D,
+            long nsec,
+            std::string const& tags)
+    {
+    auto sizes = sectorSizes(dist,D,nsec);
+    auto qns = Index::qnstorage();
+    for(auto n : range(nsec)) qns.emplace_back(QN({"Sz",int(n-nsec/2)}),sizes[n]);
+    return Index(std::move(qns),tags);
+    }
+
+//FLOPs of the block GEMMs done by f, from the contraction stats
+template<typename F>
+double
+blockFlops(F const& f)
+    {
+    auto& S = contractStats();
+    auto was_enabled = S.enabled();
+    S.reset();
+    S.enable(true);
+    f();
+    S.enable(was_enabled);
+    auto flops = S.total().flops;
+    S.reset();
+    return flops;
+    }
+
+void
+benchQDense(Bench & B,
+            std::string const& dist,
+            bool env)
+    {
+    auto D = B.param("D");
+    auto nsec = B.param("sectors");
+    auto s = Index(QN({"Sz",-1}),1,QN({"Sz",1}),1,"Site");
+    auto l = sectorIndex(dist,D,nsec,"Link,l=1");
+    auto r = sectorIndex(dist,D,nsec,"Link,l=2");
+    auto A = randomITensor(QN({"Sz",0}),l,s,dag(r));
+    if(env)
+        {
+        //Contract s and r: A*dag(A'), as in a density matrix
+        auto Ad = dag(prime(A,l));
+        auto f = [&]{ auto R = A*Ad; };
+        B.setFlops(blockFlops(f));
+        B.measure(f);
+        }
+    else
+        {
+        //Contract the bond r
+        auto r2 = sectorIndex(dist,D,nsec,"Link,l=3");
+        auto A2 = randomITensor(QN({"Sz",0}),r,sim(s),dag(r2));
+        auto f = [&]{ auto R = A*A2; };
+        B.setFlops(blockFlops(f));
+        B.measure(f);
+        }
+    }
+
+void
+addQDenseBenchmarks(BenchRegistry & R)
+    {
+    auto params = std::vector<std::pair<std::string,std::vector<long>>>{{"D",{64,256}},{"sectors",{5,15}}};
+    for(std::string dist : {"uniform","peaked","skewed"})
+        {
+        R.add("qdense/bond/"+dist,[dist](Bench& B) { benchQDense(B,dist,false); },params);
+        R.add("qdense/env/"+dist,[dist](Bench& B) { benchQDense(B,dist,true); },params);
+        }
+    }
+
+} //namespace itensor
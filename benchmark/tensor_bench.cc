@@ -0,0 +1,76 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "bench.h"
+#include "itensor/tensor/mat.h"
+#include "itensor/tensor/sliceten.h"
+
+namespace itensor {
+
+//
+// gemm of n x n matrices: real, complex,
+// and real times complex (done as two real GEMMs)
+//
+
+template<typename VA, typename VB>
+void
+benchGemm(Bench & B)
+    {
+    auto n = B.param("n");
+    auto rand = [n](auto v)
+        {
+        if constexpr (std::is_same_v<decltype(v),Real>) return randomMat(n,n);
+        else                                             return randomMatC(n,n);
+        };
+    auto A = rand(VA{});
+    auto Bm = rand(VB{});
+    auto C = Mat<common_type<VA,VB>>(n,n);
+    auto fac = isCplx<VA>() && isCplx<VB>() ? 4. : (isCplx<VA>() || isCplx<VB>() ? 2. : 1.);
+    B.setFlops(fac*2.*n*n*n);
+    B.measure([&]{ gemm(makeRefc(A),makeRefc(Bm),makeRef(C),1.,0.); });
+    }
+
+//
+// Copying an order-4 tensor with all extents d
+// into permuted order, as done by contract
+//
+
+void
+benchPermute(Bench & B,
+             Labels const& P)
+    {
+    auto d = B.param("d");
+    auto T = benchTensor({size_t(d),size_t(d),size_t(d),size_t(d)});
+    auto PT = benchTensor({size_t(d),size_t(d),size_t(d),size_t(d)});
+    //Read and write every element
+    B.setBytes(2*8.*dim(T.range()));
+    B.measure([&]{ makeRef(PT) &= permute(T,P); });
+    }
+
+void
+addTensorBenchmarks(BenchRegistry & R)
+    {
+    auto ns = std::vector<long>{64,128,256,512};
+    R.add("gemm/real",benchGemm<Real,Real>,{{"n",ns}});
+    R.add("gemm/cplx",benchGemm<Cplx,Cplx>,{{"n",ns}});
+    R.add("gemm/real_cplx",benchGemm<Real,Cplx>,{{"n",ns}});
+
+    auto ds = std::vector<long>{8,16,32};
+    R.add("permute/swap01",[](Bench& B) { benchPermute(B,{1,0,2,3}); },{{"d",ds}});
+    R.add("permute/cycle",[](Bench& B) { benchPermute(B,{1,2,3,0}); },{{"d",ds}});
+    R.add("permute/reverse",[](Bench& B) { benchPermute(B,{3,2,1,0}); },{{"d",ds}});
+    }
+
+} //namespace itensor
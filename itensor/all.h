@@ -29,5 +29,7 @@
 //
 
 #include "itensor/all_mps.h"
+#include "itensor/tn/ctmrg.h"
+#include "itensor/tn/trg.h"
 
 #endif
@@ -30,6 +30,7 @@
 
 #include "itensor/decomp.h"
 #include "itensor/iterativesolvers.h"
+#include "itensor/tensorfile.h"
 #include "itensor/util/input.h"
 #include "itensor/util/autovector.h"
 #include "itensor/util/str.h"
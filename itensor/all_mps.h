@@ -36,6 +36,10 @@
 
 #include "itensor/mps/dmrg.h"
 #include "itensor/mps/tevol.h"
+#include "itensor/mps/tebd.h"
+#include "itensor/mps/swapnetwork.h"
+#include "itensor/mps/mpsreader.h"
+#include "itensor/mps/metts.h"
 #include "itensor/mps/autompo.h"
 
 #include "itensor/mps/lattice/square.h"
@@ -55,16 +55,34 @@ struct ToMatRefc
         : nrows(nr), ncols(nc), transpose(trans)
         { }
     };
-template<typename V>
+//Also views the data of mapped storage in place,
+//since a copy would not outlive the task
+template<typename V, typename DenseType>
 MatRefc<V>
-doTask(ToMatRefc<V> const& T, 
-       Dense<V> const& d)
+toMatRefcImpl(ToMatRefc<V> const& T, 
+              DenseType const& d)
     {
     auto res = makeMatRef(d.data(),d.size(),T.nrows,T.ncols);
     if(T.transpose) return transpose(res);
     return res;
     }
 
+template<typename V>
+MatRefc<V>
+doTask(ToMatRefc<V> const& T, 
+       Dense<V> const& d)
+    {
+    return toMatRefcImpl(T,d);
+    }
+
+template<typename V>
+MatRefc<V>
+doTask(ToMatRefc<V> const& T, 
+       MappedDense<V> const& d)
+    {
+    return toMatRefcImpl(T,d);
+    }
+
 template<typename V>
 MatRefc<V>
 toMatRefc(ITensor const& T, 
@@ -84,10 +102,10 @@ toMatRefc(ITensor const& T, Index const& i1, Index const& i2);
 
 /////////////
 
-template<typename T>
+template<typename T, typename QDenseType>
 vector<Ord2Block<T>>
-doTask(GetBlocks<T> const& G, 
-       QDense<T> const& d)
+getBlocksImpl(GetBlocks<T> const& G, 
+              QDenseType const& d)
     {
     if(G.is.order() != 2) Error("doTask(GetBlocks,QDenseReal) only supports 2-index tensors");
     auto res = vector<Ord2Block<T>>{d.offsets.size()};
@@ -111,11 +129,31 @@ doTask(GetBlocks<T> const& G,
         }
     return res;
     }
+
+template<typename T>
+vector<Ord2Block<T>>
+doTask(GetBlocks<T> const& G, 
+       QDense<T> const& d)
+    {
+    return getBlocksImpl(G,d);
+    }
 template vector<Ord2Block<Real>>
 doTask(GetBlocks<Real> const& G, QDense<Real> const& d);
 template vector<Ord2Block<Cplx>>
 doTask(GetBlocks<Cplx> const& G, QDense<Cplx> const& d);
 
+template<typename T>
+vector<Ord2Block<T>>
+doTask(GetBlocks<T> const& G, 
+       MappedQDense<T> const& d)
+    {
+    return getBlocksImpl(G,d);
+    }
+template vector<Ord2Block<Real>>
+doTask(GetBlocks<Real> const& G, MappedQDense<Real> const& d);
+template vector<Ord2Block<Cplx>>
+doTask(GetBlocks<Cplx> const& G, MappedQDense<Cplx> const& d);
+
 ///////////////
 
 Spectrum
@@ -125,6 +163,7 @@ svd(ITensor const& AA,
     ITensor & V,
     Args args)
     {
+    PROFILE_REGION("svd");
     if( args.defined("Minm") )
       {
       if( args.defined("MinDim") )
@@ -202,12 +241,18 @@ svd(ITensor const& AA,
           vi;
 
     auto AAcomb = AA;
-    if(!Uinds.empty())
+    if(!Uinds.empty() && !Vinds.empty())
+        {
+        std::tie(Ucomb,ui) = combiner(std::move(Uinds));
+        std::tie(Vcomb,vi) = combiner(std::move(Vinds));
+        AAcomb = matricize(AA,Ucomb,Vcomb);
+        }
+    else if(!Uinds.empty())
         {
         std::tie(Ucomb,ui) = combiner(std::move(Uinds));
         AAcomb *= Ucomb;
         }
-    if(!Vinds.empty())
+    else if(!Vinds.empty())
         {
         std::tie(Vcomb,vi) = combiner(std::move(Vinds));
         AAcomb *= Vcomb;
@@ -729,6 +774,7 @@ diagPosSemiDef(ITensor const& M,
                ITensor      & D,
                Args args)
     {
+    PROFILE_REGION("diagPosSemiDef");
     if(!args.defined("Tags")) args.add("Tags","Link");
 
     //
@@ -958,12 +1004,18 @@ qr(ITensor const& AA,
           ri;
 
     auto AAcomb = AA;
-    if(!Qinds.empty())
+    if(!Qinds.empty() && !Rinds.empty())
+        {
+        std::tie(Qcomb,qi) = combiner(std::move(Qinds));
+        std::tie(Rcomb,ri) = combiner(std::move(Rinds));
+        AAcomb = matricize(AA,Qcomb,Rcomb);
+        }
+    else if(!Qinds.empty())
         {
         std::tie(Qcomb,qi) = combiner(std::move(Qinds));
         AAcomb *= Qcomb;
         }
-    if(!Rinds.empty())
+    else if(!Rinds.empty())
         {
         std::tie(Rcomb,ri) = combiner(std::move(Rinds));
         AAcomb *= Rcomb;
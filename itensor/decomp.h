@@ -28,7 +28,14 @@ namespace itensor {
 // Factors a tensor AA such that AA=U*D*V
 // with D diagonal, real, and non-negative.
 //
-Spectrum 
+// Arg "SVDMethod" can be "automatic" (default), "gesdd",
+// "gesvd", "ITensor" or "randomized". The randomized SVD
+// only computes the "MaxDim" largest singular values, at a
+// cost of O(m*n*MaxDim) for an m x n matrix, from
+// MaxDim+"Oversample" (default 10) random vectors and
+// "PowerIter" (default 2) power iterations.
+//
+Spectrum
 svd(ITensor const& AA, ITensor& U, ITensor& D, ITensor& V, 
     Args args = Args::global());
 
@@ -193,6 +200,9 @@ denmatDecomp(ITensor const& T,
 // Result is unitary tensor U and diagonal sparse tensor D
 // such that M == dag(U)*D*prime(U)
 //
+// Arg "EigMethod" can be "dsyev" (default) or "dsyevr",
+// the faster MRRR algorithm for real tensors.
+//
 Spectrum 
 diagHermitian(ITensor const& M, 
               ITensor      & U, 
@@ -463,6 +473,12 @@ std::vector<Ord2Block<T>>
 doTask(GetBlocks<T> const& G, 
        QDense<T> const& d);
 
+//Blocks viewing the data in the mapped file
+template<typename T>
+std::vector<Ord2Block<T>>
+doTask(GetBlocks<T> const& G, 
+       MappedQDense<T> const& d);
+
 void
 showEigs(Vector const& P,
          Real truncerr,
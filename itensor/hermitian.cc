@@ -122,7 +122,7 @@ diagHImpl(ITensor H,
         Vector DD;
         Mat<T> UU,iUU;
         auto R = toMatRefc<T>(H,active,prime(active));
-        diagHermitian(R,UU,DD);
+        diagHermitian(R,UU,DD,args);
         conjugate(UU);
 
         //Truncate
@@ -239,7 +239,7 @@ diagHImpl(ITensor H,
             d = makeVecRef(ddata.data()+totaldsize,rM);
             UU = makeMatRef(Udata.data()+totalUsize,rM*cM,rM,cM);
 
-            diagHermitian(M,UU,d);
+            diagHermitian(M,UU,d,args);
             conjugate(UU);
 
             alleig.insert(alleig.end(),d.begin(),d.end());
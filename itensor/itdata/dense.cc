@@ -22,6 +22,7 @@
 #include "itensor/tensor/contract.h"
 #include "itensor/tensor/lapack_wrap.h"
 #include "itensor/util/tensorstats.h"
+#include "itensor/util/contractstats.h"
 
 using std::move;
 using std::string;
@@ -261,10 +262,10 @@ doTask(SumEls, DenseCplx const& d);
 
 template<typename T1,typename T2>
 void
-doTask(Contract & C,
-       Dense<T1> const& L,
-       Dense<T2> const& R,
-       ManageStore & m)
+contractDense(Contract & C,
+              T1 const* L, size_t Lsize,
+              T2 const* R, size_t Rsize,
+              ManageStore & m)
     {
     //if(not C.needresult)
     //    {
@@ -301,29 +302,42 @@ doTask(Contract & C,
                 }
             }
         }
-    auto tL = makeTenRef(L.data(),L.size(),&C.Lis);
-    auto tR = makeTenRef(R.data(),R.size(),&C.Ris);
+    auto tL = makeTenRef(L,Lsize,&C.Lis);
+    auto tR = makeTenRef(R,Rsize,&C.Ris);
     auto rsize = dim(C.Nis);
-TIMER_START(40);
     // Create a Dense storage with undefined data, since it will be
     // overwritten anyway
     auto nd = m.makeNewData<Dense<common_type<T1,T2>>>(undef,rsize);
-TIMER_STOP(40);
     auto tN = makeTenRef(nd->data(),nd->size(),&(C.Nis));
 
 #ifdef COLLECT_TSTATS
     tstats(tL,Lind,tR,Rind,tN,Nind);
 #endif
 
-START_TIMER(41);
+    PROFILE_START(pc,"dense");
+    ContractStatsKind kind("dense");
     contract(tL,Lind,tR,Rind,tN,Nind);
-STOP_TIMER(41);
+    PROFILE_STOP(pc);
 
 
 #ifdef USESCALE
     if(rsize > 1) C.scalefac = computeScalefac(*nd);
 #endif
     }
+template void contractDense(Contract&,Real const*,size_t,Real const*,size_t,ManageStore&);
+template void contractDense(Contract&,Cplx const*,size_t,Real const*,size_t,ManageStore&);
+template void contractDense(Contract&,Real const*,size_t,Cplx const*,size_t,ManageStore&);
+template void contractDense(Contract&,Cplx const*,size_t,Cplx const*,size_t,ManageStore&);
+
+template<typename T1,typename T2>
+void
+doTask(Contract & C,
+       Dense<T1> const& L,
+       Dense<T2> const& R,
+       ManageStore & m)
+    {
+    contractDense(C,L.data(),L.size(),R.data(),R.size(),m);
+    }
 template void doTask(Contract&,DenseReal const&,DenseReal const&,ManageStore&);
 template void doTask(Contract&,DenseCplx const&,DenseReal const&,ManageStore&);
 template void doTask(Contract&,DenseReal const&,DenseCplx const&,ManageStore&);
@@ -447,16 +461,15 @@ juliaTypeNameOf(DenseCplx const& d) { return "Dense{ComplexF64}"; }
 
 template<typename V>
 void
-h5_write(h5::group parent, std::string const& name, Dense<V> const& D)
+h5_write(h5::group parent, std::string const& name, Dense<V> const& D, Args const& args)
     {
     auto g = parent.create_group(name);
     h5_write_attribute(g,"type",juliaTypeNameOf(D),true);
     h5_write_attribute(g,"version",long(1));
-    auto data = std::vector<V>(D.store.begin(),D.store.end());
-    h5_write(g,"data",data);
+    h5::array_interface::write(g,"data",h5_data_view(D.data(),D.size()),h5_compression(args));
     }
-template void h5_write(h5::group, std::string const&, Dense<Real> const& D);
-template void h5_write(h5::group, std::string const&, Dense<Cplx> const& D);
+template void h5_write(h5::group, std::string const&, Dense<Real> const& D, Args const&);
+template void h5_write(h5::group, std::string const&, Dense<Cplx> const& D, Args const&);
 
 template<typename V>
 void
@@ -465,8 +478,10 @@ h5_read(h5::group parent, std::string const& name, Dense<V> & D)
     auto g = parent.open_group(name);
     auto type = h5_read_attribute<string>(g,"type");
     if(type != juliaTypeNameOf(D)) Error(format("Group does not contain %s data in HDF5 file",typeNameOf(D)));
-    auto data = h5_read<vector<V>>(g,"data");
-    D = Dense<V>(move(data));
+    auto lt = h5::array_interface::get_h5_lengths_type(g,"data");
+    if(lt.rank() != 1+h5::is_complex_v<V>) Error("Unexpected rank of Dense data in HDF5 file");
+    D = Dense<V>(undef,lt.lengths[0]);
+    h5::array_interface::read(g,"data",h5_data_view(D.data(),D.size()),lt);
     }
 template void h5_read(h5::group parent, std::string const& name, Dense<Real> & D);
 template void h5_read(h5::group parent, std::string const& name, Dense<Cplx> & D);
@@ -295,6 +295,22 @@ doTask(StorageType const& S, DenseReal const& d) ->StorageType::Type { return St
 auto constexpr inline
 doTask(StorageType const& S, DenseCplx const& d) ->StorageType::Type { return StorageType::DenseCplx; }
 
+template<typename T>
+void
+doTask(GetRawData & G, Dense<T> const& d)
+    {
+    G.data = reinterpret_cast<char const*>(d.data());
+    G.bytes = d.size()*sizeof(T);
+    }
+
+template<typename T>
+void
+doTask(GetMutableRawData & G, Dense<T> & d)
+    {
+    G.data = reinterpret_cast<char*>(d.data());
+    G.bytes = d.size()*sizeof(T);
+    }
+
 template<typename T1,typename T2>
 void
 doTask(Contract & C,
@@ -302,6 +318,15 @@ doTask(Contract & C,
        Dense<T2> const& R,
        ManageStore & m);
 
+//Contracts element data L and R, laid out
+//as in Dense storage, into new Dense storage
+template<typename T1,typename T2>
+void
+contractDense(Contract & C,
+              T1 const* L, size_t Lsize,
+              T2 const* R, size_t Rsize,
+              ManageStore & m);
+
 template<typename T1, typename T2>
 void
 doTask(NCProd& NCP,
@@ -330,9 +355,11 @@ permuteDense(Permutation const& P,
              IndexSet   const& Bis);
 
 #ifdef ITENSOR_USE_HDF5
+//Writing recognizes the arguments of h5_compression
 template<typename V>
 void
-h5_write(h5::group parent, std::string const& name, Dense<V> const& D);
+h5_write(h5::group parent, std::string const& name, Dense<V> const& D,
+         Args const& args = Args::global());
 
 template<typename V>
 void
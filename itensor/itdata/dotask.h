@@ -174,7 +174,11 @@ class CallWrap : public FuncT<CallWrap<RT,Task,D1,Return,PType1,PType2>,StorageT
     template<typename D2>
     void
     applyToImpl(D2& d2);
-    
+
+    private:
+
+    void
+    evaluate1();
     };
 
 //
@@ -524,11 +528,19 @@ call(RT& rt, Task& t, D& d, ManageStore& m, Return& ret)
         auto* pd = m.modifyData(d);
         detail::callDoTask(t,*pd,m,ret);
         }
-    else if(isLazy)
+    else if(isLazy && NCData)
         {
         m.parg1() = callEvaluate(d);
         m.parg1()->plugInto(rt);
         }
+    else if(isLazy)
+        {
+        //Under const access the task is done on a copy,
+        //so the storage of an ITensor which may be shared
+        //between threads is never replaced
+        auto pc = callEvaluate(d);
+        pc->plugInto(rt);
+        }
     else
         {
         auto tname = typeNameOf(t);
@@ -546,6 +558,25 @@ call(RT& rt, Task& t, D& d, ManageStore& m, Return& ret)
     m.parg2()->plugInto(w);
     }
 
+//Evaluates lazy storage of the first argument and redoes
+//the task: in place if the argument may be modified, else
+//on a copy so the storage of a const ITensor is not replaced
+template <class RT, typename Task, typename D1, typename Return, class PType1, class PType2>
+void CallWrap<RT,Task,D1,Return,PType1,PType2>::
+evaluate1()
+    {
+    if(std::is_same<PType1,PData>::value)
+        {
+        m_.parg1() = callEvaluate(d1_);
+        m_.parg1()->plugInto(rt_);
+        }
+    else
+        {
+        auto pc = callEvaluate(d1_);
+        pc->plugInto(rt_);
+        }
+    }
+
 template <class RT, typename Task, typename D1, typename Return, class PType1, class PType2>
 template<typename D2>
 void CallWrap<RT,Task,D1,Return,PType1,PType2>::
@@ -579,9 +610,9 @@ applyToImpl(D2& d2)
         }
     else if(isLazy1 && isLazy2)
         {
-        m_.parg1() = callEvaluate(d1_);
-        m_.parg2() = callEvaluate(d2);
-        m_.parg1()->plugInto(rt_);
+        //d2 is evaluated when the task is
+        //plugged into again (case isLazy2 below)
+        evaluate1();
         }
     else if(isLazy1)
         {
@@ -599,8 +630,7 @@ applyToImpl(D2& d2)
             }
         else
             {
-            m_.parg1() = callEvaluate(d1_);
-            m_.parg1()->plugInto(rt_);
+            evaluate1();
             }
         }
     else if(isLazy2)
@@ -612,8 +642,10 @@ applyToImpl(D2& d2)
             }
         else
             {
-            m_.parg2() = callEvaluate(d2);
-            m_.parg2()->plugInto(*this);
+            //The second argument is always under const
+            //access, so the task is done on a copy
+            auto pc = callEvaluate(d2);
+            pc->plugInto(*this);
             }
         }
     else
@@ -0,0 +1,224 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "itensor/itdata/mapped.h"
+#include "itensor/itdata/dotask.h"
+#include "itensor/tensor/lapack_wrap.h"
+
+namespace itensor {
+
+const char*
+typeNameOf(MappedDenseReal const& d) { return "MappedDenseReal"; }
+const char*
+typeNameOf(MappedDenseCplx const& d) { return "MappedDenseCplx"; }
+const char*
+typeNameOf(MappedQDenseReal const& d) { return "MappedQDenseReal"; }
+const char*
+typeNameOf(MappedQDenseCplx const& d) { return "MappedQDenseCplx"; }
+
+template<typename T>
+PData
+evaluate(MappedDense<T> const& d)
+    {
+    PROFILE_REGION("mapped copy");
+    return newITData<Dense<T>>(d.data(),d.data()+d.size());
+    }
+template PData evaluate(MappedDenseReal const& d);
+template PData evaluate(MappedDenseCplx const& d);
+
+template<typename T>
+PData
+evaluate(MappedQDense<T> const& d)
+    {
+    PROFILE_REGION("mapped copy");
+    return newITData<QDense<T>>(d.offsets,d.data(),d.data()+d.size());
+    }
+template PData evaluate(MappedQDenseReal const& d);
+template PData evaluate(MappedQDenseCplx const& d);
+
+template<typename T>
+void static
+writeElements(std::ostream& s, T const* p, size_t size)
+    {
+    itensor::write(s,size);
+    s.write(reinterpret_cast<char const*>(p),size*sizeof(T));
+    }
+
+template<typename T>
+void
+write(std::ostream& s, MappedDense<T> const& d)
+    {
+    writeElements(s,d.data(),d.size());
+    }
+template void write(std::ostream& s, MappedDenseReal const& d);
+template void write(std::ostream& s, MappedDenseCplx const& d);
+
+template<typename T>
+void
+write(std::ostream& s, MappedQDense<T> const& d)
+    {
+    itensor::write(s,d.offsets);
+    writeElements(s,d.data(),d.size());
+    }
+template void write(std::ostream& s, MappedQDenseReal const& d);
+template void write(std::ostream& s, MappedQDenseCplx const& d);
+
+template<typename T>
+Cplx
+doTask(GetElt const& G, MappedDense<T> const& d)
+    {
+    return d.data()[offset(G.is,G.inds)];
+    }
+template Cplx doTask(GetElt const& G, MappedDenseReal const& d);
+template Cplx doTask(GetElt const& G, MappedDenseCplx const& d);
+
+template<typename T>
+Cplx
+doTask(GetElt const& G, MappedQDense<T> const& d)
+    {
+    auto [boff,block,eoff] = eltBlockOffset(d.offsets,G.is,G.inds);
+    if(boff < 0) return Cplx(0.,0.);
+    return d.data()[boff+eoff];
+    }
+template Cplx doTask(GetElt const& G, MappedQDenseReal const& d);
+template Cplx doTask(GetElt const& G, MappedQDenseCplx const& d);
+
+template<typename T>
+Real static
+normNoScale(T const* p, size_t size)
+    {
+    auto n = size*sizeof(T)/sizeof(Real);
+    return dnrm2_wrapper(n,reinterpret_cast<Real const*>(p));
+    }
+
+template<typename T>
+Real
+doTask(NormNoScale, MappedDense<T> const& d)
+    {
+    return normNoScale(d.data(),d.size());
+    }
+template Real doTask(NormNoScale, MappedDenseReal const& d);
+template Real doTask(NormNoScale, MappedDenseCplx const& d);
+
+template<typename T>
+Real
+doTask(NormNoScale, MappedQDense<T> const& d)
+    {
+    return normNoScale(d.data(),d.size());
+    }
+template Real doTask(NormNoScale, MappedQDenseReal const& d);
+template Real doTask(NormNoScale, MappedQDenseCplx const& d);
+
+template<typename T>
+QN
+doTask(CalcDiv const& C, MappedQDense<T> const& d)
+    {
+    if(order(C.is)==0 || d.offsets.empty()) return QN{};
+    auto block_ind = Block(order(C.is));
+    block_ind = d.offsets.front().block;
+    return calcDiv(C.is,block_ind);
+    }
+template QN doTask(CalcDiv const&, MappedQDenseReal const&);
+template QN doTask(CalcDiv const&, MappedQDenseCplx const&);
+
+template<typename T>
+QDenseRef<T> static
+qdenseRef(MappedQDense<T> const& d) { return QDenseRef<T>(d.offsets,d.data(),d.size()); }
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedDense<T1> const& L,
+       MappedDense<T2> const& R,
+       ManageStore & m)
+    {
+    contractDense(C,L.data(),L.size(),R.data(),R.size(),m);
+    }
+template void doTask(Contract&,MappedDenseReal const&,MappedDenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedDenseCplx const&,MappedDenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedDenseReal const&,MappedDenseCplx const&,ManageStore&);
+template void doTask(Contract&,MappedDenseCplx const&,MappedDenseCplx const&,ManageStore&);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedDense<T1> const& L,
+       Dense<T2> const& R,
+       ManageStore & m)
+    {
+    contractDense(C,L.data(),L.size(),R.data(),R.size(),m);
+    }
+template void doTask(Contract&,MappedDenseReal const&,DenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedDenseCplx const&,DenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedDenseReal const&,DenseCplx const&,ManageStore&);
+template void doTask(Contract&,MappedDenseCplx const&,DenseCplx const&,ManageStore&);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       Dense<T1> const& L,
+       MappedDense<T2> const& R,
+       ManageStore & m)
+    {
+    contractDense(C,L.data(),L.size(),R.data(),R.size(),m);
+    }
+template void doTask(Contract&,DenseReal const&,MappedDenseReal const&,ManageStore&);
+template void doTask(Contract&,DenseCplx const&,MappedDenseReal const&,ManageStore&);
+template void doTask(Contract&,DenseReal const&,MappedDenseCplx const&,ManageStore&);
+template void doTask(Contract&,DenseCplx const&,MappedDenseCplx const&,ManageStore&);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedQDense<T1> const& L,
+       MappedQDense<T2> const& R,
+       ManageStore & m)
+    {
+    contractQDense(C,qdenseRef(L),qdenseRef(R),m);
+    }
+template void doTask(Contract&,MappedQDenseReal const&,MappedQDenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedQDenseCplx const&,MappedQDenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedQDenseReal const&,MappedQDenseCplx const&,ManageStore&);
+template void doTask(Contract&,MappedQDenseCplx const&,MappedQDenseCplx const&,ManageStore&);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedQDense<T1> const& L,
+       QDense<T2> const& R,
+       ManageStore & m)
+    {
+    contractQDense(C,qdenseRef(L),QDenseRef<T2>(R),m);
+    }
+template void doTask(Contract&,MappedQDenseReal const&,QDenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedQDenseCplx const&,QDenseReal const&,ManageStore&);
+template void doTask(Contract&,MappedQDenseReal const&,QDenseCplx const&,ManageStore&);
+template void doTask(Contract&,MappedQDenseCplx const&,QDenseCplx const&,ManageStore&);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       QDense<T1> const& L,
+       MappedQDense<T2> const& R,
+       ManageStore & m)
+    {
+    contractQDense(C,QDenseRef<T1>(L),qdenseRef(R),m);
+    }
+template void doTask(Contract&,QDenseReal const&,MappedQDenseReal const&,ManageStore&);
+template void doTask(Contract&,QDenseCplx const&,MappedQDenseReal const&,ManageStore&);
+template void doTask(Contract&,QDenseReal const&,MappedQDenseCplx const&,ManageStore&);
+template void doTask(Contract&,QDenseCplx const&,MappedQDenseCplx const&,ManageStore&);
+
+} //namespace itensor
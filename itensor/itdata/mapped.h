@@ -0,0 +1,284 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_MAPPED_H
+#define __ITENSOR_MAPPED_H
+
+#include <memory>
+#include "itensor/itdata/dense.h"
+#include "itensor/itdata/qdense.h"
+#include "itensor/util/mapped_file.h"
+
+namespace itensor {
+
+//
+// Read-only Dense and QDense storage whose elements
+// are in a memory mapped file (see itensor/tensorfile.h).
+// The storage shares ownership of the mapping, so the
+// file stays mapped as long as an ITensor uses it.
+//
+// Contraction with Dense, QDense or mapped storage and
+// the read-only tasks below (and GetBlocks, ToMatRefc in
+// decomp.cc) use the mapped elements directly. For any
+// other task an owned Dense or QDense copy is made by
+// evaluate, as for ITLazy. If the task may modify the
+// ITensor, the copy replaces its storage, so the data is
+// copied once, on the first modification. Under const
+// access the task is done on a temporary copy and the
+// storage is left as it is, so const ITensors with mapped
+// storage may be used from several threads at once.
+//
+
+template<typename T>
+class MappedDense
+    {
+    static_assert(not std::is_const<T>::value,
+                  "Template argument to MappedDense storage should not be const");
+    public:
+    using value_type = T;
+    private:
+    std::shared_ptr<MappedFile const> file_;
+    value_type const* p_ = nullptr;
+    size_t size_ = 0;
+    public:
+
+    MappedDense() { }
+
+    //Views size elements starting at
+    //byte offset in the mapped file
+    MappedDense(std::shared_ptr<MappedFile const> const& file,
+                size_t offset,
+                size_t size)
+      : file_(file),
+        p_(reinterpret_cast<value_type const*>(file->data()+offset)),
+        size_(size)
+        { }
+
+    value_type const*
+    data() const { return p_; }
+
+    size_t
+    size() const { return size_; }
+
+    MappedFile const&
+    file() const { return *file_; }
+    };
+
+template<typename T>
+class MappedQDense
+    {
+    static_assert(not std::is_const<T>::value,
+                  "Template argument to MappedQDense storage should not be const");
+    public:
+    using value_type = T;
+
+    BlockOffsets offsets;
+
+    private:
+    std::shared_ptr<MappedFile const> file_;
+    value_type const* p_ = nullptr;
+    size_t size_ = 0;
+    public:
+
+    MappedQDense() { }
+
+    MappedQDense(std::shared_ptr<MappedFile const> const& file,
+                 BlockOffsets const& off,
+                 size_t offset,
+                 size_t size)
+      : offsets(off),
+        file_(file),
+        p_(reinterpret_cast<value_type const*>(file->data()+offset)),
+        size_(size)
+        { }
+
+    value_type const*
+    data() const { return p_; }
+
+    size_t
+    size() const { return size_; }
+
+    MappedFile const&
+    file() const { return *file_; }
+    };
+
+using MappedDenseReal = MappedDense<Real>;
+using MappedDenseCplx = MappedDense<Cplx>;
+using MappedQDenseReal = MappedQDense<Real>;
+using MappedQDenseCplx = MappedQDense<Cplx>;
+
+const char*
+typeNameOf(MappedDenseReal const& d);
+const char*
+typeNameOf(MappedDenseCplx const& d);
+const char*
+typeNameOf(MappedQDenseReal const& d);
+const char*
+typeNameOf(MappedQDenseCplx const& d);
+
+template<typename T>
+bool constexpr
+isReal(MappedDense<T> const& t) { return std::is_same<T,Real>::value; }
+
+template<typename T>
+bool constexpr
+isCplx(MappedDense<T> const& t) { return std::is_same<T,Cplx>::value; }
+
+template<typename T>
+bool constexpr
+isReal(MappedQDense<T> const& t) { return std::is_same<T,Real>::value; }
+
+template<typename T>
+bool constexpr
+isCplx(MappedQDense<T> const& t) { return std::is_same<T,Cplx>::value; }
+
+//Mapped storage is never swapped for a
+//result before a task is attempted
+template<typename T>
+bool
+hasResult(MappedDense<T> const& d) { return false; }
+
+template<typename T>
+bool
+hasResult(MappedQDense<T> const& d) { return false; }
+
+//Owned Dense or QDense copy of the mapped data
+template<typename T>
+PData
+evaluate(MappedDense<T> const& d);
+
+template<typename T>
+PData
+evaluate(MappedQDense<T> const& d);
+
+//Written in the same format as Dense and QDense
+//storage, and read back as Dense or QDense
+template<typename T>
+void
+write(std::ostream& s, MappedDense<T> const& d);
+
+template<typename T>
+void
+write(std::ostream& s, MappedQDense<T> const& d);
+
+auto inline
+doTask(StorageType const& S, MappedDenseReal const& d) ->StorageType::Type { return StorageType::DenseReal; }
+auto inline
+doTask(StorageType const& S, MappedDenseCplx const& d) ->StorageType::Type { return StorageType::DenseCplx; }
+auto inline
+doTask(StorageType const& S, MappedQDenseReal const& d) ->StorageType::Type { return StorageType::QDenseReal; }
+auto inline
+doTask(StorageType const& S, MappedQDenseCplx const& d) ->StorageType::Type { return StorageType::QDenseCplx; }
+
+template<typename T>
+void
+doTask(GetRawData & G, MappedDense<T> const& d)
+    {
+    G.data = reinterpret_cast<char const*>(d.data());
+    G.bytes = d.size()*sizeof(T);
+    }
+
+template<typename T>
+void
+doTask(GetRawData & G, MappedQDense<T> const& d)
+    {
+    G.data = reinterpret_cast<char const*>(d.data());
+    G.bytes = d.size()*sizeof(T);
+    G.offsets = &d.offsets;
+    }
+
+template<typename T>
+bool
+doTask(CheckComplex, MappedDense<T> const& d) { return isCplx(d); }
+
+template<typename T>
+bool
+doTask(CheckComplex, MappedQDense<T> const& d) { return isCplx(d); }
+
+template<typename T>
+bool
+doTask(IsDense, MappedQDense<T> const& d) { return true; }
+
+void inline
+doTask(Conj, MappedDenseReal const& d) { }
+
+void inline
+doTask(Conj, MappedQDenseReal const& d) { }
+
+template<typename T>
+Cplx
+doTask(GetElt const& G, MappedDense<T> const& d);
+
+template<typename T>
+Cplx
+doTask(GetElt const& G, MappedQDense<T> const& d);
+
+template<typename T>
+Real
+doTask(NormNoScale, MappedDense<T> const& d);
+
+template<typename T>
+Real
+doTask(NormNoScale, MappedQDense<T> const& d);
+
+template<typename T>
+QN
+doTask(CalcDiv const& C, MappedQDense<T> const& d);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedDense<T1> const& L,
+       MappedDense<T2> const& R,
+       ManageStore & m);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedDense<T1> const& L,
+       Dense<T2> const& R,
+       ManageStore & m);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       Dense<T1> const& L,
+       MappedDense<T2> const& R,
+       ManageStore & m);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedQDense<T1> const& L,
+       MappedQDense<T2> const& R,
+       ManageStore & m);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       MappedQDense<T1> const& L,
+       QDense<T2> const& R,
+       ManageStore & m);
+
+template<typename T1, typename T2>
+void
+doTask(Contract & C,
+       QDense<T1> const& L,
+       MappedQDense<T2> const& R,
+       ManageStore & m);
+
+} //namespace itensor
+
+#endif
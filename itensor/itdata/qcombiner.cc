@@ -122,6 +122,96 @@ replaceInd(IndexSet const& is,
     return newind.build();
     }
 
+//
+// If the combined indices Cis[1],Cis[2],... appear
+// contiguously and in order in dis, starting at
+// position jc, and every block of the combined tensor
+// (with the combined index at position jc) is made of
+// blocks of d lying next to each other in memory, in
+// the same order as the blocks themselves, return the
+// offsets of the combined blocks into d's data.
+// Otherwise return empty offsets.
+//
+template<typename T>
+BlockOffsets
+combinedOffsets(QDense<T> const& d,
+                QCombiner const& C,
+                IndexSet  const& dis,
+                IndexSet  const& Nis,
+                long             jc,
+                long             ncomb)
+    {
+    struct NewBlock
+        {
+        Block block;
+        long offset = 0,
+             size = 0,
+             filled = 0;
+        };
+    auto dr = order(dis);
+    auto nblocks = stdx::reserve_vector<NewBlock>(d.offsets.size());
+    auto cblock = Block(ncomb);
+    for(auto& io : d.offsets)
+        {
+        auto nb = NewBlock();
+        nb.block = Block(order(Nis));
+        long before = 1,
+             after = 1;
+        for(auto i : range(dr))
+            {
+            auto bsize = dis[i].blocksize0(io.block[i]);
+            if(i < jc)
+                {
+                nb.block[i] = io.block[i];
+                before *= bsize;
+                }
+            else if(i < jc+ncomb)
+                {
+                cblock[i-jc] = io.block[i];
+                }
+            else
+                {
+                nb.block[i-ncomb+1] = io.block[i];
+                after *= bsize;
+                }
+            }
+        size_t start = 0,
+               end = 0;
+        tie(nb.block[jc],start,end) = C.getBlockRange(cblock);
+        auto cdim = Nis[jc].blocksize0(nb.block[jc]);
+        //The sub-block [start,end) of the combined index is
+        //only contiguous if it is the slowest varying index
+        if(after > 1 && long(end-start) != cdim) return BlockOffsets();
+        nb.offset = io.offset-start*before;
+        nb.size = before*cdim*after;
+        nb.filled = before*(end-start)*after;
+        nblocks.push_back(std::move(nb));
+        }
+
+    std::stable_sort(nblocks.begin(),nblocks.end(),
+                     [](NewBlock const& a, NewBlock const& b) { return a.block < b.block; });
+
+    auto noffsets = BlockOffsets();
+    long total = 0;
+    for(auto& nb : nblocks)
+        {
+        if(!noffsets.empty() && noffsets.back().block == nb.block)
+            {
+            //Sub-blocks of the same combined block must share its offset
+            if(nb.offset != noffsets.back().offset) return BlockOffsets();
+            continue;
+            }
+        if(nb.offset != total) return BlockOffsets();
+        noffsets.push_back(make_blof(nb.block,nb.offset));
+        total += nb.size;
+        }
+    //Check every combined block is completely filled
+    auto filled = 0l;
+    for(auto& nb : nblocks) filled += nb.filled;
+    if(filled != total || size_t(total) != d.size()) return BlockOffsets();
+    return noffsets;
+    }
+
 template<typename T>
 void
 combine(QDense<T> const& d,
@@ -129,7 +219,8 @@ combine(QDense<T> const& d,
         IndexSet  const& dis,
         IndexSet  const& Cis,
         IndexSet       & Nis,
-        ManageStore    & m)
+        ManageStore    & m,
+        bool             own_data)
     {
 #ifdef DEBUG
     for(auto i : range(1,Cis.order()))
@@ -160,6 +251,41 @@ combine(QDense<T> const& d,
 
     auto combined = [&dperm,ncomb](size_type i) { return dperm[i] < long(ncomb); };
 
+    //If the combined indices are contiguous and in order,
+    //fusing them can leave the data in place and only
+    //change the block offsets, as for Dense storage
+    auto jc = indexPosition(dis,Cis[1]);
+    auto contig_sameord = jc >= 0 && size_type(jc+ncomb) <= dr;
+    for(auto i : range(ncomb)) 
+        {
+        if(!contig_sameord) break;
+        contig_sameord = dperm[jc+i] == long(i);
+        }
+    if(contig_sameord)
+        {
+        auto newind = IndexSetBuilder(nr);
+        for(auto i : range(jc)) newind.nextIndex(dis[i]);
+        newind.nextIndex(Cis[0]);
+        for(auto i : range(jc+ncomb,dr)) newind.nextIndex(dis[i]);
+        auto cis = newind.build();
+        auto noffsets = combinedOffsets(d,C,dis,cis,jc,ncomb);
+        if(!noffsets.empty())
+            {
+            Nis = std::move(cis);
+            if(own_data)
+                {
+                //Only copies the data if it is shared
+                auto* nd = m.modifyData(d);
+                nd->offsets = std::move(noffsets);
+                }
+            else
+                {
+                m.makeNewData<QDense<T>>(noffsets,d.store.begin(),d.store.end());
+                }
+            return;
+            }
+        }
+
     //Create new IndexSet
     auto newind = IndexSetBuilder(nr);
     newind.nextIndex(Cis[0]);
@@ -300,6 +426,83 @@ uncombine(QDense<T> const& d,
         } //for blocks of d
     }//uncombine
 
+template<typename T>
+void
+doTask(Matricize & M,
+       QDense<T> const& d,
+       ManageStore    & m)
+    {
+    auto dr = order(M.is);
+    long nrow = order(M.ris)-1,
+         ncol = order(M.cis)-1;
+    if(dr != nrow+ncol) Error("matricize: tensor has indices not on either combiner");
+
+    //Position of each index of d in the order
+    //(row indices...,column indices...)
+    auto dperm = Labels(dr,-1);
+    auto dpos = Labels(dr,-1);
+    for(auto i : range(dr))
+        {
+        auto jr = indexPosition(M.ris,M.is[i]);
+        auto jc = indexPosition(M.cis,M.is[i]);
+        if(jr > 0)      dperm[i] = jr-1;
+        else if(jc > 0) dperm[i] = nrow+jc-1;
+        else            Error("matricize: tensor has indices not on either combiner");
+        dpos[dperm[i]] = i;
+        }
+    auto trivial = true;
+    for(auto i : range(dr)) if(dperm[i] != i) trivial = false;
+
+    M.Nis = IndexSet(M.ris[0],M.cis[0]);
+    auto& nd = *m.makeNewData<QDense<T>>(M.Nis,doTask(CalcDiv{M.is},d));
+
+    auto drange = Range(dr);
+    auto rblock = Block(nrow),
+         cblock = Block(ncol),
+         nblock = Block(2);
+    size_t rstart = 0, rend = 0,
+           cstart = 0, cend = 0;
+    for(auto& io : d.offsets)
+        {
+        for(auto i : range(dr))
+            {
+            if(dperm[i] < nrow) rblock[dperm[i]] = io.block[i];
+            else                cblock[dperm[i]-nrow] = io.block[i];
+            }
+        tie(nblock[0],rstart,rend) = M.rcmb.getBlockRange(rblock);
+        tie(nblock[1],cstart,cend) = M.ccmb.getBlockRange(cblock);
+        auto nb = getBlock(nd,M.Nis,nblock);
+        assert(nb.data() != nullptr);
+
+        //View the sub-matrix this block goes into as a
+        //tensor with the row and column indices split out,
+        //using the leading dimension of the combined block
+        auto ld = M.Nis[0].blocksize0(nblock[0]);
+        auto RB = RangeBuilder(dr);
+        long str = 1;
+        for(auto k : range(dr))
+            {
+            if(k == nrow) str = ld;
+            auto i = dpos[k];
+            auto ext = M.is[i].blocksize0(io.block[i]);
+            RB.nextIndStr(ext,str);
+            str *= ext;
+            }
+        auto srange = RB.build();
+        auto sref = makeTenRef(nb.data(),rstart+cstart*ld,nb.size(),&srange);
+
+        drange.init(make_indexdim(M.is,io.block));
+        auto dref = makeTenRef(d.data(),io.offset,d.size(),&drange);
+
+        //Only permute if the row and column indices
+        //are not already grouped in order
+        if(trivial) sref &= dref;
+        else        sref &= permute(dref,dperm);
+        }
+    }
+template void doTask(Matricize &,QDense<Real> const&,ManageStore &);
+template void doTask(Matricize &,QDense<Cplx> const&,ManageStore &);
+
 template<typename T>
 void
 doTask(Contract & C,
@@ -313,7 +516,7 @@ doTask(Contract & C,
         }
     else
         {
-        combine(d,cmb,C.Lis,C.Ris,C.Nis,m);
+        combine(d,cmb,C.Lis,C.Ris,C.Nis,m,true);
         }
     }
 template void doTask(Contract &,QDense<Real> const&,QCombiner const&,ManageStore &);
@@ -332,7 +535,7 @@ doTask(Contract & C,
         }
     else
         {
-        combine(d,cmb,C.Ris,C.Lis,C.Nis,m);
+        combine(d,cmb,C.Ris,C.Lis,C.Nis,m,false);
         }
     }
 template void doTask(Contract &,QCombiner const&,QDense<Real> const&,ManageStore &);
@@ -147,6 +147,14 @@ doTask(Contract & C,
        QDense<T>    const& d,
        ManageStore       & m);
 
+//Combine the indices of d into the row and column
+//indices of two combiners in one pass
+template<typename T>
+void
+doTask(Matricize & M,
+       QDense<T> const& d,
+       ManageStore    & m);
+
 void inline
 doTask(PrintIT & P, 
        QCombiner const& d) { P.s << "QCombiner "; }
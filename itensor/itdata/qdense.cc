@@ -23,6 +23,7 @@
 #include "itensor/itdata/qdense.h"
 #include "itensor/itdata/qutil.h"
 #include "itensor/util/print_macro.h"
+#include "itensor/util/contractstats.h"
 
 using std::vector;
 using std::string;
@@ -670,10 +671,10 @@ template void doTask(PlusEQ const&, QDense<Cplx> const&, QDense<Cplx> const&, Ma
 
 template<typename VA, typename VB>
 void
-doTask(Contract& Con,
-       QDense<VA> const& A,
-       QDense<VB> const& B,
-       ManageStore& m)
+contractQDense(Contract& Con,
+               QDenseRef<VA> const& A,
+               QDenseRef<VB> const& B,
+               ManageStore& m)
     {
     using VC = common_type<VA,VB>;
     Labels Lind,
@@ -686,15 +687,13 @@ doTask(Contract& Con,
     const bool sortResult = false;
     contractIS(Con.Lis,Lind,Con.Ris,Rind,Con.Nis,Cind,sortResult);
 
-TIMER_START(32);
+    PROFILE_START(po,"qdense offsets");
     //Allocate storage for C
     auto [Coffsets,Csize,blockContractions] = getContractedOffsets(A,Con.Lis,B,Con.Ris,Con.Nis);
-TIMER_STOP(32);
-TIMER_START(33);
+    PROFILE_STOP(po);
     // Create QDense storage with uninitialized memory, faster than
     // setting to zeros
     auto nd = m.makeNewData<QDense<VC>>(undef,Coffsets,Csize);
-TIMER_STOP(33);
     auto& C = *nd;
 
     //Determines if the contraction in the list overwrites or
@@ -727,6 +726,7 @@ TIMER_STOP(33);
         auto cref = makeRef(cblock,&Crange);
 
         // cref += aref*bref or cref = aref*bref
+        ContractStatsKind kind("qdense");
         contract(aref,Lind,bref,Rind,cref,Cind,1.,betas[Cblockloc]);
 
         // If the block had not been called, betas[Cblockloc] == 0
@@ -734,18 +734,32 @@ TIMER_STOP(33);
         betas[Cblockloc] = 1.;
         };
 
-TIMER_START(34);
+    PROFILE_START(pb,"qdense blocks");
     loopContractedBlocks(A,Con.Lis,
                          B,Con.Ris,
                          C,Con.Nis,
                          blockContractions,
                          do_contract);
-TIMER_STOP(34);
+    PROFILE_STOP(pb);
 
 #ifdef USESCALE
     Con.scalefac = computeScalefac(C);
 #endif
     }
+template void contractQDense(Contract&,QDenseRef<Real> const&,QDenseRef<Real> const&,ManageStore&);
+template void contractQDense(Contract&,QDenseRef<Cplx> const&,QDenseRef<Real> const&,ManageStore&);
+template void contractQDense(Contract&,QDenseRef<Real> const&,QDenseRef<Cplx> const&,ManageStore&);
+template void contractQDense(Contract&,QDenseRef<Cplx> const&,QDenseRef<Cplx> const&,ManageStore&);
+
+template<typename VA, typename VB>
+void
+doTask(Contract& Con,
+       QDense<VA> const& A,
+       QDense<VB> const& B,
+       ManageStore& m)
+    {
+    contractQDense(Con,QDenseRef<VA>(A),QDenseRef<VB>(B),m);
+    }
 template void doTask(Contract& Con,QDense<Real> const&,QDense<Real> const&,ManageStore&);
 template void doTask(Contract& Con,QDense<Cplx> const&,QDense<Real> const&,ManageStore&);
 template void doTask(Contract& Con,QDense<Real> const&,QDense<Cplx> const&,ManageStore&);
@@ -1038,7 +1052,7 @@ juliaTypeNameOf(QDenseCplx const& d) { return "BlockSparse{ComplexF64}"; }
 
 template<typename V>
 void
-h5_write(h5::group parent, std::string const& name, QDense<V> const& D)
+h5_write(h5::group parent, std::string const& name, QDense<V> const& D, Args const& args)
     {
     auto g = parent.create_group(name);
     h5_write_attribute(g,"type",juliaTypeNameOf(D),true);
@@ -1048,11 +1062,17 @@ h5_write(h5::group parent, std::string const& name, QDense<V> const& D)
     h5_write(g,"ndims",N);
     auto off_array = offsets_to_array(D.offsets,N);
     h5_write(g,"offsets",off_array);
-    auto data = std::vector<V>(D.store.begin(),D.store.end());
-    h5_write(g,"data",data);
+    size_t maxblock = 0;
+    for(auto n : range(D.offsets.size()))
+        {
+        auto end = (n+1 < D.offsets.size()) ? D.offsets[n+1].offset : D.size();
+        maxblock = std::max(maxblock,size_t(end-D.offsets[n].offset));
+        }
+    auto c = h5_compression(args,maxblock);
+    h5::array_interface::write(g,"data",h5_data_view(D.data(),D.size()),c);
     }
-template void h5_write(h5::group, std::string const&, QDense<Real> const& D);
-template void h5_write(h5::group, std::string const&, QDense<Cplx> const& D);
+template void h5_write(h5::group, std::string const&, QDense<Real> const& D, Args const&);
+template void h5_write(h5::group, std::string const&, QDense<Cplx> const& D, Args const&);
 
 template<typename V>
 void
@@ -1065,15 +1085,56 @@ h5_read(h5::group parent, std::string const& name, QDense<V> & D)
         Error(format("Group does not contain %s or %s data in HDF5 file",typeNameOf(D),juliaTypeNameOf(D)));
         }
     auto N = h5_read<long>(g,"ndims");
-    auto off_array = offsets_to_array(D.offsets,N);
     auto offsets = h5_read<vector<long>>(g,"offsets");
     auto boff = array_to_offsets(offsets,N);
-    auto data = h5_read<vector<V>>(g,"data");
-    D = QDense(boff,data);
+    auto lt = h5::array_interface::get_h5_lengths_type(g,"data");
+    if(lt.rank() != 1+h5::is_complex_v<V>) Error("Unexpected rank of QDense data in HDF5 file");
+    D = QDense<V>(undef,boff,lt.lengths[0]);
+    h5::array_interface::read(g,"data",h5_data_view(D.data(),D.size()),lt);
     }
 template void h5_read(h5::group, std::string const&, QDense<Real> & D);
 template void h5_read(h5::group, std::string const&, QDense<Cplx> & D);
 
+template<typename V>
+void
+h5_read_block(h5::group parent, std::string const& name, IndexSet const& is,
+              Block const& block, QDense<V> & D)
+    {
+    auto g = parent.open_group(name);
+    auto type = h5_read_attribute<string>(g,"type");
+    if(type != juliaTypeNameOf(D)) 
+        {
+        Error(format("Group does not contain %s or %s data in HDF5 file",typeNameOf(D),juliaTypeNameOf(D)));
+        }
+    if(long(block.size()) != length(is)) Error("h5_read_block: wrong number of block indices");
+    for(auto j : range(block.size()))
+        {
+        if(block[j] >= size_t(nblock(is[j]))) Error("h5_read_block: block index out of range");
+        }
+    auto N = h5_read<long>(g,"ndims");
+    auto boff = array_to_offsets(h5_read<vector<long>>(g,"offsets"),N);
+    auto lt = h5::array_interface::get_h5_lengths_type(g,"data");
+    for(auto n : range(boff.size()))
+        {
+        if(not (boff[n].block == block)) continue;
+        auto begin = boff[n].offset;
+        auto end = (n+1 < boff.size()) ? boff[n+1].offset : long(lt.lengths[0]);
+        D = QDense<V>(undef,BlockOffsets({BlOf{block,0}}),end-begin);
+        auto v = h5_data_view(D.data(),D.size());
+        h5::array_interface::read_slice(g,"data",v,begin,end-begin);
+        return;
+        }
+    //Blocks with the flux of the tensor which
+    //are not stored are zero
+    if(not boff.empty() && calcDiv(is,block) != calcDiv(is,boff.front().block))
+        {
+        Error("h5_read_block: block does not have the QN flux of the ITensor");
+        }
+    D = QDense<V>(is,Blocks({block}));
+    }
+template void h5_read_block(h5::group, std::string const&, IndexSet const&, Block const&, QDense<Real> & D);
+template void h5_read_block(h5::group, std::string const&, IndexSet const&, Block const&, QDense<Cplx> & D);
+
 
 #endif //ITENSOR_USE_HDF5
 
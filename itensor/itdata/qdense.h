@@ -186,6 +186,34 @@ class QDense
 
     };
 
+//Read-only view of element data laid out
+//as in QDense storage, owned elsewhere
+template<typename T>
+struct QDenseRef
+    {
+    using value_type = T;
+
+    BlockOffsets const& offsets;
+    value_type const* p = nullptr;
+    size_t n = 0;
+
+    QDenseRef(BlockOffsets const& off,
+              value_type const* p_,
+              size_t n_)
+      : offsets(off), p(p_), n(n_)
+        { }
+
+    QDenseRef(QDense<T> const& d)
+      : offsets(d.offsets), p(d.data()), n(d.size())
+        { }
+
+    value_type const*
+    data() const { return p; }
+
+    size_t
+    size() const { return n; }
+    };
+
 std::ostream&
 operator<<(std::ostream & s, BlOf const& t);
 
@@ -401,6 +429,23 @@ doTask(StorageType const& S, QDenseReal const& d) ->StorageType::Type { return S
 auto inline constexpr
 doTask(StorageType const& S, QDenseCplx const& d) ->StorageType::Type { return StorageType::QDenseCplx; }
 
+template<typename T>
+void
+doTask(GetRawData & G, QDense<T> const& d)
+    {
+    G.data = reinterpret_cast<char const*>(d.data());
+    G.bytes = d.size()*sizeof(T);
+    G.offsets = &d.offsets;
+    }
+
+template<typename T>
+void
+doTask(GetMutableRawData & G, QDense<T> & d)
+    {
+    G.data = reinterpret_cast<char*>(d.data());
+    G.bytes = d.size()*sizeof(T);
+    }
+
 template<typename TA, typename TB>
 void
 doTask(PlusEQ const& P,
@@ -415,6 +460,14 @@ doTask(Contract& Con,
        QDense<VB> const& B,
        ManageStore& m);
 
+//Contracts A and B into new QDense storage
+template<typename VA, typename VB>
+void
+contractQDense(Contract& Con,
+               QDenseRef<VA> const& A,
+               QDenseRef<VB> const& B,
+               ManageStore& m);
+
 //TODO: complete implementation
 //template<typename VA, typename VB>
 //void
@@ -449,14 +502,17 @@ int
 offsetOfLoc(BlockOffsets const& offsets,
             Block        const& blockind);
 
-template<typename T>
+//Offset of the data of the block holding element ind
+//(-1 if the block is not in offsets), the block and
+//the offset of the element within the block
 template<typename Indexable>
-std::tuple<T const*,Block,long> QDense<T>::
-getEltBlockOffset(IndexSet const& is,
-                  Indexable const& ind) const
+std::tuple<long,Block,long>
+eltBlockOffset(BlockOffsets const& offsets,
+               IndexSet const& is,
+               Indexable const& ind)
     {
     auto r = long(ind.size());
-    if(r == 0) return std::make_tuple(store.data(),Block(0),0);
+    if(r == 0) return std::make_tuple(0l,Block(0),0l);
 #ifdef DEBUG
     if(is.order() != r) 
         {
@@ -483,7 +539,16 @@ getEltBlockOffset(IndexSet const& is,
         }
     //Do a binary search (equal_range) to see
     //if there is a block with block index "bind"
-    auto boff = offsetOf(offsets,block);
+    return std::make_tuple(offsetOf(offsets,block),block,eoff);
+    }
+
+template<typename T>
+template<typename Indexable>
+std::tuple<T const*,Block,long> QDense<T>::
+getEltBlockOffset(IndexSet const& is,
+                  Indexable const& ind) const
+    {
+    auto [boff,block,eoff] = eltBlockOffset(offsets,is,ind);
     if(boff >= 0)
         {
 #ifdef DEBUG
@@ -587,13 +652,25 @@ doTask(RemoveQNs & T,
        ManageStore & m);
 
 #ifdef ITENSOR_USE_HDF5
+//Writing recognizes the arguments of h5_compression,
+//by default chunks hold the largest block
 template<typename V>
 void
-h5_write(h5::group parent, std::string const& name, QDense<V> const& D);
+h5_write(h5::group parent, std::string const& name, QDense<V> const& D,
+         Args const& args = Args::global());
 
 template<typename V>
 void
 h5_read(h5::group parent, std::string const& name, QDense<V> & D);
+
+//Reads only the data of the given block of a tensor
+//with indices is, so D holds exactly this block.
+//A block which is not stored is zero filled if it has
+//the QN flux of the stored blocks, and an error otherwise.
+template<typename V>
+void
+h5_read_block(h5::group parent, std::string const& name, IndexSet const& is,
+              Block const& block, QDense<V> & D);
 #endif
 
 } //namespace itensor
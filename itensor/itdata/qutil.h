@@ -241,14 +241,14 @@ getContractedOffsets(BlockSparseA const& A,
     return std::make_tuple(Cblocksizes,Csize,blockContractions);
     }
 
-template<typename TA,
-         typename TB,
+template<typename BlockSparseA,
+         typename BlockSparseB,
          typename TC,
          typename Callable>
 void
-_loopContractedBlocks(QDense<TA> const& A,
+_loopContractedBlocks(BlockSparseA const& A,
                       IndexSet const& Ais,
-                      QDense<TB> const& B,
+                      BlockSparseB const& B,
                       IndexSet const& Bis,
                       QDense<TC> & C,
                       IndexSet const& Cis,
@@ -268,14 +268,14 @@ _loopContractedBlocks(QDense<TA> const& A,
         }
     }
 
-template<typename TA,
-         typename TB,
+template<typename BlockSparseA,
+         typename BlockSparseB,
          typename TC,
          typename Callable>
 void
-_loopContractedBlocksOMP(QDense<TA> const& A,
+_loopContractedBlocksOMP(BlockSparseA const& A,
                          IndexSet const& Ais,
-                         QDense<TB> const& B,
+                         BlockSparseB const& B,
                          IndexSet const& Bis,
                          QDense<TC> & C,
                          IndexSet const& Cis,
@@ -349,14 +349,14 @@ _loopContractedBlocksOMP(QDense<TA> const& A,
     }
 
 
-template<typename TA,
-         typename TB,
+template<typename BlockSparseA,
+         typename BlockSparseB,
          typename TC,
          typename Callable>
 void
-loopContractedBlocks(QDense<TA> const& A,
+loopContractedBlocks(BlockSparseA const& A,
                      IndexSet const& Ais,
-                     QDense<TB> const& B,
+                     BlockSparseB const& B,
                      IndexSet const& Bis,
                      QDense<TC> & C,
                      IndexSet const& Cis,
@@ -52,6 +52,12 @@ class QDiag;
 template<typename T>
 class Scalar;
 
+template<typename T>
+class MappedDense;
+
+template<typename T>
+class MappedQDense;
+
 
 
 using 
@@ -69,7 +75,11 @@ QCombiner,
 QDiag<Real>,
 QDiag<Cplx>,
 Scalar<Real>,
-Scalar<Cplx>
+Scalar<Cplx>,
+MappedDense<Real>,
+MappedDense<Cplx>,
+MappedQDense<Real>,
+MappedQDense<Cplx>
 //-----------
 >;
 
@@ -84,4 +94,5 @@ Scalar<Cplx>
 #include "itensor/itdata/qcombiner.h"
 #include "itensor/itdata/qdiag.h"
 #include "itensor/itdata/scalar.h"
+#include "itensor/itdata/mapped.h"
 #endif
@@ -474,6 +474,39 @@ struct StorageType
 inline const char*
 typeNameOf(StorageType const&) { return "StorageType"; }
 
+//Storage types whose elements are one contiguous
+//array, which GetRawData can access
+bool inline
+isDenseType(StorageType::Type t)
+    {
+    return t == StorageType::DenseReal || t == StorageType::DenseCplx
+        || t == StorageType::QDenseReal || t == StorageType::QDenseCplx;
+    }
+
+//Pointer to and size of the element
+//data of Dense and QDense storage
+struct GetRawData
+    {
+    char const* data = nullptr;
+    size_t bytes = 0;
+    BlockOffsets const* offsets = nullptr;
+    };
+
+inline const char*
+typeNameOf(GetRawData const&) { return "GetRawData"; }
+
+//Writable pointer to the element data of Dense and
+//QDense storage, which is first made unique (mapped
+//storage is first copied into memory)
+struct GetMutableRawData
+    {
+    char* data = nullptr;
+    size_t bytes = 0;
+    };
+
+inline const char*
+typeNameOf(GetMutableRawData const&) { return "GetMutableRawData"; }
+
 
 //template<typename T>
 //void
@@ -582,6 +615,25 @@ struct ToDense
 inline const char*
 typeNameOf(ToDense) { return "ToDense";}
 
+class QCombiner;
+
+struct Matricize
+    {
+    IndexSet const& is;
+    IndexSet const& ris;
+    QCombiner const& rcmb;
+    IndexSet const& cis;
+    QCombiner const& ccmb;
+    IndexSet Nis;
+    Matricize(IndexSet const& is_,
+              IndexSet const& ris_, QCombiner const& rcmb_,
+              IndexSet const& cis_, QCombiner const& ccmb_) 
+      : is(is_), ris(ris_), rcmb(rcmb_), cis(cis_), ccmb(ccmb_) {}
+    };
+
+inline const char*
+typeNameOf(Matricize) { return "Matricize";}
+
 } //namespace itensor 
 
 #endif
@@ -90,7 +90,7 @@ eltC() const
         }
     constexpr size_t size = 0;
     auto inds = IntArray(size);
-    auto z = itensor::doTask(GetElt{is_,inds},store_);
+    auto z = itensor::doTask(GetElt{is_,inds},store());
 #ifndef USESCALE
     return z;
 #else
@@ -131,7 +131,7 @@ eltC(std::vector<IndexVal> const& ivs) const
     auto ints = IntArray(size);
     detail::permute_map(inds(),ivs,ints,
                 [](IndexVal const& iv) { return iv.val-1; });
-    auto z = itensor::doTask(GetElt{inds(),ints},store_);
+    auto z = itensor::doTask(GetElt{inds(),ints},store());
 #ifndef USESCALE
     return z;
 #else
@@ -813,13 +813,13 @@ read(std::istream& s)
 #ifdef ITENSOR_USE_HDF5
 
 void
-h5_write(h5::group parent, std::string const& name, ITensor const& T)
+h5_write(h5::group parent, std::string const& name, ITensor const& T, Args const& args)
     {
     auto g = parent.create_group(name);
     h5_write_attribute(g,"type","ITensor",true);
     h5_write_attribute(g,"version",long(1));
     h5_write(g,"inds",T.inds());
-    doTask(H5Write(g,"storage"),T.store());
+    doTask(H5Write(g,"storage",args),T.store());
     }
 
 void
@@ -848,6 +848,30 @@ h5_read(h5::group parent, std::string const& name, ITensor & I)
     I = ITensor(is,std::move(store));
     }
 
+template<typename V>
+ITensor
+h5_readBlock(h5::group g, IndexSet const& is, Block const& block)
+    {
+    auto D = QDense<V>();
+    h5_read_block(g,"storage",is,block,D);
+    return ITensor(is,std::move(D));
+    }
+
+ITensor
+h5_read_block(h5::group parent, std::string const& name, Block const& block)
+    {
+    auto g = parent.open_group(name);
+    auto type = h5_read_attribute<string>(g,"type");
+    if(type != "ITensor") Error("Group does not contain ITensor data in HDF5 file");
+    auto is = h5_read<IndexSet>(g,"inds");
+    if(not hasQNs(is)) Error("h5_read_block: ITensor has no QNs");
+    auto s_type = h5_read_attribute<string>(g.open_group("storage"),"type");
+    if(s_type == "BlockSparse{Float64}") return h5_readBlock<Real>(g,is,block);
+    if(s_type == "BlockSparse{ComplexF64}") return h5_readBlock<Cplx>(g,is,block);
+    error(format("h5_read_block: unsupported ITensor storage type %s",s_type));
+    return ITensor();
+    }
+
 #endif //ITENSOR_USE_HDF5
 
 
@@ -935,6 +959,7 @@ checkSameDiv(ITensor const& T1,
 ITensor& ITensor::
 operator*=(ITensor const& R)
     {
+    PROFILE_REGION("contract");
     auto& L = *this;
 
     if(!L || !R) Error("Default constructed ITensor in product");
@@ -1590,6 +1615,53 @@ combinedIndex(ITensor const& C)
     return inds(C).front();
     }
 
+struct GetQCombiner
+    {
+    template<typename D>
+    QCombiner const*
+    operator()(D const& d) { return nullptr; }
+    QCombiner const*
+    operator()(QCombiner const& d) { return &d; }
+    };
+
+ITensor
+matricize(ITensor T,
+          ITensor const& Crow,
+          ITensor const& Ccol)
+    {
+    if(!T || !Crow || !Ccol) Error("Default constructed ITensor in matricize");
+    auto* rcmb = applyFunc(GetQCombiner{},Crow.store());
+    auto* ccmb = applyFunc(GetQCombiner{},Ccol.store());
+    if(!hasQNs(T) || !rcmb || !ccmb)
+        {
+        auto nrow = order(Crow)-1,
+             ncol = order(Ccol)-1;
+        if(!hasQNs(T) && order(T) == nrow+ncol
+           && applyFunc(IsCombiner{},Crow.store())
+           && applyFunc(IsCombiner{},Ccol.store()))
+            {
+            //Permute once into (row...,col...) order: each
+            //combiner then acts on contiguous indices, which
+            //for Dense storage only relabels them
+            auto is = IndexSetBuilder(nrow+ncol);
+            for(auto n : range1(nrow)) is.nextIndex(Crow.inds()[n]);
+            for(auto n : range1(ncol)) is.nextIndex(Ccol.inds()[n]);
+            T.permute(is.build());
+            }
+        T *= Crow;
+        T *= Ccol;
+        return T;
+        }
+    if(Global::checkArrows())
+        {
+        detail::checkArrows(T.inds(),Crow.inds());
+        detail::checkArrows(T.inds(),Ccol.inds());
+        }
+    auto M = Matricize(T.inds(),Crow.inds(),*rcmb,Ccol.inds(),*ccmb);
+    doTask(M,T.store());
+    return ITensor(std::move(M.Nis),std::move(T.store()),T.scale());
+    }
+
 ITensor
 delta(IndexSet const& is)
     {
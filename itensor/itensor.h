@@ -919,6 +919,19 @@ combiner(Index const& i1,
 Index
 combinedIndex(ITensor const& C);
 
+//Reshape T into a matrix with the combined index of
+//the combiner Crow as rows and that of Ccol as columns.
+//Same result as T*Crow*Ccol, but for QN ITensors the
+//blocks are copied into the matrix in one pass, without
+//permuting blocks whose row and column indices are
+//already grouped and without forming T*Crow.
+//Dense ITensors are permuted at most once, then
+//combined without a copy
+ITensor
+matricize(ITensor T,
+          ITensor const& Crow,
+          ITensor const& Ccol);
+
 //Construct diagonal ITensor with diagonal 
 //elements set to 1.0
 ITensor
@@ -1096,10 +1109,20 @@ ITensor
 matrixTensor(CMatrix const& M, Index const& i1, Index const& i2);
 
 #ifdef ITENSOR_USE_HDF5
+//Compression of the tensor data is set by the
+//arguments of h5_compression (itensor/util/h5/wrap_h5.hpp)
 void
-h5_write(h5::group parent, std::string const& name, ITensor const& I);
+h5_write(h5::group parent, std::string const& name, ITensor const& I,
+         Args const& args = Args::global());
 void
 h5_read(h5::group parent, std::string const& name, ITensor & I);
+
+//Reads a single block of a QN ITensor written by h5_write.
+//Only the data of this block is read from the file. A block
+//which is not stored but has the QN flux of the ITensor is
+//returned filled with zeros; other blocks are an error.
+ITensor
+h5_read_block(h5::group parent, std::string const& name, Block const& block);
 #endif //ITENSOR_USE_HDF5
 
 } //namespace itensor
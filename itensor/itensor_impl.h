@@ -92,7 +92,7 @@ eltC(IV const& iv1, IVs&&... ivs) const
     auto inds = IntArray(size);
     detail::permute_map(is_,vals,inds,
                 [](IndexVal const& iv) { return iv.val-1; });
-    auto z = itensor::doTask(GetElt{is_,inds},store_);
+    auto z = itensor::doTask(GetElt{is_,inds},store());
 #ifndef USESCALE
     return z;
 #else
@@ -137,7 +137,7 @@ eltC(std::vector<Int> const& ints) const
     auto inds = IntArray(size);
     for(auto i : range(size))
         inds[i] = ints[i]-1;
-    auto z = itensor::doTask(GetElt{is_,inds},store_);
+    auto z = itensor::doTask(GetElt{is_,inds},store());
 #ifndef USESCALE
     return z;
 #else
@@ -449,7 +449,7 @@ template <typename Func>
 const ITensor& ITensor::
 visit(Func&& f) const
     {
-    doTask(VisitIT<decltype(f)>{std::forward<Func>(f),LogNum{scale().real0()}},store_);
+    doTask(VisitIT<decltype(f)>{std::forward<Func>(f),LogNum{scale().real0()}},store());
     return *this;
     }
 
@@ -570,8 +570,11 @@ struct H5Write
     {
     h5::group& parent;
     std::string name;
+    Args const& args;
 
-    H5Write(h5::group& parent_,std::string const& name_) : parent(parent_), name(name_) { }
+    H5Write(h5::group& parent_,std::string const& name_,
+            Args const& args_ = Args::global())
+      : parent(parent_), name(name_), args(args_) { }
     };
 inline const char*
 typeNameOf(H5Write const&) { return "H5Write"; }
@@ -579,9 +582,9 @@ typeNameOf(H5Write const&) { return "H5Write"; }
 template<typename D>
 auto
 doTask(H5Write & W, D const& d)
-    -> stdx::if_compiles_return<void,decltype(itensor::h5_write(W.parent,W.name,d))>
+    -> stdx::if_compiles_return<void,decltype(itensor::h5_write(W.parent,W.name,d,W.args))>
     {
-    h5_write(W.parent,W.name,d);
+    h5_write(W.parent,W.name,d,W.args);
     }
 
 #endif 
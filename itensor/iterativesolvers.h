@@ -102,6 +102,7 @@ davidson(BigMatrixT const& A,
          std::vector<ITensor>& phi,
          Args const& args)
     {
+    PROFILE_REGION("davidson");
     auto maxiter_ = args.getSizeT("MaxIter",2);
     auto errgoal_ = args.getReal("ErrGoal",1E-14);
     auto debug_level_ = args.getInt("DebugLevel",-1);
@@ -162,9 +163,9 @@ davidson(BigMatrixT const& A,
     auto eigs = std::vector<Real>(nget,NAN);
 
     V[0] = phi.front();
-TIMER_START(31);
+    PROFILE_START(p0,"product");
     A.product(V[0],AV[0]);
-TIMER_STOP(31);
+    PROFILE_STOP(p0);
 
     auto initEn = real(eltC((dag(V[0])*AV[0])));
 
@@ -380,9 +381,9 @@ TIMER_STOP(31);
         //Step G of Davidson (1975)
         //Expand AV and M
         //for next step
-TIMER_START(31);
+        PROFILE_START(pn,"product");
         A.product(V[ni],AV[ni]);
-TIMER_STOP(31);
+        PROFILE_STOP(pn);
 
         //Step H of Davidson (1975)
         //Add new row and column to M
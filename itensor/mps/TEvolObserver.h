@@ -17,6 +17,7 @@
 #define __ITENSOR_TEVOLOBSERVER_H
 #include "itensor/util/readwrite.h"
 #include "itensor/mps/observer.h"
+#include <vector>
 
 namespace itensor {
 
@@ -30,6 +31,17 @@ namespace itensor {
 class TEvolObserver : public Observer
     {
     public:
+
+    //Time step taken by an adaptive time evolution,
+    //as reported through the args passed to measure
+    struct Step
+        {
+        Real time = 0,      //time reached ("Time")
+             tau = 0,       //accepted step ("TimeStep")
+             error = 0,     //estimated local error ("StepError")
+             next_tau = 0;  //proposed next step ("NextTimeStep")
+        int rejected = 0;   //rejected attempts ("StepsRejected")
+        };
     
     TEvolObserver(Args const& args = Args::global());
 
@@ -41,6 +53,10 @@ class TEvolObserver : public Observer
     bool virtual
     checkDone(Args const& args = Args::global());
 
+    //Steps recorded from adaptive time evolution
+    std::vector<Step> const&
+    steps() const { return steps_; }
+
     private:
 
     /////////////
@@ -48,7 +64,9 @@ class TEvolObserver : public Observer
     // Data Members
 
     bool done_,
-         show_percent_;
+         show_percent_,
+         show_steps_;
+    std::vector<Step> steps_;
 
     //
     /////////////
@@ -59,7 +77,8 @@ inline TEvolObserver::
 TEvolObserver(const Args& args) 
     : 
     done_(false),
-    show_percent_(args.getBool("ShowPercent",true))
+    show_percent_(args.getBool("ShowPercent",true)),
+    show_steps_(args.getBool("ShowTimeStep",false))
     { 
     }
 
@@ -68,6 +87,21 @@ void inline TEvolObserver::
 measure(const Args& args)
     {
     const Real t = args.getReal("Time");
+    if(args.defined("TimeStep"))
+        {
+        auto st = Step();
+        st.time = t;
+        st.tau = args.getReal("TimeStep");
+        st.error = args.getReal("StepError",0.);
+        st.next_tau = args.getReal("NextTimeStep",st.tau);
+        st.rejected = args.getInt("StepsRejected",0);
+        steps_.push_back(st);
+        if(show_steps_)
+            {
+            printfln("\nt = %.5f: step %.3E accepted (error %.2E, %d rejected), next step %.3E",
+                     t,st.tau,st.error,st.rejected,st.next_tau);
+            }
+        }
     if(show_percent_)
         {
         const Real ttotal = args.getReal("TotalTime");
@@ -14,7 +14,11 @@
 // limitations under the License.
 //
 #include <algorithm>
+#include <exception>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include "itensor/util/print_macro.h"
 #include "itensor/mps/autompo.h"
 #include "itensor/tensor/algs.h"
@@ -72,11 +76,63 @@ isReal(const Cplx& z) { return z.imag() == 0; }
 bool
 isApproxReal(Cplx const& z, Real epsilon = 1E-12) { return std::fabs(z.imag()) < epsilon; }
 
+//Global table of interned operator names.
+//Elements of an unordered_set are never moved by rehashing,
+//so OpNames pointing to them stay valid for the life of the
+//program and may be read without locking.
+class OpNameTable
+    {
+    std::mutex mutex_;
+    std::unordered_set<string> names_;
+    public:
+
+    static OpNameTable&
+    get()
+        {
+        static OpNameTable table;
+        return table;
+        }
+
+    OpName::Entry const*
+    intern(string const& name)
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return &(*names_.insert(name).first);
+        }
+    };
+
+OpName::
+OpName() : name_(OpNameTable::get().intern("")) { }
+
+OpName::
+OpName(string const& name) : name_(OpNameTable::get().intern(name)) { }
+
+OpName::
+OpName(const char* name) : name_(OpNameTable::get().intern(name)) { }
+
+//Names used while building the MPO, interned once so that
+//the per-term loops (some in parallel) never lock the table
+static const OpName OpF("F"),
+                    OpId("Id");
+
+//Rewrites of op by the first matching pair of rewrites
+template<size_t N>
+OpName
+rewriteOp(std::array<std::pair<OpName,OpName>,N> const& rewrites,
+          OpName const& op)
+    {
+    for(auto& p : rewrites)
+        {
+        if(p.first == op) return p.second;
+        }
+    return op;
+    }
+
 SiteTerm::
 SiteTerm() : i(-1) { }
 
 SiteTerm::
-SiteTerm(string const& op_,
+SiteTerm(OpName const& op_,
          int i_)
     :
     op(op_),
@@ -87,7 +143,7 @@ bool
 isFermionic(SiteTerm const& st)
     {
 #ifdef DEBUG
-    for(char c : st.op)
+    for(char c : st.op.str())
     if(c == '*')
         {
         Print(st.op);
@@ -118,24 +174,20 @@ isFermionic(SiteTermProd const& sprod)
     return isf;
     }
 
-string
-fermionicTerm(const string& op)
+OpName
+fermionicTerm(OpName const& op)
     {
-    static array<pair<string,string>,6>
+    static const array<pair<OpName,OpName>,6>
            rewrites =
            {{
-           make_pair("Cdagup","Adagup"),
-           make_pair("Cup","Aup"),
-           make_pair("Cdagdn","Adagdn*Fup"),
-           make_pair("Cdn","Adn*Fup"),
-           make_pair("C","A"),
-           make_pair("Cdag","Adag")
+           std::make_pair<OpName,OpName>("Cdagup","Adagup"),
+           std::make_pair<OpName,OpName>("Cup","Aup"),
+           std::make_pair<OpName,OpName>("Cdagdn","Adagdn*Fup"),
+           std::make_pair<OpName,OpName>("Cdn","Adn*Fup"),
+           std::make_pair<OpName,OpName>("C","A"),
+           std::make_pair<OpName,OpName>("Cdag","Adag")
            }};
-    for(auto& p : rewrites)
-        {
-        if(p.first == op) return p.second;
-        }
-    return op;
+    return rewriteOp(rewrites,op);
     }
 
 void 
@@ -162,21 +214,72 @@ rewriteFermionic(SiteTermProd & prod,
     // to the left (including this site) is fermionic
     if((isleftFermionic && !isSiteFermionic) || (!isleftFermionic && isSiteFermionic))
         {
-        prod.emplace_back("F", i);         
+        prod.emplace_back(OpF,i);         
         }
     }
 
+//
+// Cache of site operators and of their QN flux,
+// keyed on (operator name, site) so that SiteSets
+// mixing different site types are handled correctly.
+// Each distinct operator is built by SiteSet::op only once.
+//
+class SiteOpCache
+    {
+    struct Hash
+        {
+        size_t
+        operator()(SiteTerm const& st) const
+            {
+            return std::hash<string const*>()(&st.op.str()) ^ (std::hash<int>()(st.i) << 1);
+            }
+        };
+    SiteSet const& sites_;
+    std::unordered_map<SiteTerm,ITensor,Hash> ops_;
+    std::unordered_map<SiteTerm,QN,Hash> qns_;
+    public:
+
+    explicit
+    SiteOpCache(SiteSet const& sites) : sites_(sites) { }
+
+    SiteSet const&
+    sites() const { return sites_; }
+
+    //ITensor copies share their storage,
+    //so returning by value is inexpensive
+    ITensor
+    op(SiteTerm const& st)
+        {
+        auto it = ops_.find(st);
+        if(it != ops_.end()) return it->second;
+        auto Op = sites_.op(st.op,st.i);
+        ops_.emplace(st,Op);
+        return Op;
+        }
+
+    ITensor
+    op(OpName const& opname, int i) { return op(SiteTerm(opname,i)); }
+
+    //QN flux of the operator, -div(Op)
+    QN const&
+    qn(SiteTerm const& st)
+        {
+        auto it = qns_.find(st);
+        if(it != qns_.end()) return it->second;
+        return qns_.emplace(st,-div(op(st))).first->second;
+        }
+    };
+
 ITensor
-computeProd(SiteSet const& sites, 
+computeProd(SiteOpCache & ops, 
             SiteTermProd const& p)
     {
     auto i = p.front().i;
-    ITensor op = sites.op(p.front().op,i);
+    ITensor op = ops.op(p.front());
     for(auto it = p.begin()+1; it != p.end(); ++it)
         {
         if(it->i != i) Error("Op on wrong site");
-        ITensor t = sites.op(it->op,i);
-        op = multSiteOps(op,t);
+        op = multSiteOps(op,ops.op(*it));
         }
     return op;
     }
@@ -227,7 +330,7 @@ operator==(HTerm const& o) const
     if(not equal(coef,o.coef,1E-12)) return false;
     if(Nops() != o.Nops()) return false;
 
-    for(size_t n = 0; n <= ops.size(); ++n)
+    for(size_t n = 0; n < ops.size(); ++n)
     if(ops[n] != o.ops.at(n)) 
         {
         return false;
@@ -306,7 +409,7 @@ AutoMPO::Accumulator::
     {
     if(state==Op) Error("Invalid input to AutoMPO (missing site number?)");
     term *= coef;
-    pa->add(term);
+    pa->add(move(term));
     }
     
 
@@ -370,22 +473,261 @@ operator,(const string& op_)
     return *this;
     }
 
+//Adds the coefficient of t to a matching term already
+//in the storage, or inserts t if there is none.
+//The coefficient is not part of the LessNoCoef ordering,
+//so it may be modified in place without disturbing the set.
+template<typename HTermType>
+void
+addOrMerge(AutoMPO::storage & terms,
+           AutoMPO::storage::iterator hint,
+           HTermType && t)
+    {
+    if(hint != terms.end() && not LessNoCoef()(t,*hint))
+        {
+        const_cast<HTerm&>(*hint).coef += t.coef;
+        }
+    else
+        {
+        terms.emplace_hint(hint,std::forward<HTermType>(t));
+        }
+    }
+
+PackedTerm static
+pack(HTerm const& t)
+    {
+    auto p = PackedTerm();
+    p.coef = t.coef;
+    for(auto n : range(t.ops.size()))
+        {
+        p.op[n] = t.ops[n].op.entry();
+        p.site[n] = t.ops[n].i;
+        }
+    return p;
+    }
+
+int PackedTerm::
+Nops() const
+    {
+    auto n = 0;
+    while(n < max_ops && op[n]) ++n;
+    return n;
+    }
+
+bool LessPacked::
+operator()(PackedTerm const& p1, PackedTerm const& p2) const
+    {
+    auto n1 = p1.Nops(),
+         n2 = p2.Nops();
+    if(n1 != n2) return n1 < n2;
+    for(auto j : range(n1))
+        {
+        if(p1.site[j] != p2.site[j]) return p1.site[j] < p2.site[j];
+        if(p1.op[j] != p2.op[j]) return *p1.op[j] < *p2.op[j];
+        }
+    return false;
+    }
+
+bool static
+sameOps(PackedTerm const& p1, PackedTerm const& p2)
+    {
+    return p1.op == p2.op && p1.site == p2.site;
+    }
+
+//Merges runs of equal operator strings of a
+//sorted range in place, returning its new end
+vector<PackedTerm>::iterator static
+mergeDuplicates(vector<PackedTerm>::iterator first,
+                vector<PackedTerm>::iterator last)
+    {
+    if(first == last) return last;
+    auto res = first;
+    for(auto it = first+1; it != last; ++it)
+        {
+        if(sameOps(*res,*it))
+            {
+            res->coef += it->coef;
+            }
+        else
+            {
+            ++res;
+            if(res != it) *res = *it;
+            }
+        }
+    return res+1;
+    }
+
 void AutoMPO::
 add(HTerm const& t)
     {
     if(abs(t.coef) == 0.0) return;
+    if(t.Nops() > PackedTerm::max_ops)
+        {
+        addOrMerge(long_terms_,long_terms_.lower_bound(t),t);
+        return;
+        }
+    auto p = pack(t);
+    auto hint = added_.lower_bound(p);
+    if(hint != added_.end() && sameOps(p,*hint))
+        {
+        //The coefficient is not part of the LessPacked ordering
+        const_cast<PackedTerm&>(*hint).coef += p.coef;
+        return;
+        }
+    if(std::binary_search(packed_.begin(),packed_.end(),p,LessPacked())) ++nshared_;
+    added_.emplace_hint(hint,p);
+    //Merging once the added terms are as many as the merged
+    //ones costs amortized O(log(size)) per term
+    if(added_.size() >= std::max(packed_.size(),size_t(1024))) mergeAdded();
+    }
+
+void AutoMPO::
+add(HTerm && t)
+    {
+    if(t.Nops() <= PackedTerm::max_ops || abs(t.coef) == 0.0)
+        {
+        add(static_cast<HTerm const&>(t));
+        return;
+        }
+    auto hint = long_terms_.lower_bound(t);
+    addOrMerge(long_terms_,hint,move(t));
+    }
+
+void AutoMPO::
+addTerms(vector<HTerm> const& terms)
+    {
+    mergeAdded();
+    auto nmerged = packed_.size();
+    packed_.reserve(nmerged+terms.size());
+    for(auto& t : terms) 
+        {
+        if(abs(t.coef) == 0.0) continue;
+        if(t.Nops() > PackedTerm::max_ops) addOrMerge(long_terms_,long_terms_.lower_bound(t),t);
+        else                               packed_.push_back(pack(t));
+        }
+    mergePacked(nmerged);
+    }
+
+void AutoMPO::
+mergeAdded()
+    {
+    auto nmerged = packed_.size();
+    packed_.insert(packed_.end(),added_.begin(),added_.end());
+    added_.clear();
+    nshared_ = 0;
+    mergePacked(nmerged);
+    }
+
+//Sorts the terms of packed_ after the first nmerged
+//and merges them with the first nmerged
+void AutoMPO::
+mergePacked(size_t nmerged)
+    {
+    auto less = LessPacked();
+    auto mid = packed_.begin()+nmerged;
+    std::sort(mid,packed_.end(),less);
+    mid = mergeDuplicates(mid,packed_.end());
+    std::inplace_merge(packed_.begin(),packed_.begin()+nmerged,mid,less);
+    packed_.erase(mergeDuplicates(packed_.begin(),mid),packed_.end());
+    }
+
+AutoMPO::TermRange AutoMPO::
+termRange() const
+    {
+    return TermRange(*this);
+    }
+
+AutoMPO::storage AutoMPO::
+terms() const
+    {
+    auto res = storage();
+    for(auto& t : termRange()) res.emplace_hint(res.end(),t);
+    return res;
+    }
+
+int AutoMPO::
+size() const
+    {
+    return packed_.size()+added_.size()-nshared_+long_terms_.size();
+    }
+
+void AutoMPO::
+reset()
+    {
+    packed_.clear();
+    added_.clear();
+    nshared_ = 0;
+    long_terms_.clear();
+    }
 
-    auto it = terms_.find(t);
-    if(it == terms_.end())
+AutoMPO::TermIter::
+TermIter(AutoMPO const& am, bool end)
+  : am_(&am),
+    p_(end ? am.packed_.end() : am.packed_.begin()),
+    a_(end ? am.added_.end() : am.added_.begin()),
+    l_(end ? am.long_terms_.end() : am.long_terms_.begin())
+    {
+    if(not end) unpackCurrent();
+    }
+
+AutoMPO::TermIter& AutoMPO::TermIter::
+operator++()
+    {
+    auto pdone = (p_ == am_->packed_.end()),
+         adone = (a_ == am_->added_.end());
+    if(pdone && adone)
         {
-        terms_.insert(move(t));
+        ++l_;
         }
-    else //found duplicate
+    else if(pdone)
         {
-        auto nt = t;
-        nt.coef += it->coef;
-        terms_.erase(it);
-        terms_.insert(move(nt));
+        ++a_;
+        }
+    else if(adone)
+        {
+        ++p_;
+        }
+    else
+        {
+        auto less = LessPacked();
+        if(less(*p_,*a_))      ++p_;
+        else if(less(*a_,*p_)) ++a_;
+        else                   { ++p_; ++a_; }
+        }
+    unpackCurrent();
+    return *this;
+    }
+
+//Sets t_ to the term at the current position,
+//reusing the storage of its operator vector
+void AutoMPO::TermIter::
+unpackCurrent()
+    {
+    auto pdone = (p_ == am_->packed_.end()),
+         adone = (a_ == am_->added_.end());
+    if(pdone && adone)
+        {
+        if(l_ != am_->long_terms_.end()) t_ = *l_;
+        return;
+        }
+    auto less = LessPacked();
+    PackedTerm const* p = nullptr;
+    auto coef = Cplx(0.);
+    if(not pdone && (adone || not less(*a_,*p_)))
+        {
+        p = &(*p_);
+        coef += p_->coef;
+        }
+    if(not adone && (pdone || not less(*p_,*a_)))
+        {
+        p = &(*a_);
+        coef += a_->coef;
+        }
+    t_.coef = coef;
+    t_.ops.clear();
+    for(auto n : range(p->Nops()))
+        {
+        t_.ops.emplace_back(OpName(p->op[n]),p->site[n]);
         }
     }
 
@@ -502,44 +844,36 @@ plusAppend(string & s, string const& a)
 //#define SHOW_AUTOMPO
 
 
-string
-startTerm(const string& op)
+OpName
+startTerm(OpName const& op)
     {
-    static array<pair<string,string>,6>
+    static const array<pair<OpName,OpName>,6>
            rewrites =
            {{
-           make_pair("Cdagup","Adagup*F"),
-           make_pair("Cup","Aup*F"),
-           make_pair("Cdagdn","Adagdn"),
-           make_pair("Cdn","Adn"),
-           make_pair("C","A*F"), //A*F is -A, so essentially a trick for putting in a -1
-           make_pair("Cdag","Adag")
+           std::make_pair<OpName,OpName>("Cdagup","Adagup*F"),
+           std::make_pair<OpName,OpName>("Cup","Aup*F"),
+           std::make_pair<OpName,OpName>("Cdagdn","Adagdn"),
+           std::make_pair<OpName,OpName>("Cdn","Adn"),
+           std::make_pair<OpName,OpName>("C","A*F"), //A*F is -A, so essentially a trick for putting in a -1
+           std::make_pair<OpName,OpName>("Cdag","Adag")
            }};
-    for(auto& p : rewrites)
-        {
-        if(p.first == op) return p.second;
-        }
-    return op;
+    return rewriteOp(rewrites,op);
     }
 
-string
-endTerm(const string& op)
+OpName
+endTerm(OpName const& op)
     {
-    static array<pair<string,string>,6>
+    static const array<pair<OpName,OpName>,6>
            rewrites =
            {{
-           make_pair("Cup","Aup"),
-           make_pair("Cdagup","Adagup"),
-           make_pair("Cdn","F*Adn"),
-           make_pair("Cdagdn","F*Adagdn"),
-           make_pair("C","A"),
-           make_pair("Cdag","Adag")
+           std::make_pair<OpName,OpName>("Cup","Aup"),
+           std::make_pair<OpName,OpName>("Cdagup","Adagup"),
+           std::make_pair<OpName,OpName>("Cdn","F*Adn"),
+           std::make_pair<OpName,OpName>("Cdagdn","F*Adagdn"),
+           std::make_pair<OpName,OpName>("C","A"),
+           std::make_pair<OpName,OpName>("Cdag","Adag")
            }};
-    for(auto& p : rewrites)
-        {
-        if(p.first == op) return p.second;
-        }
-    return op;
+    return rewriteOp(rewrites,op);
     }
 
 ITensor
@@ -555,8 +889,10 @@ toMPOImpl(AutoMPO const& am,
     auto const& sites = am.sites();
     auto H = MPO(sites);
     auto N = length(sites);
+    auto ops = SiteOpCache(sites);
+    auto terms = am.termRange();
 
-    for(auto& t : am.terms())
+    for(auto& t : terms)
     if(t.Nops() > 2) 
         {
         Error("Only at most 2-operator terms allowed for exact AutoMPO conversion to MPO");
@@ -585,7 +921,7 @@ toMPOImpl(AutoMPO const& am,
     //the unique operator types occurring on the site
     //(unique including their coefficient)
     //and starting a string of operators (i.e. first op of an HTerm)
-    for(auto& ht : am.terms())
+    for(auto& ht : terms)
         {
         for(auto n = ht.first().i; n <= ht.last().i; ++n)
             {
@@ -597,8 +933,7 @@ toMPOImpl(AutoMPO const& am,
                 //printfln("Adding Op to basis at %d, Op=\n%s",n,Op);
                 if(checkqns)
                     {
-                    auto Op = sites.op(ht.first().op,ht.first().i);
-                    bn.emplace_back(ht.first(),-div(Op));
+                    bn.emplace_back(ht.first(),ops.qn(ht.first()));
                     }
                 else
                     {
@@ -666,7 +1001,7 @@ toMPOImpl(AutoMPO const& am,
     //all HTerms (operator strings) which begin on,
     //end on, or cross site "j"
     auto ht_by_n = vector<vector<HTerm>>(N+1);
-    for(auto& ht : am.terms()) 
+    for(auto& ht : terms) 
     for(auto& st : ht.ops)
         {
         ht_by_n.at(st.i).push_back(ht);
@@ -712,7 +1047,7 @@ toMPOImpl(AutoMPO const& am,
                 //    PrintData(W);
                 //    EXIT
                 //    }
-                W += convert_tensor(sites.op(op,n)) * rc;
+                W += convert_tensor(ops.op(op,n)) * rc;
 #ifdef SHOW_AUTOMPO
                 ws[r][c] = op;
 #endif
@@ -746,11 +1081,11 @@ toMPOImpl(AutoMPO const& am,
 
                 if(isFermionic(cst))
                     {
-                    W += convert_tensor(sites.op("F",n)) * rc;
+                    W += convert_tensor(ops.op(OpF,n)) * rc;
                     }
                 else
                     {
-                    W += convert_tensor(sites.op("Id",n)) * rc;
+                    W += convert_tensor(ops.op(OpId,n)) * rc;
                     }
 #ifdef SHOW_AUTOMPO
                 if(isFermionic(cst)) ws[r][c] = "F";
@@ -771,7 +1106,7 @@ toMPOImpl(AutoMPO const& am,
                 if(rst == ht.first() && ht.last().i == n)
                     {
                     auto op = endTerm(ht.last().op);
-                    W += ht.coef * convert_tensor(sites.op(op,n)) * rc;
+                    W += ht.coef * convert_tensor(ops.op(op,n)) * rc;
 #ifdef SHOW_AUTOMPO
                     ws[r][c] = op;
                     auto coef = ht.coef;
@@ -799,7 +1134,7 @@ toMPOImpl(AutoMPO const& am,
                     else
                         ws[r][c] = format("%.2f %s",ht.coef,ht.first().op);
 #endif
-                    W += ht.coef * convert_tensor(op(sites,ht.first().op,n)) * rc;
+                    W += ht.coef * convert_tensor(ops.op(ht.first())) * rc;
                     }
                 }
 
@@ -982,53 +1317,20 @@ conj(Real x) { return x; }
 template<typename T>
 void
 partitionHTerms(SiteSet const& sites,
-                AutoMPO::storage const& terms,
+                AutoMPO::TermRange const& terms,
                 vector<QNBlock<T>> & qbs, 
                 vector<IQMatEls> & tempMPO,
                 bool checkqns = true)
     {
     auto N = length(sites);
 
-    // TODO: This version of calcQN uses a "qnmap" to improve
-    //       the speed.
-    //       The qnmap keys are just strings, which assumes
-    //       all operators with the same name have the same
-    //       QN divergence. This wouldn't be true e.g. for
-    //       a spin model with different spin sizes at 
-    //       different sites.
-    //
-    //auto qnmap = map<string,QN>();
-    //auto calcQN = [&qnmap,&sites](SiteTermProd const& prod)
-    //    {
-    //    QN qn;
-    //    for(auto& st : prod)
-    //        {
-    //        auto it = qnmap.find(st.op);
-    //        if(it != qnmap.end())
-    //            {
-    //            qn += it->second;
-    //            }
-    //        else
-    //            {
-    //            auto Op = op(sites,st.op,st.i);
-    //            auto OpQN = -div(Op);
-    //            qnmap[st.op] = OpQN;
-    //            qn += OpQN;
-    //            }
-    //        }
-    //    return qn;
-    //    };
-
-    auto calcQN = [&sites](SiteTermProd const& prod)
+    //Operator QN flux is cached per (operator name, site),
+    //so the QN of each distinct operator is only computed once
+    auto ops = SiteOpCache(sites);
+    auto calcQN = [&ops](SiteTermProd const& prod)
         {
         QN qn;
-        for(auto& st : prod)
-            {
-            auto Op = op(sites,st.op,st.i);
-            //if(not hasQNs(Op)) return QN();
-            auto OpQN = -div(Op);
-            qn += OpQN;
-            }
+        for(auto& st : prod) qn += ops.qn(st);
         return qn;
         };
 
@@ -1081,8 +1383,8 @@ partitionHTerms(SiteSet const& sites,
         bool leftF = isFermionic(left);
         if(onsite.empty())
             {
-            if(leftF) onsite.emplace_back("F",n);
-            else      onsite.emplace_back("Id",n);
+            if(leftF) onsite.emplace_back(OpF,n);
+            else      onsite.emplace_back(OpId,n);
             }
         else
             {
@@ -1185,36 +1487,54 @@ compressMPO(SiteSet const& sites,
     finalMPO.resize(N);
     links.resize(N+1);
     
-    auto V_n = map<QN, Mat<T>>();
-    
     const QN ZeroQN;
     
     int d0 = isExpH ? 1 : 2;
+
+    //Put in factor of (-tau) if isExpH==true
+    if(isExpH) Error("Need to put in factor of (-tau)");
     
     //TODO: check these are the correct tags
     if(hasqn) links.at(0) = Index(ZeroQN,d0,format("Link,l=%d",0));
     else      links.at(0) = Index(d0,format("Link,l=%d",0));
 
-    auto max_d = dim(links.at(0));
+    //
+    // The coefficient matrix of every QN block on every link
+    // only depends on the output of partitionHTerms, so all
+    // of the SVDs are independent. Collect them into a flat
+    // list of tasks and carry them out in parallel.
+    //
+    // Vs.at(n-1) holds the truncated right singular vectors
+    // for the link between sites n and n+1
+    //
+    auto Vs = vector<map<QN,Mat<T>>>(N);
+    auto svd_tasks = vector<pair<BasisBlock<T> const*,Mat<T>*>>();
     for(int n = 1; n <= N; ++n)
         {
-        //printfln("=== Making compressed MPO at site %d ===",n);
-        //Put in factor of (-tau) if isExpH==true
-        if(isExpH) Error("Need to put in factor of (-tau)");
-
-        auto V_npp = map<QN, Mat<T>>();
-
-        int nsector = 1; //always have ZeroQN sector
+        auto& V_n = Vs.at(n-1);
+        //Always create the ZeroQN entry, and create
+        //all map entries here so that the parallel
+        //loop below never modifies a map
+        V_n[ZeroQN];
+        for(auto& qb : qbs.at(n-1))
+            {
+            svd_tasks.emplace_back(&qb.second,&V_n[qb.first]);
+            }
+        }
 
-        for(auto& qb : qbs.at(n-1) )
+    //Exceptions cannot leave the parallel regions, so
+    //each task records its own and they are rethrown after
+    auto svd_failure = vector<std::exception_ptr>(svd_tasks.size());
+#pragma omp parallel for schedule(dynamic)
+    for(int t = 0; t < int(svd_tasks.size()); ++t)
+        {
+        try
             {
-            auto& qn = qb.first;
-            if(qn != ZeroQN) ++nsector;
+            auto& block = *svd_tasks[t].first;
+            auto& V = *svd_tasks[t].second;
 
             // Convert the block matrix elements to a dense matrix
-            auto M = toMatrix(qb.second.mat);
-
-            auto& V = V_npp[qn];
+            auto M = toMatrix(block.mat);
 
             Mat<T> U;
             Vector D;
@@ -1228,134 +1548,156 @@ compressMPO(SiteSet const& sites,
             int nc = ncols(M);
             resize(V,nc,m);
             }
+        catch(...)
+            {
+            svd_failure[t] = std::current_exception();
+            }
+        }
+    for(auto& f : svd_failure) if(f) std::rethrow_exception(f);
 
+    for(int n = 1; n <= N; ++n)
+        {
+        auto const& V_npp = Vs.at(n-1);
         if(hasqn)
             {
-            auto inqn = stdx::reserve_vector<QNInt>(nsector);
+            auto inqn = stdx::reserve_vector<QNInt>(V_npp.size());
             // Make sure zero QN is first in the list of indices
-            inqn.emplace_back(ZeroQN,d0+ncols(V_npp[ZeroQN]));
+            inqn.emplace_back(ZeroQN,d0+ncols(V_npp.at(ZeroQN)));
             for(auto const& qb : qbs.at(n-1))
                 {
                 QN const& q = qb.first;
                 if(q == ZeroQN) continue; // was already taken care of
-                int m = ncols(V_npp[q]);
+                int m = ncols(V_npp.at(q));
                 inqn.emplace_back(q,m);
                 }
             links.at(n) = Index(move(inqn),format("Link,l=%d",n));
             }
         else
             {
-            long m = d0+ncols(V_npp[ZeroQN]);
+            long m = d0+ncols(V_npp.at(ZeroQN));
             for(auto const& qb : qbs.at(n-1))
                 {
                 QN const& q = qb.first;
                 if(q == ZeroQN) continue; // was already taken care of
-                m += ncols(V_npp[q]);
+                m += ncols(V_npp.at(q));
                 }
             links.at(n) = Index(m,format("Link,l=%d",n));
             }
+        }
 
-        //
-        // Construct the compressed MPO
-        //
-        auto& fm = finalMPO.at(n-1);
+    //
+    // Construct the compressed MPO. Each site only writes
+    // to its own finalMPO entry, so sites are independent.
+    //
+    auto const NoV = map<QN,Mat<T>>();
+    auto site_failure = vector<std::exception_ptr>(N);
+#pragma omp parallel for schedule(dynamic)
+    for(int n = 1; n <= N; ++n)
+        {
+        try
+            {
+            auto const& V_npp = Vs.at(n-1);
+            auto const& V_n = (n > 1) ? Vs.at(n-2) : NoV;
 
-        auto& IdM = fm[QNProd{ZeroQN,SiteTermProd(1,{"Id",n})}];
-        auto& ll = links.at(n-1);
-        auto& rl = links.at(n);
+            auto& fm = finalMPO.at(n-1);
 
-        long lm=0,rm=0;
-        if(hasqn)
-            {
-            lm = QNblockSize(ll,ZeroQN);
-            rm = QNblockSize(rl,ZeroQN);
+            auto& IdM = fm[QNProd{ZeroQN,SiteTermProd(1,{OpId,n})}];
+            auto& ll = links.at(n-1);
+            auto& rl = links.at(n);
+
+            long lm=0,rm=0;
+            if(hasqn)
+                {
+                lm = QNblockSize(ll,ZeroQN);
+                rm = QNblockSize(rl,ZeroQN);
+                IdM = Mat<T>(lm,rm);
+                }
+            else
+                {
+                lm = dim(ll);
+                rm = dim(rl);
+                }
             IdM = Mat<T>(lm,rm);
-            }
-        else
-            {
-            lm = dim(ll);
-            rm = dim(rl);
-            }
-        IdM = Mat<T>(lm,rm);
-        IdM(0,0) = 1.;
-        if(!isExpH) IdM(1,1) = 1.;
+            IdM(0,0) = 1.;
+            if(!isExpH) IdM(1,1) = 1.;
 
-        for(IQMPOMatElem const& elem: tempMPO.at(n-1))
-            {
-            int j = elem.row;
-            int k = elem.col;
-            auto& t = elem.val;
+            for(IQMPOMatElem const& elem: tempMPO.at(n-1))
+                {
+                int j = elem.row;
+                int k = elem.col;
+                auto& t = elem.val;
             
-            if(isZero(t.coef,eps)) continue;
+                if(isZero(t.coef,eps)) continue;
 
-            auto& M = fm[QNProd{elem.rowqn,t.ops}];
+                auto& M = fm[QNProd{elem.rowqn,t.ops}];
 
-            if(nrows(M)==0)
-                {
-                long rowm=0,colm=0;
-                if(hasqn)
+                if(nrows(M)==0)
                     {
-                    rowm = QNblockSize(ll,elem.rowqn);
-                    colm = QNblockSize(rl,elem.colqn);
-                    }
-                else
-                    {
-                    rowm = dim(ll);
-                    colm = dim(rl);
+                    long rowm=0,colm=0;
+                    if(hasqn)
+                        {
+                        rowm = QNblockSize(ll,elem.rowqn);
+                        colm = QNblockSize(rl,elem.colqn);
+                        }
+                    else
+                        {
+                        rowm = dim(ll);
+                        colm = dim(rl);
+                        }
+                    M = Mat<T>(rowm,colm);
                     }
-                M = Mat<T>(rowm,colm);
-                }
 
-            int rowOffset = isExpH ? 0 : 1;
+                int rowOffset = isExpH ? 0 : 1;
 
-            //rowShift & colShift account for special identity
-            //entries in zero QN block of MPO
-            auto rowShift = (elem.rowqn==ZeroQN) ? d0 : 0;
-            auto colShift = (elem.colqn==ZeroQN) ? d0 : 0;
+                //rowShift & colShift account for special identity
+                //entries in zero QN block of MPO
+                auto rowShift = (elem.rowqn==ZeroQN) ? d0 : 0;
+                auto colShift = (elem.colqn==ZeroQN) ? d0 : 0;
 
-            auto coef = forceType<T>(t.coef);
+                auto coef = forceType<T>(t.coef);
 
-            if(j==-1 && k==-1)	// on-site terms
-                {
-                M(rowOffset,0) += coef;
-                }
-            else if(j==-1)  	// terms starting on site n
-                {
-                auto& V = V_npp[elem.colqn];
-                for(size_t i = 0; i < ncols(V); ++i)
+                if(j==-1 && k==-1)	// on-site terms
                     {
-                    auto z = coef*V(k,i);
-                    M(rowOffset,i+colShift) += z;
+                    M(rowOffset,0) += coef;
                     }
-                }
-            else if(k==-1) 	// terms ending on site n
-                {
-                auto& V = V_n[elem.rowqn];
-                for(size_t r = 0; r < ncols(V); ++r)
+                else if(j==-1)  	// terms starting on site n
                     {
-                    auto z = coef*conj(V(j,r));
-                    M(r+rowShift,0) += z;
+                    auto& V = V_npp.at(elem.colqn);
+                    for(size_t i = 0; i < ncols(V); ++i)
+                        {
+                        auto z = coef*V(k,i);
+                        M(rowOffset,i+colShift) += z;
+                        }
                     }
-                }
-            else 
-                {
-                auto& Vr = V_n[elem.rowqn];
-                auto& Vc = V_npp[elem.colqn];
-                for(size_t r = 0; r < ncols(Vr); ++r)
-                for(size_t c = 0; c < ncols(Vc); ++c) 
+                else if(k==-1) 	// terms ending on site n
+                    {
+                    auto& V = V_n.at(elem.rowqn);
+                    for(size_t r = 0; r < ncols(V); ++r)
+                        {
+                        auto z = coef*conj(V(j,r));
+                        M(r+rowShift,0) += z;
+                        }
+                    }
+                else 
                     {
-                    auto z = coef*conj(Vr(j,r))*Vc(k,c);
-                    M(r+rowShift,c+colShift) += z;
+                    auto& Vr = V_n.at(elem.rowqn);
+                    auto& Vc = V_npp.at(elem.colqn);
+                    for(size_t r = 0; r < ncols(Vr); ++r)
+                    for(size_t c = 0; c < ncols(Vc); ++c) 
+                        {
+                        auto z = coef*conj(Vr(j,r))*Vc(k,c);
+                        M(r+rowShift,c+colShift) += z;
+                        }
                     }
                 }
             }
-
-        // Store SVD computed at this step for next link
-        V_n = move(V_npp);
-        
-        max_d = max(max_d, dim(links.at(n)));
+        catch(...)
+            {
+            site_failure[n-1] = std::current_exception();
+            }
         }
-    //println("Maximal dimension of the MPO is ", max_d);
+    for(auto& f : site_failure) if(f) std::rethrow_exception(f);
+
     }
 
 template<typename T>
@@ -1367,6 +1709,7 @@ constructMPOTensors(SiteSet const& sites,
     {
     auto H = MPO(sites);
     int N = length(sites);
+    auto ops = SiteOpCache(sites);
 
     auto isExpH = args.getBool("IsExpH",false);
     auto infinite = args.getBool("Infinite",false);
@@ -1387,7 +1730,7 @@ constructMPOTensors(SiteSet const& sites,
             auto& prod = qp_M.first.prod;
             auto& M = qp_M.second;
 
-            auto Op = computeProd(sites,prod);
+            auto Op = computeProd(ops,prod);
             if(hasQNs(sites(1)))
                 {
                 auto rq = qp_M.first.q;
@@ -1432,8 +1775,9 @@ svdMPO(AutoMPO const& am,
     bool isExpH = false;
     Cplx tau = 0.;
 
+    auto terms = am.termRange();
     bool is_real = true;
-    for(auto& t : am.terms())
+    for(auto& t : terms)
         {
         if(t.coef.imag() != 0.0)
             {
@@ -1451,7 +1795,7 @@ svdMPO(AutoMPO const& am,
         {
         auto qbs = vector<QNBlock<Real>>();
         auto tempMPO = vector<IQMatEls>();
-        partitionHTerms(am.sites(),am.terms(),qbs,tempMPO,checkqns);
+        partitionHTerms(am.sites(),terms,qbs,tempMPO,checkqns);
         auto finalMPO = vector<MPOPiece<Real>>();
         auto links = vector<Index>();
         compressMPO(am.sites(),qbs,tempMPO,finalMPO,links,isExpH,tau,args);
@@ -1461,7 +1805,7 @@ svdMPO(AutoMPO const& am,
         {
         auto qbs = vector<QNBlock<Cplx>>();
         auto tempMPO = vector<IQMatEls>();
-        partitionHTerms(am.sites(),am.terms(),qbs,tempMPO,checkqns);
+        partitionHTerms(am.sites(),terms,qbs,tempMPO,checkqns);
         auto finalMPO = vector<MPOPiece<Cplx>>();
         auto links = vector<Index>();
         compressMPO(am.sites(),qbs,tempMPO,finalMPO,links,isExpH,tau,args);
@@ -1498,10 +1842,89 @@ toMPO(AutoMPO const& am,
     return svdMPO(am,args);
     }
 
+//
+// Helpers for the W^II approximation of
+// Zaletel et al., PRB 91, 165112 (2015)
+//
+
+//Matrix of a single-site operator times z, M(i,j) = z <s'=i|Op|s=j>
+CMatrix
+siteOpMatrix(ITensor const& Op,
+             Index const& s,
+             Cplx z = 1.)
+    {
+    auto d = dim(s);
+    auto M = CMatrix(d,d);
+    for(auto i : range1(d))
+    for(auto j : range1(d))
+        {
+        M(i-1,j-1) = z*eltC(Op,prime(s)=i,dag(s)=j);
+        }
+    return M;
+    }
+
+//Single-site operator with matrix elements M,
+//or a default-constructed ITensor if M is zero
+ITensor
+siteOpTensor(CMatrix const& M,
+             Index const& s,
+             bool is_real)
+    {
+    auto Op = ITensor(dag(s),prime(s));
+    auto is_zero = true;
+    for(auto i : range1(dim(s)))
+    for(auto j : range1(dim(s)))
+        {
+        auto z = M(i-1,j-1);
+        if(std::abs(z) < 1E-15) continue;
+        is_zero = false;
+        if(is_real) Op.set(prime(s)=i,dag(s)=j,z.real());
+        else        Op.set(prime(s)=i,dag(s)=j,z);
+        }
+    if(is_zero) return ITensor();
+    return Op;
+    }
+
+//
+// Given an operator-valued, block lower-triangular
+// matrix X (blocks indexed by occupations of the 
+// auxiliary hard-core boson modes, diagonal blocks
+// all equal to xD) returns the block of exp(X)
+// connecting the empty state (block 0) to the 
+// fully occupied state (block nb-1)
+//
+CMatrix
+expLowerBlock(vector<vector<CMatrix const*>> const& X)
+    {
+    auto nb = X.size();
+    auto d = nrows(*X[0][0]);
+    auto M = CMatrix(nb*d,nb*d);
+    for(auto a : range(nb))
+    for(auto b : range(nb))
+        {
+        auto* blk = X[a][b];
+        if(not blk) continue;
+        for(auto i : range(d))
+        for(auto j : range(d))
+            {
+            M(a*d+i,b*d+j) = (*blk)(i,j);
+            }
+        }
+    auto E = expMatrix(M);
+    auto R = CMatrix(d,d);
+    for(auto i : range(d))
+    for(auto j : range(d))
+        {
+        R(i,j) = E((nb-1)*d+i,j);
+        }
+    return R;
+    }
+
 MPO
-toExpH_ZW1(AutoMPO const& am,
-           Complex tau,
-           Args const& args)
+toExpH_ZW(AutoMPO const& am,
+          Complex tau,
+          bool useWII,
+          Args const& args)
     {
     auto checkqns = args.getBool("CheckQN=",true);
     if(not hasQNs(am.sites()(1))) checkqns = false;
@@ -1509,10 +1932,12 @@ toExpH_ZW1(AutoMPO const& am,
     auto const& sites = am.sites();
     auto H = MPO(sites);
     const int N = length(sites);
+    auto ops = SiteOpCache(sites);
 
     const QN Zero;
+    auto terms = am.termRange();
 
-    for(auto& t : am.terms())
+    for(auto& t : terms)
     if(t.Nops() > 2) 
         {
         Error("Only at most 2-operator terms allowed for AutoMPO conversion to MPO/IQMPO");
@@ -1531,7 +1956,7 @@ toExpH_ZW1(AutoMPO const& am,
     //Fill up the basis array at each site with 
     //the unique operator types occurring on the site
     //and starting a string of operators (i.e. first op of an HTerm)
-    for(const auto& ht : am.terms())
+    for(const auto& ht : terms)
     for(int n = ht.first().i; n < ht.last().i; ++n)
         {
         auto& bn = basis.at(n);
@@ -1541,8 +1966,7 @@ toExpH_ZW1(AutoMPO const& am,
             {
             if(checkqns)
                 {
-                auto Op = op(sites,ht.first().op,ht.first().i);
-                bn.emplace_back(ht.first(),-div(Op));
+                bn.emplace_back(ht.first(),ops.qn(ht.first()));
                 }
             else
                 {
@@ -1604,12 +2028,15 @@ toExpH_ZW1(AutoMPO const& am,
     //all HTerms (operator strings) which begin on,
     //end on, or cross site "j"
     vector<vector<HTerm>> ht_by_n(N+1);
-    for(const HTerm& ht : am.terms()) 
+    for(const HTerm& ht : terms) 
     for(const auto& st : ht.ops)
         {
         ht_by_n.at(st.i).push_back(ht);
         }
 
+    auto is_real = (tau.imag() == 0.);
+    for(auto& t : terms) if(t.coef.imag() != 0.) is_real = false;
+
     for(int n = 1; n <= N; n++)
         {
         auto& bn1 = basis.at(n-1);
@@ -1621,6 +2048,102 @@ toExpH_ZW1(AutoMPO const& am,
 
         W = ITensor(dag(sites(n)),prime(sites(n)),dag(row),col);
 
+        if(useWII)
+            {
+            //
+            // Write the W matrix of H at site n in block form
+            //     | 1  C |        
+            // W = | B  A |  (plus on-site terms D in the 
+            //                upper-left corner)
+            // Then, with x = -tau, W^II(r,c) is the coefficient of
+            // phi_r phibar_c in exp(x D + B_r phi_r + x C_c phibar_c 
+            //                       + A_rc phi_r phibar_c)
+            // with phi_r^2 = phibar_c^2 = 0. These "hard-core boson"
+            // modes are represented by 2 or 4 dimensional 
+            // block matrices passed to expLowerBlock.
+            //
+            auto s = sites(n);
+            auto d = dim(s);
+            auto x = -tau;
+            auto Z = CMatrix(d,d);
+            auto xD = CMatrix(d,d);
+            auto xC = vector<CMatrix>(dim(col));
+            auto B = vector<CMatrix>(dim(row));
+            auto Id = siteOpMatrix(ops.op(OpId,n),s);
+            auto F = siteOpMatrix(ops.op(OpF,n),s);
+
+            for(const auto& ht : ht_by_n.at(n))
+                {
+                if(ht.first().i == ht.last().i)
+                    {
+                    xD += siteOpMatrix(ops.op(ht.first()),s,x*ht.coef);
+                    }
+                }
+            for(int c = 0; c < dim(col); ++c)
+                {
+                auto& cst = bn.at(c).st;
+                if(cst.i != n) continue;
+                xC.at(c) = siteOpMatrix(ops.op(startTerm(cst.op),n),s,x);
+                }
+            for(int r = 0; r < dim(row); ++r)
+                {
+                auto& rst = bn1.at(r).st;
+                if(rst == IL) continue;
+                for(const auto& ht : ht_by_n.at(n))
+                if(rst == ht.first() && ht.last().i == n)
+                    {
+                    auto E = siteOpMatrix(ops.op(endTerm(ht.last().op),n),s,ht.coef);
+                    if(B.at(r).size() == 0) B.at(r) = E;
+                    else                    B.at(r) += E;
+                    }
+                }
+
+            for(int r = 0; r < dim(row); ++r)
+            for(int c = 0; c < dim(col); ++c)
+                {
+                auto& rst = bn1.at(r).st;
+                auto& cst = bn.at(c).st;
+                auto hasB = (B.at(r).size() != 0);
+                auto hasC = (xC.at(c).size() != 0);
+                CMatrix const* A = nullptr;
+                if(cst == rst && rst != IL) A = isFermionic(cst) ? &F : &Id;
+
+                CMatrix Wrc;
+                if(rst == IL && cst == IL)
+                    {
+                    Wrc = expMatrix(xD);
+                    }
+                else if(rst == IL)
+                    {
+                    if(not hasC) continue;
+                    Wrc = expLowerBlock({{&xD,nullptr},
+                                         {&xC.at(c),&xD}});
+                    }
+                else if(cst == IL)
+                    {
+                    if(not hasB) continue;
+                    Wrc = expLowerBlock({{&xD,nullptr},
+                                         {&B.at(r),&xD}});
+                    }
+                else
+                    {
+                    if(not A && not (hasB && hasC)) continue;
+                    //Blocks ordered as: empty, phi_r, phibar_c, both
+                    auto* Br = hasB ? &B.at(r) : nullptr;
+                    auto* Cc = hasC ? &xC.at(c) : nullptr;
+                    Wrc = expLowerBlock({{&xD,nullptr,nullptr,nullptr},
+                                         {Br,&xD,nullptr,nullptr},
+                                         {Cc,nullptr,&xD,nullptr},
+                                         {A,Cc,Br,&xD}});
+                    }
+                auto Op = siteOpTensor(Wrc,s,is_real);
+                if(not Op) continue; //all elements zero
+                auto rc = setElt(dag(row)(r+1)) * setElt(col(c+1));
+                W += Op * rc;
+                }
+            continue;
+            }
+
         for(int r = 0; r < dim(row); ++r)
         for(int c = 0; c < dim(col); ++c)
             {
@@ -1633,7 +2156,7 @@ toExpH_ZW1(AutoMPO const& am,
             if(cst.i == n && rst == IL)
                 {
                 auto opname = startTerm(cst.op);
-                auto op = convert_tensor(sites.op(opname,n)) * rc;
+                auto op = convert_tensor(ops.op(opname,n)) * rc;
                 op *= (-tau);
                 W += op;
                 }
@@ -1644,11 +2167,11 @@ toExpH_ZW1(AutoMPO const& am,
                 {
                 if(isFermionic(cst))
                     {
-                    W += convert_tensor(sites.op("F",n)) * rc;
+                    W += convert_tensor(ops.op(OpF,n)) * rc;
                     }
                 else
                     {
-                    W += convert_tensor(sites.op("Id",n)) * rc;
+                    W += convert_tensor(ops.op(OpId,n)) * rc;
                     }
                 }
 
@@ -1658,7 +2181,7 @@ toExpH_ZW1(AutoMPO const& am,
                 for(const auto& ht : ht_by_n.at(n))
                 if(rst == ht.first() && ht.last().i == n)
                     {
-                    W += ht.coef * convert_tensor(sites.op(endTerm(ht.last().op),n)) * rc;
+                    W += ht.coef * convert_tensor(ops.op(endTerm(ht.last().op),n)) * rc;
                     }
                 }
 
@@ -1668,7 +2191,7 @@ toExpH_ZW1(AutoMPO const& am,
                 for(const auto& ht : ht_by_n.at(n))
                 if(ht.first().i == ht.last().i)
                     {
-                    auto op = ht.coef * convert_tensor(sites.op(ht.first().op,n)) * rc;
+                    auto op = ht.coef * convert_tensor(ops.op(ht.first())) * rc;
                     op *= (-tau);
                     W += op;
                     }
@@ -1691,16 +2214,37 @@ toExpH(AutoMPO const& a,
        Args const& args)
     {
     auto approx = args.getString("Approx","ZW1");
-    MPO res;
-    if(approx == "ZW1")
-        {
-        res = toExpH_ZW1(a,tau,{args,"CheckQN",false});
-        }
-    else
+    auto order = args.getInt("Order",1);
+    if(approx != "ZW1" && approx != "WII")
         {
         Error(format("Unknown approximation Approx=\"%s\"",approx));
         }
-    return res;
+    auto useWII = (approx == "WII");
+    auto expH = [&a,useWII,&args](Cplx t)
+        {
+        return toExpH_ZW(a,t,useWII,{args,"CheckQN",false});
+        };
+
+    if(order == 1) return expH(tau);
+    if(order != 2) Error(format("toExpH: Order=%d not supported (use 1 or 2)",order));
+
+    //
+    // Second order scheme: exp(-tau H) = U(tau1) U(tau2) + O(tau^3)
+    // with tau1 + tau2 = tau and tau1^2 + tau2^2 = 0,
+    // which cancels the O(tau^2) error of U = W^I or W^II
+    //
+    auto tau1 = tau*Cplx(0.5,+0.5);
+    auto tau2 = tau*Cplx(0.5,-0.5);
+    auto U = nmultMPO(expH(tau1),prime(expH(tau2)),{args,"Cutoff",args.getReal("Cutoff",1E-14)});
+    U.mapPrime(2,1,"Site");
+    return U;
+    }
+
+std::ostream& 
+operator<<(std::ostream& s, OpName const& n)
+    {
+    s << n.str();
+    return s;
     }
 
 std::ostream& 
@@ -1731,7 +2275,7 @@ std::ostream&
 operator<<(std::ostream& s, const AutoMPO& a)
     {
     s << "AutoMPO:\n";
-    for(const auto& t : a.terms()) s << t << "\n";
+    for(const auto& t : a.termRange()) s << t << "\n";
     return s;
     }
 
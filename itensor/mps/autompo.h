@@ -18,7 +18,10 @@
 
 #include "itensor/global.h"
 #include "itensor/mps/mpo.h"
+#include <array>
+#include <iterator>
 #include <set>
+#include <vector>
 
 namespace itensor {
 
@@ -44,6 +47,16 @@ toMPO(AutoMPO const& a,
 // Arguments recognized:
 // o "Approx":
 //   - (Default) "ZW1" - Zaletel et al. "W1" approximation
+//   - "WII" - Zaletel et al. "WII" approximation, which also
+//     treats on-site terms and terms overlapping on a single
+//     site exactly. Has the same bond dimension as "ZW1" 
+//     and a smaller O(tau^2) error.
+// o "Order" (default 1):
+//   - 2: return the product U(tau1)*U(tau2), with
+//     tau1,2 = tau*(1 +/- i)/2, which cancels the O(tau^2) 
+//     error of the chosen approximation U. The product is 
+//     compressed with nmultMPO (using "Cutoff", "MaxDim").
+//     The result is complex even for real tau.
 //
 MPO
 toExpH(AutoMPO const& a,
@@ -52,14 +65,70 @@ toExpH(AutoMPO const& a,
 
 
 
+//
+// Interned operator name.
+// Every distinct name is stored once in a
+// global table so an OpName is the size of a
+// pointer and equality tests are pointer comparisons.
+// Converts implicitly to and from std::string.
+//
+class OpName
+    {
+    public:
+    //Entry of the global table
+    using Entry = std::string;
+    private:
+    Entry const* name_ = nullptr;
+    public:
+
+    OpName();
+
+    OpName(std::string const& name);
+
+    OpName(const char* name);
+
+    //From the table entry of a name, see entry()
+    explicit
+    OpName(Entry const* e) : name_(e) { }
+
+    std::string const&
+    str() const { return *name_; }
+
+    operator std::string const&() const { return *name_; }
+
+    //The entry stays valid for the lifetime of the program
+    Entry const*
+    entry() const { return name_; }
+
+    bool
+    empty() const { return name_->empty(); }
+
+    char
+    front() const { return name_->front(); }
+
+    bool
+    operator==(OpName const& o) const { return name_ == o.name_; }
+
+    bool
+    operator!=(OpName const& o) const { return name_ != o.name_; }
+
+    //Orders alphabetically, so term ordering
+    //does not depend on the order of interning
+    bool
+    operator<(OpName const& o) const { return name_ != o.name_ && *name_ < *o.name_; }
+
+    bool
+    operator>(OpName const& o) const { return o < *this; }
+    };
+
 struct SiteTerm
     {
-    std::string op;
+    OpName op;
     int i;
 
     SiteTerm();
 
-    SiteTerm(std::string const& op,
+    SiteTerm(OpName const& op,
              int i);
 
     bool
@@ -138,13 +207,53 @@ struct LessNoCoef
     operator()(HTerm const& t1, HTerm const& t2) const;
     };
 
+//
+// Compact form of an HTerm with up to max_ops
+// operators, in which AutoMPO stores its terms.
+// Operators are stored by their OpName::entry()
+// and the whole term needs no allocations.
+//
+struct PackedTerm
+    {
+    static constexpr int max_ops = 4;
+
+    Cplx coef = 0.;
+    //Operators in the order of the HTerm,
+    //followed by nullptr for unused slots
+    std::array<OpName::Entry const*,max_ops> op = {};
+    std::array<int,max_ops> site = {};
+
+    int
+    Nops() const;
+    };
+
+//Orders PackedTerms as LessNoCoef orders
+//the HTerms they are packed from
+struct LessPacked
+    {
+    bool
+    operator()(PackedTerm const& p1, PackedTerm const& p2) const;
+    };
+
 class AutoMPO
     {
     public:
     using storage = std::set<HTerm,LessNoCoef>;
+    class TermIter;
+    class TermRange;
     private:
     SiteSet sites_;
-    storage terms_;
+    //Terms of up to PackedTerm::max_ops operators,
+    //sorted with duplicates merged
+    std::vector<PackedTerm> packed_;
+    //Terms added since packed_ was last merged, also with
+    //duplicates merged. They are merged into packed_ in bulk
+    //once there are as many of them (see mergeAdded)
+    std::set<PackedTerm,LessPacked> added_;
+    //Number of terms in added_ which are also in packed_
+    size_t nshared_ = 0;
+    //Terms with more operators
+    storage long_terms_;
 
     enum State { New, Op };
 
@@ -200,11 +309,22 @@ class AutoMPO
     SiteSet const&
     sites() const { return sites_; }
 
-    storage const&
-    terms() const { return terms_; }
+    //Range over the terms with duplicates merged, in
+    //LessNoCoef order. Each term is unpacked from the compact
+    //storage as it is visited, so no copy of the terms is
+    //made. Adding terms invalidates the range.
+    TermRange
+    termRange() const;
+
+    //Copy of the terms as a set of HTerms; this uses
+    //much more memory than the terms themselves,
+    //so prefer termRange() to iterate over them
+    storage
+    terms() const;
 
+    //Number of distinct terms
     int
-    size() const { return terms_.size(); }
+    size() const;
 
     template <typename T>
     Accumulator
@@ -214,7 +334,15 @@ class AutoMPO
     add(HTerm const& t);
 
     void
-    reset() { terms_.clear(); }
+    add(HTerm && t);
+
+    //Add many terms at once: they are merged with
+    //each other and the existing terms in one sort pass
+    void
+    addTerms(std::vector<HTerm> const& terms);
+
+    void
+    reset();
 
     //Type conversion AutoMPO -> MPO
     //This is deprecated in favor of toMPO(AutoMPO)
@@ -224,8 +352,75 @@ class AutoMPO
         return toMPO(*this); 
         }
 
+    private:
+
+    void
+    mergeAdded();
+
+    void
+    mergePacked(size_t nmerged);
     };
 
+//Iterates over packed_ and added_ together, merging
+//equal terms, and then over long_terms_
+class AutoMPO::TermIter
+    {
+    public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = HTerm;
+    using difference_type = std::ptrdiff_t;
+    using pointer = HTerm const*;
+    using reference = HTerm const&;
+    private:
+    AutoMPO const* am_ = nullptr;
+    std::vector<PackedTerm>::const_iterator p_;
+    std::set<PackedTerm,LessPacked>::const_iterator a_;
+    storage::const_iterator l_;
+    HTerm t_;
+    public:
+
+    TermIter() { }
+
+    TermIter(AutoMPO const& am, bool end);
+
+    reference
+    operator*() const { return t_; }
+
+    pointer
+    operator->() const { return &t_; }
+
+    TermIter&
+    operator++();
+
+    bool
+    operator==(TermIter const& o) const { return p_ == o.p_ && a_ == o.a_ && l_ == o.l_; }
+
+    bool
+    operator!=(TermIter const& o) const { return !operator==(o); }
+
+    private:
+
+    void
+    unpackCurrent();
+    };
+
+class AutoMPO::TermRange
+    {
+    AutoMPO const* am_ = nullptr;
+    public:
+
+    TermRange(AutoMPO const& am) : am_(&am) { }
+
+    TermIter
+    begin() const { return TermIter(*am_,false); }
+
+    TermIter
+    end() const { return TermIter(*am_,true); }
+    };
+
+std::ostream& 
+operator<<(std::ostream& s, OpName const& n);
+
 std::ostream& 
 operator<<(std::ostream& s, SiteTerm const& t);
 
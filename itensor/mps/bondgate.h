@@ -18,6 +18,8 @@
 
 #include "itensor/itensor.h"
 #include "itensor/mps/siteset.h"
+#include <mutex>
+#include <unordered_map>
 
 namespace itensor {
 
@@ -68,6 +70,137 @@ class BondGate
     makeSwapGate(SiteSet const& sites);
     };
 
+//
+// Thread-safe cache of tReal/tImag gates keyed on the
+// bond, gate type, tau and a hash of bondH, so gate lists
+// can be rebuilt (e.g. when the time step changes) without
+// exponentiating the same bond Hamiltonian again.
+// Since tau must match exactly, gates are only reused
+// when step sizes recur; the cache is emptied once it
+// holds maxSize() gates, which bounds it when tau
+// varies continuously.
+//
+class GateCache
+    {
+    struct Key
+        {
+        int i1 = 0,
+            i2 = 0;
+        BondGate::Type type = BondGate::tReal;
+        Real tau = 0.;
+        size_t hhash = 0;
+
+        bool
+        operator==(Key const& o) const
+            {
+            return i1 == o.i1 && i2 == o.i2 && type == o.type 
+                && tau == o.tau && hhash == o.hhash;
+            }
+        };
+    struct KeyHash
+        {
+        size_t
+        operator()(Key const& k) const
+            {
+            auto h = std::hash<Real>()(k.tau);
+            for(size_t x : {size_t(k.i1),size_t(k.i2),size_t(k.type),k.hhash})
+                {
+                h ^= x + 0x9e3779b9 + (h << 6) + (h >> 2);
+                }
+            return h;
+            }
+        };
+    struct Entry
+        {
+        ITensor bondH;
+        BondGate gate;
+        };
+    mutable std::mutex mutex_;
+    std::unordered_multimap<Key,Entry,KeyHash> gates_;
+    size_t hits_ = 0;
+    public:
+
+    GateCache() { }
+
+    //Returns BondGate(sites,i1,i2,type,tau,bondH),
+    //constructing it only if not already cached
+    BondGate
+    get(SiteSet const& sites,
+        int i1,
+        int i2,
+        BondGate::Type type,
+        Real tau,
+        ITensor const& bondH);
+
+    void
+    clear()
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        gates_.clear();
+        hits_ = 0;
+        }
+
+    size_t
+    size() const
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return gates_.size();
+        }
+
+    size_t
+    hits() const
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return hits_;
+        }
+
+    static constexpr size_t
+    maxSize() { return 4096; }
+
+    private:
+
+    //Hash of the indices and the norm of T; entries
+    //with equal hashes are compared element by element
+    static size_t
+    hashTensor(ITensor const& T)
+        {
+        auto h = std::hash<Real>()(norm(T));
+        for(auto& i : inds(T))
+            {
+            h ^= std::hash<Index::id_type>()(id(i)) + size_t(primeLevel(i))
+                 + 0x9e3779b9 + (h << 6) + (h >> 2);
+            }
+        return h;
+        }
+    };
+
+//
+// Returns the list with gates acting on the same pair
+// of sites merged into a single gate whenever all gates
+// between them act on other sites (so they commute).
+// Each merge saves one gate application and SVD.
+//
+std::vector<BondGate>
+fuseGates(std::vector<BondGate> const& gates);
+
+//
+// Splits a time step for repeated application, fusing
+// trailing gates of one step with the matching leading
+// gates of the next (e.g. the half-steps of a second
+// order Trotter decomposition). Applying first, then
+// middle (n-1) times, then last is equivalent to
+// applying fuseGates(gates) n times.
+//
+struct FusedSteps
+    {
+    std::vector<BondGate> first,
+                          middle,
+                          last;
+    };
+
+FusedSteps
+fuseSteps(std::vector<BondGate> const& gates);
+
 ITensor inline
 operator*(BondGate const& G, ITensor T) { T *= G.gate(); return T; }
 
@@ -166,6 +299,147 @@ makeSwapGate(SiteSet const& sites)
     gate_ = a*b;
     }
 
+inline BondGate GateCache::
+get(SiteSet const& sites,
+    int i1,
+    int i2,
+    BondGate::Type type,
+    Real tau,
+    ITensor const& bondH)
+    {
+    auto key = Key{std::min(i1,i2),std::max(i1,i2),type,tau,hashTensor(bondH)};
+    auto matches = [&bondH](Entry const& e)
+        {
+        return hasSameInds(inds(e.bondH),inds(bondH)) && norm(e.bondH-bondH) == 0.;
+        };
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto range = gates_.equal_range(key);
+        for(auto it = range.first; it != range.second; ++it)
+            {
+            if(matches(it->second))
+                {
+                ++hits_;
+                return it->second.gate;
+                }
+            }
+        }
+    auto g = BondGate(sites,i1,i2,type,tau,bondH);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if(gates_.size() >= maxSize()) gates_.clear();
+    gates_.emplace(std::move(key),Entry{bondH,g});
+    return g;
+    }
+
+namespace detail {
+
+bool inline
+gatesOverlap(BondGate const& a, BondGate const& b)
+    {
+    return a.i1() == b.i1() || a.i1() == b.i2() 
+        || a.i2() == b.i1() || a.i2() == b.i2();
+    }
+
+bool inline
+sameSites(BondGate const& a, BondGate const& b)
+    {
+    return std::min(a.i1(),a.i2()) == std::min(b.i1(),b.i2())
+        && std::max(a.i1(),a.i2()) == std::max(b.i1(),b.i2());
+    }
+
+//Gate tensor applying A and then B,
+//both acting on the same site indices
+ITensor inline
+gateProduct(ITensor const& A, ITensor const& B)
+    {
+    auto C = A*prime(B);
+    C.mapPrime(2,1);
+    return C;
+    }
+
+//Gate applying a and then b
+BondGate inline
+gateProduct(BondGate const& a, BondGate const& b)
+    {
+    //The Custom gate constructor does not use the sites
+    return BondGate(SiteSet(),a.i1(),a.i2(),gateProduct(a.gate(),b.gate()));
+    }
+
+} //namespace detail
+
+inline std::vector<BondGate>
+fuseGates(std::vector<BondGate> const& gates)
+    {
+    auto res = std::vector<BondGate>();
+    res.reserve(gates.size());
+    for(auto& g : gates)
+        {
+        auto fused = false;
+        for(auto k = int(res.size())-1; k >= 0; --k)
+            {
+            if(detail::sameSites(res[k],g))
+                {
+                res[k] = detail::gateProduct(res[k],g);
+                fused = true;
+                break;
+                }
+            if(detail::gatesOverlap(res[k],g)) break;
+            }
+        if(not fused) res.push_back(g);
+        }
+    return res;
+    }
+
+inline FusedSteps
+fuseSteps(std::vector<BondGate> const& gates)
+    {
+    auto L = fuseGates(gates);
+    auto n = int(L.size());
+
+    //Gates which commute to the end (tail) 
+    //or the start (head) of the step
+    auto tail = std::vector<bool>(n,true),
+         head = std::vector<bool>(n,true);
+    for(auto k : range(n))
+    for(auto l : range(n))
+        {
+        if(l == k || not detail::gatesOverlap(L[k],L[l])) continue;
+        if(l > k) tail[k] = false;
+        if(l < k) head[k] = false;
+        }
+
+    //Pair each tail gate with a distinct head gate on the same sites
+    auto partner = std::vector<int>(n,-1);
+    auto is_head_partner = std::vector<bool>(n,false);
+    for(auto t : range(n))
+        {
+        if(not tail[t]) continue;
+        for(auto h : range(n))
+            {
+            if(h == t || not head[h] || is_head_partner[h]) continue;
+            if(not detail::sameSites(L[t],L[h])) continue;
+            partner[t] = h;
+            is_head_partner[h] = true;
+            break;
+            }
+        }
+
+    auto fs = FusedSteps();
+    for(auto t : range(n))
+        {
+        if(partner[t] < 0) continue;
+        fs.middle.push_back(detail::gateProduct(L[t],L[partner[t]]));
+        fs.last.push_back(L[t]);
+        }
+    for(auto k : range(n))
+        {
+        if(partner[k] >= 0) continue;
+        fs.first.push_back(L[k]);
+        if(not is_head_partner[k]) fs.middle.push_back(L[k]);
+        }
+    return fs;
+    }
+
 } //namespace itensor
 
 #endif
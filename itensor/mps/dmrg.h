@@ -44,6 +44,13 @@ DMRGWorker(MPS & psi,
 //
 // Available DMRG methods:
 //
+// Besides the Sweeps, the methods take named arguments
+// including "Quiet", "Silent" and "WriteDim". With
+// "PrintProfile" true and the profiler enabled (see
+// itensor/util/profiler.h), the profile is printed after
+// each sweep; it is cumulative, covering everything
+// recorded since the last profiler().reset().
+//
 
 //
 //DMRG with an MPO
@@ -378,6 +385,7 @@ DMRGWorker(MPS & psi,
     
     for(int sw = 1; sw <= sweeps.nsweep(); ++sw)
         {
+        PROFILE_START(psw,"dmrg sweep");
         cpu_time sw_time;
         args.add("Sweep",sw);
         args.add("NSweep",sweeps.nsweep());
@@ -408,21 +416,17 @@ DMRGWorker(MPS & psi,
                 printfln("Sweep=%d, HS=%d, Bond=%d/%d",sw,ha,b,(N-1));
                 }
 
-TIMER_START(1);
+            PROFILE_START(pp,"position");
             PH.position(b,psi);
-TIMER_STOP(1);
+            PROFILE_STOP(pp);
 
-TIMER_START(2);
             auto phi = psi(b)*psi(b+1);
-TIMER_STOP(2);
 
-TIMER_START(3);
             energy = davidson(PH,phi,args);
-TIMER_STOP(3);
             
-TIMER_START(4);
+            PROFILE_START(ps,"svdBond");
             auto spec = psi.svdBond(b,phi,(ha==1?Fromleft:Fromright),PH,args);
-TIMER_STOP(4);
+            PROFILE_STOP(ps);
 
             if(!quiet)
                 { 
@@ -445,16 +449,23 @@ TIMER_STOP(4);
             obs.measure(args);
 
             } //for loop over b
+        PROFILE_STOP(psw);
 
         if(!silent)
             {
             auto sm = sw_time.sincemark();
             printfln("    Sweep %d/%d CPU time = %s (Wall time = %s)",
                       sw,sweeps.nsweep(),showtime(sm.time),showtime(sm.wall));
-#ifdef COLLECT_TIMES
-            println(timers());
-            timers().reset();
-#endif
+            //Totals since the profiler was last reset,
+            //including the earlier sweeps
+            if(profiler().enabled() && args.getBool("PrintProfile",false))
+                {
+                println(profiler());
+                }
+            if(PH.doWrite() && spillCodec(args) == SpillCodec::LZ)
+                {
+                println(spillStats());
+                }
             }
 
         if(obs.checkDone(args)) break;
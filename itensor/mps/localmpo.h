@@ -234,6 +234,7 @@ class LocalMPO
 
     bool do_write_ = false;
     std::string writedir_ = "./";
+    SpillCodec write_codec_ = SpillCodec::None;
 
     const MPS* Psi_;
 
@@ -542,6 +543,7 @@ shift(int j,
 inline void LocalMPO::
 makeL(MPS const& psi, int k)
     {
+    PROFILE_REGION("environment update");
     if(!PH_.empty())
         {
         if(Op_ == 0) //Op is actually an MPS
@@ -578,6 +580,7 @@ makeL(MPS const& psi, int k)
 inline void LocalMPO::
 makeR(MPS const& psi, int k)
     {
+    PROFILE_REGION("environment update");
     if(!PH_.empty())
         {
         if(Op_ == 0) //Op is actually an MPS
@@ -628,7 +631,7 @@ setLHlim(int val)
 
     if(LHlim_ != val && PH_.at(LHlim_))
         {
-        writeToFile(PHFName(LHlim_),PH_.at(LHlim_));
+        writeSpill(PHFName(LHlim_),PH_.at(LHlim_),write_codec_);
         PH_.at(LHlim_) = ITensor();
         }
     LHlim_ = val;
@@ -641,7 +644,7 @@ setLHlim(int val)
     if(!PH_.at(LHlim_))
         {
         std::string fname = PHFName(LHlim_);
-        readFromFile(fname,PH_.at(LHlim_));
+        readSpill(fname,PH_.at(LHlim_));
         }
     }
 
@@ -656,7 +659,7 @@ setRHlim(int val)
 
     if(RHlim_ != val && PH_.at(RHlim_))
         {
-        writeToFile(PHFName(RHlim_),PH_.at(RHlim_));
+        writeSpill(PHFName(RHlim_),PH_.at(RHlim_),write_codec_);
         PH_.at(RHlim_) = ITensor();
         }
     RHlim_ = val;
@@ -669,7 +672,7 @@ setRHlim(int val)
     if(!PH_.at(RHlim_))
         {
         std::string fname = PHFName(RHlim_);
-        readFromFile(fname,PH_.at(RHlim_));
+        readSpill(fname,PH_.at(RHlim_));
         }
     }
 
@@ -678,6 +681,7 @@ initWrite(Args const& args)
     {
     auto basedir = args.getString("WriteDir","./");
     writedir_ = mkTempDir("PH",basedir);
+    write_codec_ = spillCodec(args);
     }
 
 } //namespace itensor
@@ -394,9 +394,12 @@ deltaRho(ITensor const& AA,
         drho *= (*Op2_);
         }
     drho.noPrime();
-    drho = combine * drho;
-    auto ci = commonIndex(combine,drho);
-    drho *= dag(prime(drho,ci));
+    //Contract before combining: the density matrix is
+    //smaller than drho (which also has the MPO link), so
+    //it is the one matricized, in one pass
+    auto cinds = commonInds(combine,drho);
+    drho *= dag(prime(drho,cinds));
+    drho = matricize(drho,combine,dag(prime(combine)));
 
     //Expedient to ensure drho is Hermitian
     drho = drho + dag(swapTags(drho,"0","1"));
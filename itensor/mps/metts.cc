@@ -0,0 +1,165 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <sstream>
+#include "itensor/mps/metts.h"
+
+namespace itensor {
+
+using std::vector;
+using std::string;
+
+//State n of site s in the basis direction
+ITensor static
+basisState(Index const& s,
+           int n,
+           string const& direction)
+    {
+    auto T = ITensor(s);
+    if(direction == "Z")
+        {
+        T.set(s=n,1.);
+        }
+    else if(direction == "X")
+        {
+        if(dim(s) != 2) Error("METTS: X basis requires sites of dimension 2");
+        T.set(s=1,1./std::sqrt(2.));
+        T.set(s=2,(n == 1 ? 1. : -1.)/std::sqrt(2.));
+        }
+    else
+        {
+        Error("METTS: Direction '" + direction + "' not recognized");
+        }
+    return T;
+    }
+
+MPS
+productMPS(SiteSet const& sites,
+           vector<int> const& states,
+           string const& direction)
+    {
+    if(hasQNs(sites)) Error("productMPS: METTS product states require sites without QNs");
+    auto N = length(sites);
+    auto psi = MPS(sites);
+    for(auto j : range1(N))
+        {
+        auto A = basisState(sites(j),states.at(j),direction);
+        if(j > 1) A *= setElt(linkIndex(psi,j-1)=1);
+        if(j < N) A *= setElt(linkIndex(psi,j)=1);
+        psi.set(j,A);
+        }
+    psi.position(1);
+    return psi;
+    }
+
+vector<int>
+collapse(MPS & psi,
+         std::mt19937_64 & rng,
+         Args const& args)
+    {
+    auto direction = args.getString("Direction","Z");
+    auto N = length(psi);
+    auto sites = siteInds(psi);
+    if(hasQNs(sites)) Error("collapse: METTS product states require sites without QNs");
+    auto states = vector<int>(N+1,0);
+    auto uniform = std::uniform_real_distribution<Real>(0.,1.);
+
+    psi.position(1);
+    auto C = psi(1);
+    for(auto j : range1(N))
+        {
+        auto s = sites(j);
+        C /= norm(C);
+        //Probabilities of the states of site j
+        //given the states of sites 1,...,j-1
+        auto r = uniform(rng);
+        auto P = ITensor();
+        auto n = 1;
+        for(; n <= dim(s); ++n)
+            {
+            P = dag(basisState(s,n,direction))*C;
+            r -= sqr(norm(P));
+            if(r <= 0.) break;
+            }
+        if(n > dim(s))
+            {
+            //Round-off left r slightly positive
+            n = dim(s);
+            }
+        states[j] = n;
+        if(j < N) C = P*psi(j+1);
+        }
+    auto sitesset = SiteSet(sites);
+    psi = productMPS(sitesset,states,direction);
+    return states;
+    }
+
+METTSChain::
+METTSChain(SiteSet const& sites,
+           std::seed_seq & seed)
+  : sites_(sites),
+    state_(length(sites)+1,0),
+    rng_(seed)
+    {
+    for(auto j : range1(length(sites)))
+        {
+        state_[j] = 1+int(rng_()%dim(sites(j)));
+        }
+    }
+
+MPS METTSChain::
+sample(std::function<void(MPS&)> const& evolve)
+    {
+    auto psi = productState();
+    evolve(psi);
+    psi.normalize();
+    ++step_;
+    return psi;
+    }
+
+void METTSChain::
+collapse(MPS & psi,
+         Args const& args)
+    {
+    auto alternate = args.getBool("Alternate",true);
+    auto direction = (alternate && step_%2 == 1) ? "X" : "Z";
+    state_ = itensor::collapse(psi,rng_,{args,"Direction=",direction});
+    direction_ = direction;
+    }
+
+void METTSChain::
+write(std::ostream& s) const
+    {
+    itensor::write(s,state_);
+    itensor::write(s,direction_);
+    itensor::write(s,step_);
+    auto r = std::ostringstream();
+    r << rng_;
+    itensor::write(s,r.str());
+    }
+
+void METTSChain::
+read(std::istream& s)
+    {
+    itensor::read(s,state_);
+    itensor::read(s,direction_);
+    itensor::read(s,step_);
+    auto str = string();
+    itensor::read(s,str);
+    auto r = std::istringstream(str);
+    r >> rng_;
+    }
+
+} //namespace itensor
@@ -0,0 +1,118 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_METTS_H
+#define __ITENSOR_METTS_H
+
+#include <functional>
+#include <random>
+#include "itensor/mps/mps.h"
+#include "itensor/util/stats.h"
+
+namespace itensor {
+
+//
+// Building blocks for sampling minimally entangled
+// typical thermal states (METTS), for site sets
+// without QN conservation.
+//
+// Product states are given by one integer per site
+// (1,...,dim) in a basis "Direction":
+//   "Z": the site basis
+//   "X": (|1> + |2>)/sqrt(2) and (|1> - |2>)/sqrt(2)
+//        (sites of dimension 2 only)
+//
+
+//Returns the product state MPS for states[j] (j = 1,...,N)
+MPS
+productMPS(SiteSet const& sites,
+           std::vector<int> const& states,
+           std::string const& direction = "Z");
+
+//
+// Samples a product state from |psi|^2 in the basis
+// given by the "Direction" argument, using rng, and
+// returns it (element j for site j, element 0 unused).
+// psi is left in the collapsed state.
+//
+std::vector<int>
+collapse(MPS & psi,
+         std::mt19937_64 & rng,
+         Args const& args = Args::global());
+
+//
+// A single METTS Markov chain: its current product
+// state and its own random number generator.
+//
+// Each step is
+//     auto psi = chain.sample(evolve); //METTS
+//     //...measure psi...
+//     chain.collapse(psi);             //next product state
+// where evolve(psi) should apply exp(-beta*H/2)
+// to psi. With "Alternate" (default true) collapses
+// alternate between the Z and X bases, which greatly
+// reduces autocorrelation for spin models.
+//
+class METTSChain
+    {
+    SiteSet sites_;
+    std::vector<int> state_;
+    std::string direction_ = "Z";
+    std::mt19937_64 rng_;
+    long step_ = 0;
+    public:
+
+    METTSChain() { }
+
+    //Starts from a random product state in the Z basis
+    METTSChain(SiteSet const& sites,
+               std::seed_seq & seed);
+
+    //Number of METTS sampled so far
+    long
+    step() const { return step_; }
+
+    std::vector<int> const&
+    state() const { return state_; }
+
+    std::string const&
+    direction() const { return direction_; }
+
+    //Current product state as an MPS
+    MPS
+    productState() const { return productMPS(sites_,state_,direction_); }
+
+    //Returns the normalized METTS made from
+    //the current product state
+    MPS
+    sample(std::function<void(MPS&)> const& evolve);
+
+    //Collapses psi into the next product state
+    void
+    collapse(MPS & psi,
+             Args const& args = Args::global());
+
+    //Checkpointing: writes and restores the chain
+    //state (the SiteSet is not written)
+    void
+    write(std::ostream& s) const;
+
+    void
+    read(std::istream& s);
+    };
+
+} //namespace itensor
+
+#endif
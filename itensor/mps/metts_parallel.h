@@ -0,0 +1,217 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_METTS_PARALLEL_H
+#define __ITENSOR_METTS_PARALLEL_H
+
+#include <cstdio>
+#include <exception>
+#include "itensor/mps/metts.h"
+#include "itensor/util/parallel.h"
+
+namespace itensor {
+
+//
+// METTS sampling with independent Markov chains
+// distributed over MPI nodes and, within a node,
+// over threads (if compiled with OpenMP).
+//
+// evolve(psi) should apply exp(-beta*H/2) to the product
+// state psi; measure(psi) returns the values of the
+// observables named in names for the METTS psi.
+// Both are called concurrently for different chains
+// when running with more than one thread.
+//
+// Returns the statistics of each observable combined
+// over all chains on all nodes (on every node).
+//
+// Arguments recognized:
+//   "Chains" (default 1): number of chains per node
+//   "NWarm" (default 5): METTS discarded at the start of each chain
+//   "NSamples" (default 100): METTS measured per chain
+//   "Seed" (default 1): seed of the random number generators;
+//        chain c on node r uses the seed sequence {Seed,r,c}
+//   "Alternate" (default true): alternate Z and X collapses
+//   "Checkpoint" (default ""): if not empty, the chains and their
+//        statistics are saved to files Checkpoint_<node> every
+//        "CheckpointEvery" (default 10) steps and sampling resumes
+//        from these files if they exist (all nodes must then
+//        resume from the same step)
+//   "ReportEvery" (default 10): print the running averages with
+//        error bars corrected for autocorrelation every
+//        ReportEvery steps (on node 0, unless "Quiet" is true)
+//
+std::vector<BinningStats>
+mettsSample(Environment const& env,
+            SiteSet const& sites,
+            std::function<void(MPS&)> const& evolve,
+            std::function<std::vector<Real>(MPS const&)> const& measure,
+            std::vector<std::string> const& names,
+            Args const& args = Args::global());
+
+//
+// Implementation
+//
+
+namespace detail {
+
+void inline
+writeMETTSCheckpoint(std::string const& fname,
+                     std::vector<METTSChain> const& chains,
+                     std::vector<std::vector<BinningStats>> const& stats)
+    {
+    //Write to a temporary file first so an interrupted
+    //write does not destroy the previous checkpoint
+    auto tmpname = fname + ".tmp";
+        {
+        std::ofstream s(tmpname.c_str(),std::ios::binary);
+        if(!s.good()) Error("mettsSample: couldn't open checkpoint file " + tmpname);
+        itensor::write(s,long(chains.size()));
+        for(auto& c : chains) c.write(s);
+        itensor::write(s,stats);
+        }
+    std::rename(tmpname.c_str(),fname.c_str());
+    }
+
+std::vector<BinningStats> inline
+combineMETTSStats(Environment const& env,
+                  std::vector<std::vector<BinningStats>> const& stats,
+                  size_t nobs)
+    {
+    auto total = std::vector<BinningStats>(nobs);
+    for(auto& cs : stats)
+    for(auto k : range(nobs))
+        {
+        total[k] += cs[k];
+        }
+    for(auto& t : total) t = allSum(env,t);
+    return total;
+    }
+
+} //namespace detail
+
+std::vector<BinningStats> inline
+mettsSample(Environment const& env,
+            SiteSet const& sites,
+            std::function<void(MPS&)> const& evolve,
+            std::function<std::vector<Real>(MPS const&)> const& measure,
+            std::vector<std::string> const& names,
+            Args const& args)
+    {
+    auto nchains = args.getInt("Chains",1);
+    auto nwarm = args.getInt("NWarm",5);
+    auto nsamples = args.getInt("NSamples",100);
+    auto seed = args.getInt("Seed",1);
+    auto checkpoint = args.getString("Checkpoint","");
+    auto checkpoint_every = args.getInt("CheckpointEvery",10);
+    auto report_every = args.getInt("ReportEvery",10);
+    auto quiet = args.getBool("Quiet",false);
+    auto nobs = names.size();
+
+    auto chains = std::vector<METTSChain>(nchains);
+    auto stats = std::vector<std::vector<BinningStats>>(nchains,std::vector<BinningStats>(nobs));
+    for(auto c : range(nchains))
+        {
+        std::seed_seq sseq{long(seed),long(env.rank()),long(c)};
+        chains[c] = METTSChain(sites,sseq);
+        }
+
+    auto ckname = format("%s_%d",checkpoint,env.rank());
+    if(checkpoint != "" && fileExists(ckname))
+        {
+        std::ifstream s(ckname.c_str(),std::ios::binary);
+        long nsaved = 0;
+        itensor::read(s,nsaved);
+        if(nsaved != nchains) Error("mettsSample: checkpoint has a different number of chains");
+        for(auto& c : chains) c.read(s);
+        itensor::read(s,stats);
+        if(!quiet && env.firstNode()) printfln("Resuming METTS sampling from checkpoint %s",checkpoint);
+        }
+
+    auto nsteps = nwarm+nsamples;
+    auto step = chains.front().step();
+    //Nodes resuming from different steps (a checkpoint
+    //missing or left behind by an earlier run) would call
+    //combineMETTSStats a different number of times
+    long step_range[2] = {0,0};
+    MPI_Allreduce(&step,&step_range[0],1,MPI_LONG,MPI_MIN,MPI_COMM_WORLD);
+    MPI_Allreduce(&step,&step_range[1],1,MPI_LONG,MPI_MAX,MPI_COMM_WORLD);
+    if(step_range[0] != step_range[1])
+        {
+        Error(format("mettsSample: checkpoints resume from steps %d to %d on different nodes",
+                     step_range[0],step_range[1]));
+        }
+    while(step < nsteps)
+        {
+        //Failures cannot leave the parallel region, so
+        //they are recorded per chain and raised after it
+        auto badsize = std::vector<char>(nchains,0);
+        auto failure = std::vector<std::exception_ptr>(nchains);
+#pragma omp parallel for schedule(dynamic)
+        for(int c = 0; c < nchains; ++c)
+            {
+            try
+                {
+                auto psi = chains[c].sample(evolve);
+                if(chains[c].step() > nwarm)
+                    {
+                    auto vals = measure(psi);
+                    if(vals.size() != nobs)
+                        {
+                        badsize[c] = 1;
+                        continue;
+                        }
+                    for(auto k : range(nobs)) stats[c][k].putin(vals[k]);
+                    }
+                chains[c].collapse(psi,args);
+                }
+            catch(...)
+                {
+                failure[c] = std::current_exception();
+                }
+            }
+        for(auto c : range(nchains))
+            {
+            if(failure[c]) std::rethrow_exception(failure[c]);
+            if(badsize[c]) Error("mettsSample: measure returned the wrong number of values");
+            }
+        ++step;
+
+        if(nobs > 0 && step > nwarm && (step%report_every == 0 || step == nsteps))
+            {
+            auto total = detail::combineMETTSStats(env,stats,nobs);
+            if(!quiet && env.firstNode())
+                {
+                printfln("METTS step %d/%d (%d samples)",step,nsteps,total.front().count());
+                for(auto k : range(nobs))
+                    {
+                    printfln("    %s = %.12f +- %.3E (tau = %.2f)",
+                             names[k],total[k].avg(),total[k].err(),total[k].tau());
+                    }
+                }
+            }
+
+        if(checkpoint != "" && (step%checkpoint_every == 0 || step == nsteps))
+            {
+            detail::writeMETTSCheckpoint(ckname,chains,stats);
+            }
+        }
+
+    return detail::combineMETTSStats(env,stats,nobs);
+    }
+
+} //namespace itensor
+
+#endif
@@ -966,7 +966,7 @@ overlapC(MPS const& psi,
 #ifdef ITENSOR_USE_HDF5
 
 void
-h5_write(h5::group parent, string const& name, MPO const& M)
+h5_write(h5::group parent, string const& name, MPO const& M, Args const& args)
     {
     auto g = parent.create_group(name);
     h5_write_attribute(g,"type","MPO",true);
@@ -976,7 +976,7 @@ h5_write(h5::group parent, string const& name, MPO const& M)
     h5_write(g,"llim",long(M.leftLim()));
     for(auto n : range1(M.length()))
         {
-        h5_write(g,format("MPO[%d]",n),M(n));
+        h5_write(g,format("MPO[%d]",n),M(n),args);
         }
     }
 
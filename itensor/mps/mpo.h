@@ -17,6 +17,7 @@
 #define __ITENSOR_MPO_H
 #include "itensor/mps/mps.h"
 #include "itensor/mps/sweeps.h"
+#include "itensor/mps/observer.h"
 
 
 namespace itensor {
@@ -547,6 +548,30 @@ applyExpH(MPS const& psi,
           MPS & res, 
           Args const& args = Args::global());
 
+//
+//Computes |res> = exp(-ttotal*H)|psi> by repeated calls to
+//applyExpH with an adaptive step, starting from tstep.
+//The error of each step is estimated by step doubling and
+//controlled by a StepControl (see stepcontrol.h) of order
+//"StepOrder" (default 1). This is not the Taylor order
+//"Order" passed to applyExpH: at the default Taylor order
+//the step error comes mostly from the MPO application and
+//truncation, which shrinks only slowly with the step.
+//Each step is normalized unless "Normalize" is false;
+//returns the product of the norms divided out.
+//Accepted steps are reported to obs.measure through the
+//arguments "Time", "TimeStep", "StepError", "NextTimeStep"
+//and "StepsRejected" (see TEvolObserver::steps()).
+//
+Real
+applyExpHAdaptive(MPS const& psi, 
+                  MPO const& H, 
+                  Real ttotal, 
+                  Real tstep, 
+                  MPS & res, 
+                  Observer & obs,
+                  Args args = Args::global());
+
 //Given an MPO with no Link indices between site operators,
 //put in links (of bond dimension 1).
 //In the QN conserving case ensure that links carry the proper QNs.
@@ -614,7 +639,8 @@ overlapC(MPS const& psi,
 
 #ifdef ITENSOR_USE_HDF5
 void
-h5_write(h5::group parent, std::string const& name, MPO const& M);
+h5_write(h5::group parent, std::string const& name, MPO const& M,
+         Args const& args = Args::global());
 void
 h5_read(h5::group parent, std::string const& name, MPO & M);
 #endif
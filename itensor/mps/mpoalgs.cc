@@ -16,6 +16,7 @@
 #include "itensor/util/print_macro.h"
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/localop.h"
+#include "itensor/mps/stepcontrol.h"
 
 namespace itensor {
 
@@ -593,6 +594,41 @@ applyExpH(MPS const& psi,
 
     }
 
+Real
+applyExpHAdaptive(MPS const& psi, 
+                  MPO const& H, 
+                  Real ttotal, 
+                  Real tstep, 
+                  MPS & res, 
+                  Observer & obs,
+                  Args args)
+    {
+    auto control = StepControl(args.getInt("StepOrder",1),args);
+    auto normalize = args.getBool("Normalize",true);
+
+    auto cur = psi;
+    Real tot_norm = 1.;
+    MPS two;
+    auto tryStep = [&](Real h)
+        {
+        auto one = cur;
+        applyExpH(cur,H,h,one,args);
+        auto half = cur;
+        applyExpH(cur,H,h/2,half,args);
+        two = half;
+        applyExpH(half,H,h/2,two,args);
+        return stepError(one,two);
+        };
+    auto acceptStep = [&]()
+        {
+        cur = std::move(two);
+        if(normalize) tot_norm *= cur.normalize();
+        };
+    control.evolve(ttotal,tstep,tryStep,acceptStep,obs,args);
+    res = cur;
+    return tot_norm;
+    }
+
 //
 // Deprecated
 //
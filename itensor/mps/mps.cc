@@ -125,7 +125,8 @@ MPS(MPS const& other)
     r_orth_lim_(other.r_orth_lim_),
     atb_(other.atb_),
     writedir_(other.writedir_),
-    do_write_(other.do_write_)
+    do_write_(other.do_write_),
+    write_codec_(other.write_codec_)
     { 
     copyWriteDir();
     }
@@ -140,6 +141,7 @@ operator=(MPS const& other)
     atb_ = other.atb_;
     writedir_ = other.writedir_;
     do_write_ = other.do_write_;
+    write_codec_ = other.write_codec_;
 
     copyWriteDir();
     return *this;
@@ -387,7 +389,7 @@ read(std::string const& dirname)
 
     for(auto j : range(A_.size()))
         {
-    	readFromFile(AFName(j,dirname),A_.at(j));
+    	readSpill(AFName(j,dirname),A_.at(j));
         }
     }
 
@@ -425,12 +427,12 @@ setBond(int b) const
         {
         if(A_.at(atb_))
             {
-            writeToFile(AFName(atb_),A_.at(atb_));
+            writeSpill(AFName(atb_),A_.at(atb_),write_codec_);
             A_.at(atb_) = ITensor();
             }
         if(A_.at(atb_+1))
             {
-            writeToFile(AFName(atb_+1),A_.at(atb_+1));
+            writeSpill(AFName(atb_+1),A_.at(atb_+1),write_codec_);
             if(atb_+1 != b) A_.at(atb_+1) = ITensor();
             }
         ++atb_;
@@ -439,12 +441,12 @@ setBond(int b) const
         {
         if(A_.at(atb_))
             {
-            writeToFile(AFName(atb_),A_.at(atb_));
+            writeSpill(AFName(atb_),A_.at(atb_),write_codec_);
             if(atb_ != b+1) A_.at(atb_) = ITensor();
             }
         if(A_.at(atb_+1))
             {
-            writeToFile(AFName(atb_+1),A_.at(atb_+1));
+            writeSpill(AFName(atb_+1),A_.at(atb_+1),write_codec_);
             A_.at(atb_+1) = ITensor();
             }
         --atb_;
@@ -456,12 +458,12 @@ setBond(int b) const
     //
     if(!A_.at(b))
         {
-        readFromFile(AFName(b),A_.at(b));
+        readSpill(AFName(b),A_.at(b));
         }
 
     if(!A_.at(b+1))
         {
-        readFromFile(AFName(b+1),A_.at(b+1));
+        readSpill(AFName(b+1),A_.at(b+1));
         }
 
     //if(b == 1)
@@ -622,6 +624,58 @@ svdBond(int b, ITensor const& AA, Direction dir, Args args)
     return svdBond(b,AA,dir,LocalOp(),args);
     }
 
+//If the indices of A other than "bond" and the
+//site indices acting with "gate" are larger than
+//the rest of A, factor A = X*R with X an isometry
+//on those indices. Replaces A by R and returns X,
+//otherwise returns a default-constructed ITensor.
+ITensor static
+splitOuterLinks(ITensor & A,
+                Index const& bond,
+                ITensor const& gate)
+    {
+    auto outer = std::vector<Index>();
+    long dout = 1,
+         din = 1;
+    for(auto& i : inds(A))
+        {
+        if(i == bond || hasIndex(gate,i))
+            {
+            din *= dim(i);
+            }
+        else
+            {
+            outer.push_back(i);
+            dout *= dim(i);
+            }
+        }
+    if(outer.empty() || dout <= din) return ITensor();
+    ITensor X,R;
+    std::tie(X,R) = qr(A,IndexSet(outer));
+    A = R;
+    return X;
+    }
+
+Spectrum MPS::
+applyGate(int b, ITensor const& gate, Direction dir, Args args)
+    {
+    setBond(b);
+    ITensor X1,X2;
+    if(args.getBool("ReducedUpdate",false))
+        {
+        auto bnd = commonIndex(A_[b],A_[b+1]);
+        X1 = splitOuterLinks(A_[b],bnd,gate);
+        X2 = splitOuterLinks(A_[b+1],bnd,gate);
+        }
+    auto AA = A_[b]*A_[b+1]*gate;
+    if(args.getBool("NoPrime",false)) AA.noPrime();
+    else                              AA.replaceTags("Site,1","Site,0");
+    auto spec = svdBond(b,AA,dir,args);
+    if(X1) A_[b] *= X1;
+    if(X2) A_[b+1] *= X2;
+    return spec;
+    }
+
 struct SqrtInv
     {
     Real
@@ -892,6 +946,11 @@ applyGate(ITensor const& gate,
     {
     auto fromleft = args.getBool("Fromleft",true);
     const int c = orthoCenter(psi);
+    if(args.getBool("ReducedUpdate",false))
+        {
+        psi.applyGate(c,gate,fromleft ? Fromleft : Fromright,{args,"NoPrime",true});
+        return;
+        }
     ITensor AA = psi(c) * psi(c+1) * gate;
     AA.noPrime();
     if(fromleft) psi.svdBond(c,AA,Fromleft,args);
@@ -905,12 +964,13 @@ initWrite(Args const& args)
         {
         std::string write_dir_parent = args.getString("WriteDir","./");
         writedir_ = mkTempDir("psi",write_dir_parent);
+        write_codec_ = spillCodec(args);
 
         //Write all null tensors to disk immediately because
         //later logic assumes null means written to disk
         for(size_t j = 0; j < A_.size(); ++j)
             {
-            if(!A_.at(j)) writeToFile(AFName(j),A_.at(j));
+            if(!A_.at(j)) writeSpill(AFName(j),A_.at(j),write_codec_);
             }
 
         if(args.getBool("WriteAll",false))
@@ -918,7 +978,7 @@ initWrite(Args const& args)
             for(int j = 0; j < int(A_.size()); ++j)
                 {
                 if(!A_.at(j)) continue;
-                writeToFile(AFName(j),A_.at(j));
+                writeSpill(AFName(j),A_.at(j),write_codec_);
                 if(j < atb_ || j > atb_+1)
                     {
                     A_[j] = ITensor{};
@@ -967,6 +1027,7 @@ swap(MPS& other)
     std::swap(atb_,other.atb_);
     std::swap(writedir_,other.writedir_);
     std::swap(do_write_,other.do_write_);
+    std::swap(write_codec_,other.write_codec_);
     }
 
 InitState::
@@ -1593,10 +1654,34 @@ overlap(MPSType const& psi, MPSType const& phi) //Re[<psi|phi>]
 template Real overlap<MPS>(MPS const& psi, MPS const& phi);
 template Real overlap<MPO>(MPO const& psi, MPO const& phi);
 
+void
+writeTensorFile(string const& fname, MPS const& M)
+    {
+    auto N = length(M);
+    auto Ts = vector<ITensor>(N);
+    for(auto n : range1(N)) Ts[n-1] = M(n);
+    writeTensorFile(fname,Ts,"MPS",{long(N),long(M.leftLim()),long(M.rightLim())});
+    }
+
+void
+readTensorFile(string const& fname, MPS & M)
+    {
+    TensorFile F(fname);
+    if(F.kind() != "MPS" || F.meta().size() != 3)
+        {
+        Error("TensorFile does not contain MPS data");
+        }
+    auto N = F.meta()[0];
+    M = MPS(N);
+    for(auto n : range1(N)) M.ref(n) = F.read(n-1);
+    M.leftLim(F.meta()[1]);
+    M.rightLim(F.meta()[2]);
+    }
+
 #ifdef ITENSOR_USE_HDF5
 
 void
-h5_write(h5::group parent, string const& name, MPS const& M)
+h5_write(h5::group parent, string const& name, MPS const& M, Args const& args)
     {
     auto g = parent.create_group(name);
     h5_write_attribute(g,"type","MPS",true);
@@ -1606,7 +1691,7 @@ h5_write(h5::group parent, string const& name, MPS const& M)
     h5_write(g,"llim",long(M.leftLim()));
     for(auto n : range1(M.length()))
         {
-        h5_write(g,format("MPS[%d]",n),M(n));
+        h5_write(g,format("MPS[%d]",n),M(n),args);
         }
     }
 
@@ -1628,6 +1713,17 @@ h5_read(h5::group parent, string const& name, MPS & M)
     M.rightLim(rlim);
     }
 
+ITensor
+h5_read_site(h5::group parent, string const& name, int j)
+    {
+    auto g = parent.open_group(name);
+    auto type = h5_read_attribute<string>(g,"type");
+    if(type != "MPS") Error("Group does not contain MPS data in HDF5 file");
+    auto N = h5_read<long>(g,"length");
+    if(j < 1 || j > N) Error(format("h5_read_site: site %d out of range",j));
+    return h5_read<ITensor>(g,format("MPS[%d]",j));
+    }
+
 #endif //ITENSOR_USE_HDF5
 
 } //namespace itensor
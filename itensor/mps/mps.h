@@ -17,6 +17,7 @@
 #define __ITENSOR_MPS_H
 #include "itensor/decomp.h"
 #include "itensor/mps/siteset.h"
+#include "itensor/tensorfile.h"
 
 namespace itensor {
 
@@ -35,6 +36,7 @@ class MPS
     int atb_;
     std::string writedir_;
     bool do_write_;
+    SpillCodec write_codec_ = SpillCodec::None;
     public:
 
     //
@@ -384,6 +386,25 @@ class MPS
             LocalOpT const& PH, 
             Args args = Args::global());
 
+    //Applies the two-site gate (acting on the site
+    //indices of bond b, outputs primed) and restores MPS
+    //form as svdBond(b,A_[b]*A_[b+1]*gate,dir) would,
+    //after taking the "Site,1" indices back to "Site,0".
+    //With Args("NoPrime",true) all primed indices are instead
+    //taken back to prime level 0, as the free applyGate does.
+    //With Args("ReducedUpdate",true) the links of A_[b]
+    //and A_[b+1] not touched by the gate are first split
+    //off by a QR decomposition whenever that shrinks the
+    //tensors being decomposed. This only pays off when those
+    //links are larger than d times the bond dimension (after
+    //a hard truncation, or for tensors with extra legs);
+    //bulk tensors of a canonical MPS are never split.
+    Spectrum
+    applyGate(int b,
+              ITensor const& gate,
+              Direction dir,
+              Args args = Args::global());
+
     //Move the orthogonality center to site i 
     //(leftLim() == i-1, rightLim() == i+1, orthoCenter() == i)
     MPS& 
@@ -798,6 +819,9 @@ maxLinkDim(MPSType const& x);
 //
 // Does not normalize the resulting wavefunction unless 
 // Args("DoNormalize",true) is included in args.
+// With Args("ReducedUpdate",true) the gate is applied
+// by MPS::applyGate(b,gate,dir,args) (see above), still
+// unpriming all indices of the result with noPrime.
 void 
 applyGate(ITensor const& gate, 
           MPS & x,
@@ -905,11 +929,29 @@ overlap(MPSType const& psi,
 Spectrum
 orthMPS(ITensor& A1, ITensor& A2, Direction dir, Args const& args);
 
+//
+// Write or read an MPS in the memory-mapped
+// TensorFile format (see itensor/tensorfile.h).
+// TensorFile(fname).read(j-1) loads site j only.
+//
+void
+writeTensorFile(std::string const& fname, MPS const& M);
+
+void
+readTensorFile(std::string const& fname, MPS & M);
+
 #ifdef ITENSOR_USE_HDF5
+//Each site is written as a separate ITensor,
+//compressed according to args (see h5_compression)
 void
-h5_write(h5::group parent, std::string const& name, MPS const& M);
+h5_write(h5::group parent, std::string const& name, MPS const& M,
+         Args const& args = Args::global());
 void
 h5_read(h5::group parent, std::string const& name, MPS & M);
+
+//Reads only tensor j of an MPS written by h5_write
+ITensor
+h5_read_site(h5::group parent, std::string const& name, int j);
 #endif
 
 } //namespace itensor
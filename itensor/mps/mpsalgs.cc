@@ -16,6 +16,7 @@
 #include "itensor/mps/mps.h"
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/localop.h"
+#include "itensor/mps/stepcontrol.h"
 #include "itensor/util/print_macro.h"
 #include "itensor/tensor/slicemat.h"
 
@@ -138,6 +139,52 @@ addAssumeOrth(MPSType      & L,
 template MPS& addAssumeOrth<MPS>(MPS & L,MPS const& R, Args const& args);
 template MPO& addAssumeOrth<MPO>(MPO & L,MPO const& R, Args const& args);
 
+Real
+stepError(MPS a, MPS b)
+    {
+    auto N = length(a);
+    if(length(b) != N) Error("stepError: mismatched MPS sizes");
+    auto nb = std::sqrt(real(innerC(b,b)));
+    if(nb == 0.) Error("stepError: reference MPS is zero");
+    if(N == 1) return norm(a(1)-b(1))/nb;
+    //The QN flux is carried by the orthogonality center,
+    //which must be on the same site for a and b
+    if(hasQNs(a))
+        {
+        a.position(1);
+        b.position(1);
+        }
+
+    //Site tensors of a-b are block diagonal in the
+    //direct sums of the links of a and b (with the sign
+    //on the first site). Sweeping through them with SVDs
+    //(no truncation) leaves the norm of a-b in the last
+    //tensor.
+    auto first = vector<ITensor>(N);
+    auto second = vector<ITensor>(N);
+    for(auto i : range1(N-1))
+        {
+        auto r = linkIndex(a,i);
+        plussers(linkIndex(a,i),linkIndex(b,i),r,first[i],second[i]);
+        }
+    auto T = a(1)*first[1] - b(1)*second[1];
+    for(auto i : range1(2,N))
+        {
+        auto U = ITensor(uniqueInds(T,{first[i-1]}));
+        ITensor S,V;
+        svd(T,U,S,V,{"Cutoff=",0.});
+        auto A = dag(first[i-1]) * a(i);
+        auto B = dag(second[i-1]) * b(i);
+        if(i < N)
+            {
+            A *= first[i];
+            B *= second[i];
+            }
+        T = S*V*(A+B);
+        }
+    return norm(T)/nb;
+    }
+
 void 
 fitWF(MPS const& psi_basis, MPS & psi_to_fit)
     {
@@ -0,0 +1,210 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "itensor/mps/mpsreader.h"
+
+namespace itensor {
+
+using std::vector;
+using std::string;
+
+MPSReader::
+MPSReader(string const& fname)
+    {
+    auto F = std::make_shared<TensorFile>(fname);
+    if(F->kind() != "MPS" || F->meta().size() != 3)
+        {
+        Error("MPSReader: TensorFile does not contain MPS data");
+        }
+    N_ = F->meta()[0];
+    llim_ = F->meta()[1];
+    rlim_ = F->meta()[2];
+    load_ = [F](int j) { return F->read(j-1); };
+    }
+
+#ifdef ITENSOR_USE_HDF5
+
+MPSReader::
+MPSReader(h5::group parent,
+          string const& name)
+    {
+    auto g = parent.open_group(name);
+    auto type = h5_read_attribute<string>(g,"type");
+    if(type != "MPS") Error("MPSReader: group does not contain MPS data in HDF5 file");
+    N_ = h5_read<long>(g,"length");
+    llim_ = h5_read<long>(g,"llim");
+    rlim_ = h5_read<long>(g,"rlim");
+    load_ = [g](int j) { return h5_read<ITensor>(g,format("MPS[%d]",j)); };
+    }
+
+#endif
+
+ITensor MPSReader::
+operator()(int j) const
+    {
+    if(j < 1 || j > N_) Error(format("MPSReader: site %d out of range",j));
+    return load_(j);
+    }
+
+namespace detail {
+
+//Moves the orthogonality center across psi calling
+//f(j,C) for the center C at every site j and
+//g(b,R) for the R factor of the QR decomposition
+//moving the center across bond b
+void
+sweepFromCenter(MPSReader const& psi,
+                std::function<void(int,ITensor const&)> const& f,
+                std::function<void(int,ITensor const&,Index const&)> const& g)
+    {
+    auto N = length(psi);
+    auto c = psi.orthoCenter();
+    if(c == 0) Error("MPSReader: stored MPS has no orthogonality center");
+
+    auto C = psi(c);
+    if(f) f(c,C);
+    for(auto j = c-1; j >= 1; --j)
+        {
+        auto A = psi(j);
+        auto [Q,R] = qr(C,uniqueInds(inds(C),inds(A)));
+        if(g) g(j,R,commonIndex(Q,R));
+        C = A*R;
+        if(f) f(j,C);
+        }
+
+    if(c == N) return;
+    C = psi(c);
+    for(auto j = c+1; j <= N; ++j)
+        {
+        auto A = psi(j);
+        auto [Q,R] = qr(C,uniqueInds(inds(C),inds(A)));
+        if(g) g(j-1,R,commonIndex(Q,R));
+        C = R*A;
+        if(f) f(j,C);
+        }
+    }
+
+} //namespace detail
+
+void
+centerSweep(MPSReader const& psi,
+            std::function<void(int,ITensor const&)> const& f)
+    {
+    detail::sweepFromCenter(psi,f,nullptr);
+    }
+
+Cplx
+innerC(MPSReader const& psi,
+       MPSReader const& phi)
+    {
+    auto N = length(psi);
+    if(length(phi) != N) Error("innerC: mismatched MPS lengths");
+    auto L = ITensor(1.);
+    for(auto j : range1(N))
+        {
+        L = (L*dag(prime(psi(j),"Link")))*phi(j);
+        }
+    return eltC(L);
+    }
+
+Real
+inner(MPSReader const& psi,
+      MPSReader const& phi)
+    {
+    auto z = innerC(psi,phi);
+    if(std::fabs(z.imag()) > 1E-12*std::fabs(z.real()))
+        {
+        printfln("Real inner: WARNING, dropping non-zero imaginary part (=%.5E) of overlap.",z.imag());
+        }
+    return z.real();
+    }
+
+Cplx
+innerC(MPSReader const& psi,
+       MPO const& H,
+       MPSReader const& phi)
+    {
+    auto N = length(psi);
+    if(length(phi) != N || length(H) != N) Error("innerC: mismatched MPS/MPO lengths");
+    auto L = ITensor(1.);
+    for(auto j : range1(N))
+        {
+        L = ((L*dag(prime(psi(j))))*H(j))*phi(j);
+        }
+    return eltC(L);
+    }
+
+Real
+inner(MPSReader const& psi,
+      MPO const& H,
+      MPSReader const& phi)
+    {
+    auto z = innerC(psi,H,phi);
+    if(std::fabs(z.imag()) > 1E-12*std::fabs(z.real()))
+        {
+        printfln("Real inner: WARNING, dropping non-zero imaginary part (=%.5E) of expectation value.",z.imag());
+        }
+    return z.real();
+    }
+
+vector<Cplx>
+expectC(MPSReader const& psi,
+        SiteSet const& sites,
+        string const& opname)
+    {
+    auto ex = vector<Cplx>(length(psi));
+    centerSweep(psi,[&](int j, ITensor const& C)
+        {
+        auto Cd = dag(prime(C,sites(j)));
+        ex[j-1] = eltC(Cd*op(sites,opname,j)*C)/eltC(dag(C)*C);
+        });
+    return ex;
+    }
+
+vector<Real>
+expect(MPSReader const& psi,
+       SiteSet const& sites,
+       string const& opname)
+    {
+    auto exC = expectC(psi,sites,opname);
+    auto ex = vector<Real>(exC.size());
+    for(auto n : range(ex)) ex[n] = exC[n].real();
+    return ex;
+    }
+
+vector<Real>
+entanglementEntropies(MPSReader const& psi)
+    {
+    auto S = vector<Real>(std::max(length(psi)-1,0));
+    //R carries the singular values of bond b
+    detail::sweepFromCenter(psi,nullptr,[&S](int b, ITensor const& R, Index const& q)
+        {
+        auto [U,D,V] = svd(R,{q});
+        auto u = commonIndex(U,D);
+        auto norm2 = 0.;
+        auto ent = 0.;
+        for(auto n : range1(dim(u)))
+            {
+            auto p = sqr(elt(D,n,n));
+            norm2 += p;
+            if(p > 1E-16) ent -= p*std::log(p);
+            }
+        //Correct for an unnormalized psi
+        S[b-1] = ent/norm2+std::log(norm2);
+        });
+    return S;
+    }
+
+} //namespace itensor
@@ -0,0 +1,141 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_MPSREADER_H
+#define __ITENSOR_MPSREADER_H
+
+#include <functional>
+#include "itensor/mps/mpo.h"
+#include "itensor/tensorfile.h"
+
+namespace itensor {
+
+//
+// Read-only access to an MPS stored on disk which
+// loads a single site tensor on each call, so that
+// measurements can run with only a few site tensors
+// in memory at a time.
+//
+// The MPS can be stored either
+//  - in a TensorFile, written by writeTensorFile(fname,psi)
+//    or one site at a time by a TensorFileWriter closed
+//    with close("MPS",{N,leftLim,rightLim}), or
+//  - in an HDF5 group written by h5_write(parent,name,psi).
+//
+class MPSReader
+    {
+    int N_ = 0;
+    int llim_ = 0,
+        rlim_ = 1;
+    std::function<ITensor(int)> load_;
+    public:
+
+    MPSReader() { }
+
+    explicit
+    MPSReader(std::string const& fname);
+
+#ifdef ITENSOR_USE_HDF5
+    MPSReader(h5::group parent,
+              std::string const& name);
+#endif
+
+    explicit operator bool() const { return N_ > 0; }
+
+    int
+    length() const { return N_; }
+
+    int
+    leftLim() const { return llim_; }
+
+    int
+    rightLim() const { return rlim_; }
+
+    //Orthogonality center of the stored MPS,
+    //0 if it does not have a single center
+    int
+    orthoCenter() const { return (llim_+2 == rlim_) ? llim_+1 : 0; }
+
+    //Reads the tensor of site j (1 <= j <= length())
+    ITensor
+    operator()(int j) const;
+    };
+
+int inline
+length(MPSReader const& psi) { return psi.length(); }
+
+//
+// Calls f(j,C) for every site j, where C is the
+// orthogonality center tensor of psi at site j,
+// obtained by QR decompositions moving away from
+// the stored orthogonality center. Site j and the
+// current center are the only tensors in memory.
+// Sites are visited from the stored center down to 1
+// and then from the center + 1 up to N.
+//
+void
+centerSweep(MPSReader const& psi,
+            std::function<void(int,ITensor const&)> const& f);
+
+//
+// <psi|phi>, loading one site of each at a time
+//
+Cplx
+innerC(MPSReader const& psi,
+       MPSReader const& phi);
+
+Real
+inner(MPSReader const& psi,
+      MPSReader const& phi);
+
+//
+// <psi|H|phi> for an MPO H held in memory
+//
+Cplx
+innerC(MPSReader const& psi,
+       MPO const& H,
+       MPSReader const& phi);
+
+Real
+inner(MPSReader const& psi,
+      MPO const& H,
+      MPSReader const& phi);
+
+//
+// Expectation values <psi|op_j|psi>/<psi|psi> of the
+// site operator opname at every site j
+// (psi must have an orthogonality center)
+//
+std::vector<Cplx>
+expectC(MPSReader const& psi,
+        SiteSet const& sites,
+        std::string const& opname);
+
+std::vector<Real>
+expect(MPSReader const& psi,
+       SiteSet const& sites,
+       std::string const& opname);
+
+//
+// Von Neumann entanglement entropy of every bond
+// b = 1,...,N-1 (element b-1 of the result)
+// (psi must have an orthogonality center)
+//
+std::vector<Real>
+entanglementEntropies(MPSReader const& psi);
+
+} //namespace itensor
+
+#endif
@@ -15,6 +15,8 @@
 //
 #ifndef __ITENSOR_SITESET_H
 #define __ITENSOR_SITESET_H
+#include <mutex>
+#include <unordered_map>
 #include "itensor/itensor.h"
 #include "itensor/util/str.h"
 
@@ -124,6 +126,12 @@ class SiteSet
     void
     init(SiteStore && sites);
 
+    //Construct the operator "opname" without
+    //consulting the operator cache
+    ITensor
+    makeOp(String const& opname, int i,
+           Args const& args) const;
+
     template<typename SiteType>
     void
     readType(std::istream & s);
@@ -214,12 +222,96 @@ class GenericSite
     };
 
 
+//
+// Thread-safe memo of operators returned by SiteSet::op,
+// keyed on the site Index id, the operator name and
+// the Args passed to op (compared exactly, via Args::key).
+// ITensor storage is copy-on-write, so a cache hit
+// hands back a tensor sharing the cached data.
+// The cache is emptied once it holds maxSize() operators,
+// which bounds it when op is called with continuously
+// varying Real args (such as time steps).
+//
+class OpCache
+    {
+    struct Key
+        {
+        Index::id_type id = 0;
+        std::string opname;
+        std::string args;
+
+        bool
+        operator==(Key const& o) const
+            {
+            return id == o.id && opname == o.opname && args == o.args;
+            }
+        };
+    struct KeyHash
+        {
+        size_t
+        operator()(Key const& k) const
+            {
+            auto h = std::hash<Index::id_type>()(k.id);
+            h ^= std::hash<std::string>()(k.opname) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<std::string>()(k.args) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+            }
+        };
+    mutable std::mutex mutex_;
+    std::unordered_map<Key,ITensor,KeyHash> ops_;
+    public:
+
+    OpCache() { }
+
+    //Returns the cached operator for (s,opname,args), 
+    //or calls make() to construct and cache it.
+    //The lock is not held while calling make() so 
+    //that make() may itself call back into the cache
+    //(as happens for products of operators "A*B").
+    template<typename MakeOp>
+    ITensor
+    get(Index const& s,
+        std::string const& opname,
+        Args const& args,
+        MakeOp && make)
+        {
+        auto key = Key{id(s),opname,args.key()};
+            {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = ops_.find(key);
+            if(it != ops_.end()) return it->second;
+            }
+        auto Op = make();
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(ops_.size() >= maxSize()) ops_.clear();
+        return ops_.emplace(std::move(key),std::move(Op)).first->second;
+        }
+
+    static constexpr size_t
+    maxSize() { return 4096; }
+
+    void
+    clear()
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ops_.clear();
+        }
+
+    size_t
+    size() const
+        {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ops_.size();
+        }
+    };
+
 struct SiteStore
     {
     using sptr = std::unique_ptr<SiteBase>;
     using storage = std::vector<sptr>;
     private:
     storage sites_;
+    std::unique_ptr<OpCache> opcache_ = std::make_unique<OpCache>();
     public:
 
     SiteStore() { }
@@ -231,8 +323,12 @@ struct SiteStore
     set(int i, SiteType && s) 
         {
         sites_.at(i) = sptr(new SiteHolder<SiteType>(std::move(s)));
+        opcache_->clear();
         }
 
+    OpCache &
+    opCache() const { return *opcache_; }
+
     int
     length() const { return sites_.empty() ? 0 : sites_.size()-1ul; }
 
@@ -365,6 +461,15 @@ op(String const& opname,
    Args const& args) const
     { 
     if(not *this) Error("Cannot call .op(..) on default-initialized SiteSet");
+    auto make = [this,&opname,i,&args]() { return this->makeOp(opname,i,args); };
+    return sites_->opCache().get(si(i),opname,args,make);
+    }
+
+ITensor inline SiteSet::
+makeOp(String const& opname, 
+       int i, 
+       Args const& args) const
+    { 
     if(opname == "Id")
         {
         auto s = si(i);
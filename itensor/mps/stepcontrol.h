@@ -0,0 +1,180 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_STEPCONTROL_H
+#define __ITENSOR_STEPCONTROL_H
+
+#include "itensor/mps/mps.h"
+#include "itensor/mps/observer.h"
+
+namespace itensor {
+
+//
+// Time-step controller for adaptive time evolution.
+//
+// The local error err of a step tau of a method of
+// order p is estimated by step doubling (one step tau
+// compared with two steps tau/2). The step is accepted
+// if err <= "ErrorGoal" and the next step is
+//
+//   tau * "StepSafety" * ("ErrorGoal"/err)^(1/(p+1))
+//
+// limited to a change by a factor between 1/"MaxShrink"
+// and "MaxGrow" and to the range ["MinStep","MaxStep"].
+// Steps of size "MinStep" are always accepted.
+// A step rejected more than "MaxRejections" times
+// (default 30) is an error: this happens when "ErrorGoal"
+// is below what the truncated evolution can reach.
+//
+// evolve runs the accept/reject loop over a time ttotal.
+// tryStep(h) must compute the step h and its step doubling
+// error from the current state, and keep the result;
+// acceptStep() makes the kept result the current state.
+// Each accepted step is reported to obs.measure with the
+// arguments "TimeStepNum", "Time", "TotalTime", "TimeStep",
+// "StepError", "NextTimeStep" and "StepsRejected".
+// Returns the number of accepted steps.
+//
+class StepControl
+    {
+    Real goal_ = 1E-6,
+         safety_ = 0.9,
+         min_step_ = 0.,
+         max_step_ = 0.,
+         max_grow_ = 4.,
+         max_shrink_ = 10.;
+    int order_ = 2,
+        max_reject_ = 30;
+    public:
+
+    StepControl(int order,
+                Args const& args = Args::global())
+      : goal_(args.getReal("ErrorGoal",1E-6)),
+        safety_(args.getReal("StepSafety",0.9)),
+        min_step_(args.getReal("MinStep",0.)),
+        max_step_(args.getReal("MaxStep",0.)),
+        max_grow_(args.getReal("MaxGrow",4.)),
+        max_shrink_(args.getReal("MaxShrink",10.)),
+        order_(order),
+        max_reject_(args.getInt("MaxRejections",30))
+        {
+        if(goal_ <= 0.) Error("StepControl: ErrorGoal must be positive");
+        }
+
+    Real
+    errorGoal() const { return goal_; }
+
+    bool
+    accept(Real tau, Real err) const
+        {
+        return err <= goal_ || tau <= min_step_;
+        }
+
+    //Call after the rejected-th rejection of a step,
+    //with tau the step to be tried next
+    void
+    checkRejected(int rejected, Real tau, Real err) const
+        {
+        if(rejected > max_reject_ || !(tau > 0.))
+            {
+            Error(format("StepControl: step rejected %d times, down to %.3E (error %.2E with ErrorGoal %.2E)",
+                         rejected,tau,err,goal_));
+            }
+        }
+
+    Real
+    next(Real tau, Real err) const
+        {
+        auto fac = max_grow_;
+        if(err > 0.) fac = safety_*std::pow(goal_/err,1./(order_+1));
+        fac = std::min(max_grow_,std::max(1./max_shrink_,fac));
+        auto ntau = tau*fac;
+        if(max_step_ > 0.) ntau = std::min(ntau,max_step_);
+        return std::max(ntau,min_step_);
+        }
+
+    template<typename TryStep, typename AcceptStep>
+    int
+    evolve(Real ttotal,
+           Real tstep,
+           TryStep&& tryStep,
+           AcceptStep&& acceptStep,
+           Observer& obs,
+           Args& args) const;
+    };
+
+template<typename TryStep, typename AcceptStep>
+int StepControl::
+evolve(Real ttotal,
+       Real tstep,
+       TryStep&& tryStep,
+       AcceptStep&& acceptStep,
+       Observer& obs,
+       Args& args) const
+    {
+    if(!(tstep > 0.)) Error("StepControl: initial time step must be positive");
+    const bool verbose = args.getBool("Verbose",false);
+
+    Real tsofar = 0;
+    Real tau = tstep;
+    auto nstep = 0;
+    while(ttotal-tsofar > 1E-12*ttotal)
+        {
+        auto h = std::min(tau,ttotal-tsofar);
+        auto rejected = 0;
+        while(true)
+            {
+            Real err = tryStep(h);
+            tau = next(h,err);
+            if(accept(h,err))
+                {
+                acceptStep();
+                tsofar += h;
+                ++nstep;
+                args.add("TimeStepNum",nstep);
+                args.add("Time",tsofar);
+                args.add("TotalTime",ttotal);
+                args.add("TimeStep",h);
+                args.add("StepError",err);
+                args.add("NextTimeStep",tau);
+                args.add("StepsRejected",rejected);
+                break;
+                }
+            ++rejected;
+            if(verbose) printfln("Rejected step %.3E at t=%.5f (error %.2E)",h,tsofar,err);
+            checkRejected(rejected,tau,err);
+            h = tau;
+            }
+        obs.measure(args);
+        if(obs.checkDone(args)) break;
+        }
+    if(verbose) 
+        {
+        printfln("\nTotal time evolved = %.5f in %d steps\n",tsofar,nstep);
+        }
+    return nstep;
+    }
+
+//
+// Relative distance || a - b || / || b ||, computed
+// from a-b itself so that it stays accurate when a and
+// b are close (unlike from the overlaps of a and b)
+//
+Real
+stepError(MPS a, MPS b);
+
+} //namespace itensor
+
+#endif
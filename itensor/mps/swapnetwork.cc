@@ -0,0 +1,180 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "itensor/mps/swapnetwork.h"
+#include "itensor/util/print_macro.h"
+
+namespace itensor {
+
+using std::vector;
+
+namespace {
+
+//A swap or gate acting on sites b, b+1.
+//Gate tensors are expressed in terms of
+//the site indices of b and b+1.
+struct RouteOp
+    {
+    int b = 0;
+    bool swap = false;
+    ITensor G;
+    };
+
+} //namespace
+
+ITensor static
+moveGateSite(ITensor G, Index const& from, Index const& to)
+    {
+    if(from == to) return G;
+    if(dim(from) != dim(to))
+        {
+        Error("swapNetwork: cannot route a gate between sites of different dimension");
+        }
+    G.replaceInds({from,prime(from)},{to,prime(to)});
+    return G;
+    }
+
+vector<BondGate>
+swapNetwork(SiteSet const& sites,
+            vector<BondGate> const& gates,
+            SwapNetworkStats & stats)
+    {
+    stats = SwapNetworkStats();
+    auto N = length(sites);
+
+    auto ops = vector<RouteOp>();
+    auto pushSwap = [&ops,&stats](int b)
+        {
+        if(not ops.empty() && ops.back().swap && ops.back().b == b)
+            {
+            ops.pop_back();
+            stats.cancelled_swaps += 2;
+            return;
+            }
+        auto o = RouteOp();
+        o.b = b;
+        o.swap = true;
+        ops.push_back(o);
+        };
+    //Number of leading swaps of "bonds" which
+    //would cancel against the end of ops
+    auto nCancel = [&ops](vector<int> const& bonds)
+        {
+        auto n = 0;
+        auto k = int(ops.size())-1;
+        for(auto b : bonds)
+            {
+            if(k < 0 || not ops[k].swap || ops[k].b != b) break;
+            ++n;
+            --k;
+            }
+        return n;
+        };
+
+    for(auto& g : gates)
+        {
+        auto i = std::min(g.i1(),g.i2());
+        auto j = std::max(g.i1(),g.i2());
+        if(i < 1 || j > N || i == j)
+            {
+            Error(format("swapNetwork: invalid gate sites %d,%d",g.i1(),g.i2()));
+            }
+        //Swap gates do not carry the exchange sign of fermions
+        for(auto n = i; j > i+1 && n <= j; ++n)
+            {
+            if(isFermionic(sites(n)))
+                {
+                Error(format("swapNetwork: cannot route a gate across fermionic site %d",n));
+                }
+            }
+        stats.ngates += 1;
+        stats.naive_swaps += 2*(j-i-1);
+        stats.naive_svds += 1+2*(j-i-1);
+
+        //Either move the state of i right to j-1,
+        //or the state of j left to i+1
+        auto right = vector<int>(),
+             left = vector<int>();
+        for(auto b = i; b <= j-2; ++b) right.push_back(b);
+        for(auto b = j-1; b >= i+1; --b) left.push_back(b);
+        auto move_right = (nCancel(right) >= nCancel(left));
+
+        auto& path = move_right ? right : left;
+        for(auto b : path) pushSwap(b);
+
+        auto o = RouteOp();
+        if(move_right)
+            {
+            o.b = j-1;
+            o.G = moveGateSite(g.gate(),sites(i),sites(j-1));
+            }
+        else
+            {
+            o.b = i;
+            o.G = moveGateSite(g.gate(),sites(j),sites(i+1));
+            }
+        ops.push_back(o);
+
+        for(auto n = int(path.size())-1; n >= 0; --n) pushSwap(path[n]);
+        }
+
+    //Fuse remaining swaps into gates on the same bond
+    auto fused = vector<RouteOp>();
+    for(auto& o : ops)
+        {
+        if(not fused.empty() && fused.back().b == o.b
+           && (fused.back().swap != o.swap || not o.swap))
+            {
+            auto& p = fused.back();
+            auto S = BondGate(sites,o.b,o.b+1).gate();
+            auto A = p.swap ? S : p.G;
+            auto B = o.swap ? S : o.G;
+            if(p.swap || o.swap) stats.fused_swaps += 1;
+            p.G = detail::gateProduct(A,B);
+            p.swap = false;
+            continue;
+            }
+        fused.push_back(o);
+        }
+
+    auto res = vector<BondGate>();
+    res.reserve(fused.size());
+    for(auto& o : fused)
+        {
+        if(o.swap) res.emplace_back(sites,o.b,o.b+1);
+        else       res.emplace_back(sites,o.b,o.b+1,o.G);
+        }
+    stats.svds = res.size();
+    return res;
+    }
+
+vector<BondGate>
+swapNetwork(SiteSet const& sites,
+            vector<BondGate> const& gates)
+    {
+    auto stats = SwapNetworkStats();
+    return swapNetwork(sites,gates,stats);
+    }
+
+std::ostream&
+operator<<(std::ostream& s, SwapNetworkStats const& st)
+    {
+    s << format("gates = %d, swaps = %d (naive %d, cancelled %d, fused %d), SVDs = %d (naive %d, saved %d)",
+                st.ngates,st.naive_swaps-st.cancelled_swaps-st.fused_swaps,st.naive_swaps,
+                st.cancelled_swaps,st.fused_swaps,st.svds,st.naive_svds,st.svdsSaved());
+    return s;
+    }
+
+} //namespace itensor
@@ -0,0 +1,70 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_SWAPNETWORK_H
+#define __ITENSOR_SWAPNETWORK_H
+
+#include "itensor/mps/bondgate.h"
+
+namespace itensor {
+
+struct SwapNetworkStats
+    {
+    int ngates = 0;          //input gates
+    int naive_swaps = 0;     //swaps of the unoptimized network
+    int cancelled_swaps = 0; //swaps removed as canceling pairs
+    int fused_swaps = 0;     //swaps merged into a neighboring gate
+    int naive_svds = 0;      //gate applications of the unoptimized network
+    int svds = 0;            //gate applications of the compiled network
+
+    int
+    svdsSaved() const { return naive_svds-svds; }
+    };
+
+//
+// Compiles a list of two-site gates acting on arbitrary
+// sites (i,j) into an equivalent list of nearest-neighbor
+// gates which can be passed to gateTEvol.
+//
+// Each long-range gate is routed by swapping the state
+// of one of its sites next to the other, applying the
+// gate and swapping back. The direction is chosen to
+// cancel as many swaps as possible against the end of
+// the previous gate's network, canceling pairs of equal
+// swaps are removed, and remaining swaps are fused with
+// a gate on the same bond so they share one SVD.
+//
+// Site indices of the routed sites must have the same
+// dimension (and QNs). Swaps are bosonic, so gates may
+// only be routed across sites without fermionic QNs;
+// fermionic sites without QNs (e.g. Electron with
+// ConserveQNs=false) cannot be detected and give wrong
+// results.
+//
+std::vector<BondGate>
+swapNetwork(SiteSet const& sites,
+            std::vector<BondGate> const& gates,
+            SwapNetworkStats & stats);
+
+std::vector<BondGate>
+swapNetwork(SiteSet const& sites,
+            std::vector<BondGate> const& gates);
+
+std::ostream&
+operator<<(std::ostream& s, SwapNetworkStats const& st);
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,236 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <exception>
+#include "itensor/mps/tebd.h"
+#include "itensor/util/print_macro.h"
+
+namespace itensor {
+
+using std::vector;
+
+Args static
+vidalBondTags(int b, Args const& args)
+    {
+    return {args,"LeftTags=",format("Link,u,l=%d",b),
+                 "RightTags=",format("Link,l=%d",b)};
+    }
+
+VidalMPS::
+VidalMPS(MPS psi,
+         Args const& args)
+  : N_(itensor::length(psi)),
+    sites_(N_+1),
+    B_(N_+1),
+    L_(N_+1)
+    {
+    if(N_ < 1) Error("VidalMPS: MPS is default constructed");
+    psi.position(1);
+    for(auto j : range1(N_)) sites_[j] = itensor::siteIndex(psi,j);
+
+    //Bt is right-orthogonal with its left link in
+    //the Schmidt basis of the previous bond and
+    //C = Lambda_{b-1}*Bt is the orthogonality center
+    auto Bt = psi(1);
+    auto C = Bt;
+    for(auto b : range1(N_-1))
+        {
+        auto l = commonIndex(psi(b),psi(b+1));
+        ITensor U,D,V;
+        std::tie(U,D,V) = svd(C,uniqueInds(inds(C),IndexSet(l)),vidalBondTags(b,args));
+        B_[b] = Bt*dag(V);
+        L_[b] = D;
+        Bt = V*psi(b+1);
+        C = D*Bt;
+        }
+    B_[N_] = Bt;
+    }
+
+ITensor VidalMPS::
+Gamma(int j,
+      Args const& args) const
+    {
+    if(j == N_) return B_.at(j);
+    auto cutoff = args.getReal("Cutoff",1E-14);
+    auto Linv = apply(L_.at(j),[cutoff](Real x)
+                      { return (std::fabs(x) > cutoff) ? 1./x : 0.; });
+    return B_.at(j)*dag(Linv);
+    }
+
+Real VidalMPS::
+applyGate(int b,
+          ITensor const& gate,
+          Args const& args)
+    {
+    if(b < 1 || b >= N_) Error(format("VidalMPS::applyGate: bond %d out of range",b));
+
+    auto phi = B_[b]*B_[b+1]*gate;
+    phi.mapPrime(1,0);
+    auto theta = (b > 1) ? L_[b-1]*phi : phi;
+
+    auto uis = IndexSet(sites_[b]);
+    if(b > 1) uis = IndexSet(commonIndex(L_[b-1],theta),sites_[b]);
+
+    ITensor U,D,V;
+    std::tie(U,D,V) = svd(theta,uis,vidalBondTags(b,args));
+
+    auto nrm = norm(D);
+    if(args.getBool("Normalize",true) && nrm > 0.)
+        {
+        D /= nrm;
+        phi /= nrm;
+        }
+    B_[b] = phi*dag(V);
+    B_[b+1] = V;
+    L_[b] = D;
+    return nrm;
+    }
+
+MPS VidalMPS::
+toMPS() const
+    {
+    auto psi = MPS(N_);
+    for(auto j : range1(N_)) psi.ref(j) = B_[j];
+    //The B_j are only approximately right-orthogonal
+    //after non-unitary gates, so restore the gauge
+    psi.leftLim(0);
+    psi.rightLim(N_+1);
+    psi.position(1);
+    return psi;
+    }
+
+vector<GateLayer>
+gateLayers(vector<BondGate> const& gates)
+    {
+    auto layers = vector<GateLayer>();
+    auto used = vector<int>();
+    for(auto& g : gates)
+        {
+        if(g.i2() != g.i1()+1)
+            {
+            Error(format("gateLayers: gate on sites %d,%d is not nearest-neighbor",g.i1(),g.i2()));
+            }
+        auto overlaps = layers.empty();
+        for(auto s : used) if(s == g.i1() || s == g.i2()) overlaps = true;
+        if(overlaps)
+            {
+            layers.emplace_back();
+            used.clear();
+            }
+        layers.back().push_back(g);
+        used.push_back(g.i1());
+        used.push_back(g.i2());
+        }
+    return layers;
+    }
+
+Real
+applyLayer(GateLayer const& layer,
+           VidalMPS & psi,
+           Args const& args)
+    {
+    auto used = vector<bool>(psi.length()+1,false);
+    for(auto& g : layer)
+        {
+        if(g.i2() != g.i1()+1 || used.at(g.i1()) || used.at(g.i2()))
+            {
+            Error("applyLayer: gates of a layer must act on non-overlapping nearest-neighbor bonds");
+            }
+        used[g.i1()] = true;
+        used[g.i2()] = true;
+        }
+
+    auto nrms = vector<Real>(layer.size(),1.);
+    auto ng = int(layer.size());
+    //Exceptions cannot leave the parallel region, so
+    //each gate records its own and they are rethrown after
+    auto failure = vector<std::exception_ptr>(layer.size());
+#pragma omp parallel for schedule(dynamic)
+    for(int n = 0; n < ng; ++n)
+        {
+        try
+            {
+            nrms[n] = psi.applyGate(layer[n].i1(),layer[n].gate(),args);
+            }
+        catch(...)
+            {
+            failure[n] = std::current_exception();
+            }
+        }
+    for(auto& f : failure) if(f) std::rethrow_exception(f);
+
+    auto tot = 1.;
+    for(auto x : nrms) tot *= x;
+    return tot;
+    }
+
+Real
+tebd(vector<GateLayer> const& layers,
+     Real ttotal,
+     Real tstep,
+     VidalMPS & psi,
+     Observer & obs,
+     Args args)
+    {
+    auto verbose = args.getBool("Verbose",false);
+
+    auto nt = int(ttotal/tstep+(1e-9*(ttotal/tstep)));
+    if(std::fabs(nt*tstep-ttotal) > 1E-9)
+        {
+        Error("Timestep not commensurate with total time");
+        }
+
+    if(verbose)
+        {
+        printfln("Taking %d steps of timestep %.5f, total time %.5f",nt,tstep,ttotal);
+        }
+
+    Real tot_norm = 1.;
+    Real tsofar = 0;
+    for(auto tt : range1(nt))
+        {
+        for(auto& layer : layers)
+            {
+            tot_norm *= applyLayer(layer,psi,args);
+            }
+
+        tsofar += tstep;
+
+        args.add("TimeStepNum",tt);
+        args.add("Time",tsofar);
+        args.add("TotalTime",ttotal);
+        obs.measure(args);
+        if(obs.checkDone(args)) break;
+        }
+    if(verbose)
+        {
+        printfln("\nTotal time evolved = %.5f\n",tsofar);
+        }
+
+    return tot_norm;
+    }
+
+Real
+tebd(vector<GateLayer> const& layers,
+     Real ttotal,
+     Real tstep,
+     VidalMPS & psi,
+     Args const& args)
+    {
+    TEvolObserver obs(args);
+    return tebd(layers,ttotal,tstep,psi,obs,args);
+    }
+
+} //namespace itensor
@@ -0,0 +1,140 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_TEBD_H
+#define __ITENSOR_TEBD_H
+
+#include "itensor/mps/mps.h"
+#include "itensor/mps/bondgate.h"
+#include "itensor/mps/TEvolObserver.h"
+
+namespace itensor {
+
+//
+// MPS in the Vidal canonical form
+//
+// psi = Gamma_1 Lambda_1 Gamma_2 Lambda_2 ... Lambda_{N-1} Gamma_N
+//
+// The right-canonical tensors B_j = Gamma_j Lambda_j
+// are stored together with the diagonal Lambda_b, so
+// two-site gates can be applied without dividing by
+// small singular values (Hastings' update).
+//
+// Applying a gate to bond b only reads Lambda_{b-1}
+// and writes B_b, B_{b+1} and Lambda_b, so gates acting
+// on non-overlapping bonds may be applied concurrently.
+//
+class VidalMPS
+    {
+    int N_ = 0;
+    std::vector<Index> sites_;
+    std::vector<ITensor> B_;
+    std::vector<ITensor> L_;
+    public:
+
+    VidalMPS() { }
+
+    //Brings psi into Vidal form by a left-to-right
+    //sweep of SVDs (truncated according to args)
+    explicit
+    VidalMPS(MPS psi,
+             Args const& args = Args::global());
+
+    explicit operator bool() const { return N_ > 0; }
+
+    int
+    length() const { return N_; }
+
+    Index const&
+    siteIndex(int j) const { return sites_.at(j); }
+
+    //B_j = Gamma_j * Lambda_j
+    ITensor const&
+    B(int j) const { return B_.at(j); }
+
+    //Singular values on bond b (between sites b and b+1)
+    ITensor const&
+    Lambda(int b) const { return L_.at(b); }
+
+    //Gamma_j = B_j * Lambda_j^{-1}, singular values
+    //smaller than "Cutoff" (default 1E-14) are dropped
+    ITensor
+    Gamma(int j, Args const& args = Args::global()) const;
+
+    //Applies a two-site gate to bond b (sites b, b+1),
+    //truncating according to "Cutoff", "MaxDim" etc.
+    //If "Normalize" is true (default) Lambda_b is
+    //normalized; returns the norm of Lambda_b
+    //before normalization.
+    Real
+    applyGate(int b,
+              ITensor const& gate,
+              Args const& args = Args::global());
+
+    //Converts to an MPS with orthogonality center 1
+    MPS
+    toMPS() const;
+    };
+
+using GateLayer = std::vector<BondGate>;
+
+//
+// Splits a gate list into layers of consecutive
+// gates acting on non-overlapping nearest-neighbor
+// bonds. Applying the layers in order is equivalent
+// to applying the gates in order.
+//
+std::vector<GateLayer>
+gateLayers(std::vector<BondGate> const& gates);
+
+//
+// Applies every gate of the layer to psi. If ITensor
+// is compiled with ITENSOR_USE_OMP the gates are
+// applied concurrently. Returns the product of the
+// norms returned by VidalMPS::applyGate.
+//
+Real
+applyLayer(GateLayer const& layer,
+           VidalMPS & psi,
+           Args const& args = Args::global());
+
+//
+// Evolves psi by an amount ttotal in steps of tstep,
+// each step applying the gate layers in order.
+// Gates within a layer are applied in parallel.
+//
+// Arguments recognized:
+//    "Verbose": if true, print useful information to stdout
+//    "Normalize": (default true) normalize after each gate
+//    "Cutoff", "MaxDim": truncation of each gate's SVD
+//
+Real
+tebd(std::vector<GateLayer> const& layers,
+     Real ttotal,
+     Real tstep,
+     VidalMPS & psi,
+     Observer & obs,
+     Args args = Args::global());
+
+Real
+tebd(std::vector<GateLayer> const& layers,
+     Real ttotal,
+     Real tstep,
+     VidalMPS & psi,
+     Args const& args = Args::global());
+
+} //namespace itensor
+
+#endif
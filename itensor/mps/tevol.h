@@ -19,6 +19,7 @@
 #include "itensor/mps/mpo.h"
 #include "itensor/mps/bondgate.h"
 #include "itensor/mps/TEvolObserver.h"
+#include "itensor/mps/stepcontrol.h"
 
 namespace itensor {
 
@@ -29,6 +30,13 @@ namespace itensor {
 //
 // Arguments recognized:
 //    "Verbose": if true, print useful information to stdout
+//    "ReducedUpdate": (default false) apply each gate to the
+//                     QR-reduced site tensors (see MPS::applyGate)
+//    "FuseSteps": (default false) merge gates on the same sites
+//                 within a step, and the trailing gates of each
+//                 step with the leading gates of the next (see
+//                 fuseSteps). Between steps psi then lacks the
+//                 deferred trailing gates; the final psi is exact.
 //
 template <class Iterable>
 Real
@@ -47,6 +55,43 @@ gateTEvol(Iterable const& gatelist,
           Observer& obs,
           Args args = Args::global());
 
+//
+// Evolves an MPS by an amount ttotal with an adaptive
+// time step, starting from tstep. makeGates(tau) must
+// return the gate list for one step of size tau.
+// Adaptive steps rarely repeat exactly, so a GateCache
+// saves little here, beyond the rejected steps retried
+// at a step size used before.
+//
+// The local error of each step is estimated by step
+// doubling and controlled by a StepControl of order
+// "Order" (default 2, e.g. for second order Trotter
+// gates); see stepcontrol.h for the other arguments.
+// ttotal need not be a multiple of the step.
+//
+// Each accepted step is reported to obs.measure with the
+// arguments "Time", "TimeStep", "StepError", "NextTimeStep"
+// and "StepsRejected" (recorded by TEvolObserver::steps()).
+//
+// Other arguments are passed to gateTEvol.
+//
+template <class GateMaker>
+Real
+gateTEvolAdaptive(GateMaker const& makeGates,
+                  Real ttotal,
+                  Real tstep,
+                  MPS & psi,
+                  Observer& obs,
+                  Args args = Args::global());
+
+template <class GateMaker>
+Real
+gateTEvolAdaptive(GateMaker const& makeGates,
+                  Real ttotal,
+                  Real tstep,
+                  MPS & psi,
+                  Args const& args = Args::global());
+
 //
 //
 // Implementations
@@ -75,45 +120,75 @@ gateTEvol(Iterable const& gatelist,
         printfln("Taking %d steps of timestep %.5f, total time %.5f",nt,tstep,ttotal);
         }
 
-    psi.position(gatelist.front().i1());
-    Real tot_norm = norm(psi);
-
-    Real tsofar = 0;
-    for(auto tt : range1(nt))
+    //Applies a list of gates, restoring MPS form after
+    //each one in the direction of the following gate
+    auto applyGates = [&psi,&args](auto const& gates)
         {
-        auto g = gatelist.begin();
-        while(g != gatelist.end())
+        auto g = gates.begin();
+        if(g == gates.end()) return;
+        if(psi.leftLim() < g->i1()-1 || psi.rightLim() > g->i1()+2)
+            {
+            psi.position(g->i1());
+            }
+        while(g != gates.end())
             {
             auto i1 = g->i1();
             auto i2 = g->i2();
-            auto AA = psi(i1)*psi(i2)*g->gate();
-            AA.replaceTags("Site,1","Site,0");
+            auto const& gate = g->gate();
 
             ++g;
-            if(g != gatelist.end())
+            if(g != gates.end())
                 {
                 //Look ahead to next gate position
                 auto ni1 = g->i1();
                 auto ni2 = g->i2();
-                //SVD AA to restore MPS form
-                //before applying current gate
+                //Apply current gate and SVD to restore
+                //MPS form in the direction of the next gate
                 if(ni1 >= i2)
                     {
-                    psi.svdBond(i1,AA,Fromleft,args);
+                    psi.applyGate(i1,gate,Fromleft,args);
                     psi.position(ni1); //does no work if position already ni1
                     }
                 else
                     {
-                    psi.svdBond(i1,AA,Fromright,args);
+                    psi.applyGate(i1,gate,Fromright,args);
                     psi.position(ni2); //does no work if position already ni2
                     }
                 }
             else
                 {
                 //No next gate to analyze, just restore MPS form
-                psi.svdBond(i1,AA,Fromright,args);
+                psi.applyGate(i1,gate,Fromright,args);
                 }
             }
+        };
+
+    auto fuse_steps = args.getBool("FuseSteps",false) && nt > 1;
+    auto fs = FusedSteps();
+    if(fuse_steps)
+        {
+        fs = fuseSteps(std::vector<BondGate>(gatelist.begin(),gatelist.end()));
+        if(verbose)
+            {
+            printfln("Fused gates: %d per step (was %d)",fs.middle.size(),std::distance(gatelist.begin(),gatelist.end()));
+            }
+        }
+
+    psi.position(gatelist.front().i1());
+    Real tot_norm = norm(psi);
+
+    Real tsofar = 0;
+    for(auto tt : range1(nt))
+        {
+        if(not fuse_steps)
+            {
+            applyGates(gatelist);
+            }
+        else
+            {
+            applyGates(tt == 1 ? fs.first : fs.middle);
+            if(tt == nt) applyGates(fs.last);
+            }
 
         if(do_normalize)
             {
@@ -148,6 +223,54 @@ gateTEvol(Iterable const& gatelist,
     return gateTEvol(gatelist,ttotal,tstep,psi,obs,args);
     }
 
+template <class GateMaker>
+Real
+gateTEvolAdaptive(GateMaker const& makeGates,
+                  Real ttotal,
+                  Real tstep,
+                  MPS & psi,
+                  Observer& obs,
+                  Args args)
+    {
+    auto control = StepControl(args.getInt("Order",2),args);
+
+    auto stepargs = Args(args);
+    stepargs.add("Verbose",false);
+    stepargs.add("FuseSteps",false);
+    Observer quiet;
+
+    Real tot_norm = 1.;
+    Real nrm2 = 1.;
+    MPS two;
+    auto tryStep = [&](Real h)
+        {
+        auto one = psi;
+        gateTEvol(makeGates(h),h,h,one,quiet,stepargs);
+        two = psi;
+        nrm2 = gateTEvol(makeGates(h/2),h,h/2,two,quiet,stepargs);
+        return stepError(one,two);
+        };
+    auto acceptStep = [&]()
+        {
+        psi = std::move(two);
+        tot_norm *= nrm2;
+        };
+    control.evolve(ttotal,tstep,tryStep,acceptStep,obs,args);
+    return tot_norm;
+    }
+
+template <class GateMaker>
+Real
+gateTEvolAdaptive(GateMaker const& makeGates,
+                  Real ttotal,
+                  Real tstep,
+                  MPS & psi,
+                  Args const& args)
+    {
+    TEvolObserver obs(args);
+    return gateTEvolAdaptive(makeGates,ttotal,tstep,psi,obs,args);
+    }
+
 } //namespace itensor
 
 
@@ -425,6 +425,83 @@ svdImpl(ITensor const& A,
 
 
 
+//
+// Truncated SVD from a randomized range finder (Halko,
+// Martinsson and Tropp, SIAM Rev. 53, 217 (2011)): A is
+// applied to MaxDim+Oversample random vectors, refined by
+// PowerIter applications of A*dag(A), and the SVD is done on
+// the projection of A onto the subspace found. Costs
+// O(m*n*MaxDim) instead of O(m*n*min(m,n)).
+//
+Spectrum 
+svdRandomized(ITensor const& A, 
+              Index const& uI, 
+              Index const& vI,
+              ITensor & U, 
+              ITensor & D, 
+              ITensor & V,
+              Args args)
+    {
+    args.add("SVDMethod","automatic");
+    if(!args.defined("MaxDim")) return svdOrd2(A,uI,vI,U,D,V,args);
+    auto k = args.getInt("MaxDim")+args.getInt("Oversample",10);
+    auto npower = args.getInt("PowerIter",2);
+
+    //Sampling Index with at most k vectors per QN block of vI
+    auto vA = vI;
+    for(auto& J : inds(A)) if(J == vI) vA = J;
+    auto r = Index();
+    if(hasQNs(vA))
+        {
+        auto qns = Index::qnstorage{};
+        for(auto b : range1(nblock(vA)))
+            {
+            qns.emplace_back(qn(vA,b),std::min<long>(k,blocksize(vA,b)));
+            }
+        r = Index(move(qns),dir(vA),"Link,Sample");
+        }
+    else
+        {
+        r = Index(std::min<long>(k,dim(vA)),"Link,Sample");
+        }
+    if(dim(r) >= std::min(dim(uI),dim(vI)))
+        {
+        return svdOrd2(A,uI,vI,U,D,V,args);
+        }
+
+    auto Omega = hasQNs(r) ? randomITensor(QN(),dag(vA),r) : randomITensor(dag(vA),r);
+    auto qrargs = Args("Tags","Link,Sample");
+    auto [Q,R] = qr(A*Omega,IndexSet(uI),qrargs);
+    for(int n = 0; n < npower; ++n)
+        {
+        auto Qv = std::get<0>(qr(dag(A)*Q,IndexSet(vI),qrargs));
+        std::tie(Q,R) = qr(A*Qv,IndexSet(uI),qrargs);
+        }
+
+    auto B = dag(Q)*A;
+    auto q = commonIndex(B,Q);
+    ITensor UB;
+    auto spec = svdOrd2(B,q,vI,UB,D,V,args);
+    U = Q*UB;
+
+    //The weight of A outside of the subspace sampled counts
+    //as truncated, so the truncation error is exact (scaled
+    //by the largest weight, as done by truncate)
+    auto total = sqr(norm(A));
+    auto eigs = spec.eigs();
+    auto truncerr = 0.;
+    if(total > 0. && eigs.size() > 0)
+        {
+        truncerr = std::max(0.,1.-sumels(eigs)/total)*eigs(0);
+        }
+    if(spec.hasQNs())
+        {
+        auto qns = spec.qns();
+        return Spectrum(move(eigs),move(qns),{"Truncerr",truncerr});
+        }
+    return Spectrum(move(eigs),{"Truncerr",truncerr});
+    }
+
 Spectrum 
 svdOrd2(ITensor const& A, 
         Index const& uI, 
@@ -455,6 +532,10 @@ svdOrd2(ITensor const& A,
         {
         Error("A must be matrix-like (order 2)");
         }
+    if(args.getString("SVDMethod","automatic") == "randomized")
+        {
+        return svdRandomized(A,uI,vI,U,D,V,args);
+        }
     if(isComplex(A))
         {
         return svdImpl<Cplx>(A,uI,vI,U,D,V,args);
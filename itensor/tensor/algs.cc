@@ -32,15 +32,16 @@ namespace itensor {
 namespace detail {
 
     int
-    hermitianDiag(int N, Real *Udata, Real *ddata)
+    hermitianDiag(int N, Real *Udata, Real *ddata, bool mrrr)
         {
         LAPACK_INT _N = N;
         LAPACK_INT info = 0;
-        dsyev_wrapper('V','U',_N,Udata,ddata,info);
+        if(mrrr) dsyevr_wrapper('V','U',_N,Udata,ddata,info);
+        else     dsyev_wrapper('V','U',_N,Udata,ddata,info);
         return info;
         }
     int
-    hermitianDiag(int N, Cplx *Udata,Real *ddata)
+    hermitianDiag(int N, Cplx *Udata,Real *ddata, bool)
         {
         LAPACK_INT _N = N;
         return zheev_wrapper(_N,Udata,ddata);
@@ -42,6 +42,9 @@ static const Real SVD_THRESH = 1E-5;
 //   //Real case:
 //   norm(M-U*D*transpose(U)); //is small
 //
+// Arg "EigMethod" can be "dsyev" (default) or, for real
+// matrices, "dsyevr" which uses the faster MRRR algorithm.
+//
 template<class MatM, class MatU,class Vecd,
          class = stdx::require<
          hasMatRange<MatM>,
@@ -51,7 +54,8 @@ template<class MatM, class MatU,class Vecd,
 void
 diagHermitian(MatM && M,
               MatU && U,
-              Vecd && d);
+              Vecd && d,
+              Args const& args = Args::global());
 
 // compute eigenvalues
 // and right eigenvectors
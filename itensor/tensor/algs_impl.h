@@ -64,9 +64,9 @@ copyNegElts(Iter mre,
     
 
   int
-  hermitianDiag(int N, Real *Udata, Real *ddata);
+  hermitianDiag(int N, Real *Udata, Real *ddata, bool mrrr = false);
   int
-  hermitianDiag(int N, Cplx *Udata,Real *ddata);
+  hermitianDiag(int N, Cplx *Udata,Real *ddata, bool mrrr = false);
 
   int
   QR(int M, int N, int Rrows, Real *Qdata, Real *Rdata);
@@ -95,7 +95,8 @@ template<class MatM,
 void
 diagHermitian(MatM && M,
               MatU && U,
-              Vecd && d)
+              Vecd && d,
+              Args const& args)
     {
     using Mval = typename stdx::decay_t<MatM>::value_type;
     using Uval = typename stdx::decay_t<MatU>::value_type;
@@ -124,7 +125,11 @@ diagHermitian(MatM && M,
     else                detail::copyNegElts(M.cbegin(),makeRef(U));
 
 
-    auto info = detail::hermitianDiag(N,U.data(),d.data());
+    auto method = args.getString("EigMethod","dsyev");
+    if(method != "dsyev" && method != "dsyevr")
+        throw std::runtime_error("diagHermitian: EigMethod " + method + " not recognized");
+
+    auto info = detail::hermitianDiag(N,U.data(),d.data(),method == "dsyevr");
     if(info != 0) 
         {
         //println("M = \n",M);
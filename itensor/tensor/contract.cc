@@ -16,6 +16,7 @@
 //TODO: replace unordered_map with a simpler container (small_map? or jump directly to location?)
 #include <unordered_map>
 #include <future>
+#include <chrono>
 
 #include "itensor/util/multalloc.h"
 #include "itensor/util/cputime.h"
@@ -27,6 +28,7 @@
 #include "itensor/tensor/sliceten.h"
 #include "itensor/indexset.h"
 #include "itensor/global.h"
+#include "itensor/util/contractstats.h"
 
 using std::vector;
 
@@ -730,6 +732,21 @@ class CABqueue
     };
 
 
+//Seconds spent permuting and in GEMM,
+//filled in when logging contraction stats
+struct ContractTimes
+    {
+    using clock_type = std::chrono::steady_clock;
+    double permute = 0.,
+           gemm = 0.;
+
+    static clock_type::time_point
+    now() { return clock_type::now(); }
+
+    static double
+    since(clock_type::time_point t0) { return std::chrono::duration<double>(now()-t0).count(); }
+    };
+
 template<typename range_t, typename VA, typename VB>
 void 
 contract(CProps const& p,
@@ -737,7 +754,8 @@ contract(CProps const& p,
          TenRefc<range_t,VB> B,
          TenRef<range_t,common_type<VA,VB>>  C,
          Real alpha = 1.,
-         Real beta = 0.)
+         Real beta = 0.,
+         ContractTimes* times = nullptr)
     {
     using VC = common_type<VA,VB>;
     auto Apsize = p.permuteA() ? dim(p.newArange) : 0ul;
@@ -752,6 +770,8 @@ contract(CProps const& p,
     auto bb = ab+Abufsize;
     auto cb = bb+Bbufsize;
 
+    auto t0 = times ? ContractTimes::now() : ContractTimes::clock_type::time_point();
+
     MatRefc<VA> aref;
     if(p.permuteA())
         {
@@ -812,14 +832,27 @@ contract(CProps const& p,
             }
         }
 
+    if(times)
+        {
+        times->permute += ContractTimes::since(t0);
+        t0 = ContractTimes::now();
+        }
+
     gemm(aref,bref,cref,alpha,beta);
 
+    if(times)
+        {
+        times->gemm += ContractTimes::since(t0);
+        t0 = ContractTimes::now();
+        }
+
     if(p.permuteC())
         {
 #ifdef DEBUG
         if(isTrivial(p.PC)) Error("Calling permute in contract with a trivial permutation");
 #endif
         C &= permute(newC,p.PC);
+        if(times) times->permute += ContractTimes::since(t0);
         }
     }
 
@@ -857,12 +890,31 @@ contract(TenRefc<RangeT,VA> A, Labels const& ai,
         {
         contractScalar(*B.data(),A,ai,C,ci,alpha,beta);
         }
-    else
+    else if(!contractStats().enabled())
         {
         CProps props(ai,bi,ci);
         props.compute(A,B,C);
         contract(props,A,B,C,alpha,beta);
         }
+    else
+        {
+        auto t0 = ContractTimes::now();
+        CProps props(ai,bi,ci);
+        props.compute(A,B,C);
+        auto times = ContractTimes();
+        contract(props,A,B,C,alpha,beta,&times);
+        auto shape = ContractShape();
+        shape.kind = contractStatsKind();
+        shape.m = props.dleft;
+        shape.k = props.dmid;
+        shape.n = props.dright;
+        shape.permA = props.permuteA();
+        shape.permB = props.permuteB();
+        shape.permC = props.permuteC();
+        shape.cplxA = isCplx(A);
+        shape.cplxB = isCplx(B);
+        contractStats().record(shape,ContractTimes::since(t0),times.permute,times.gemm);
+        }
     }
 
 //Explicit template instantiations:
@@ -346,6 +346,44 @@ dsyev_wrapper(char jobz,        //if jobz=='V', compute eigs and evecs
 #endif
     }
 
+//
+// dsyevr
+//
+void 
+dsyevr_wrapper(char jobz,
+               char uplo,
+               LAPACK_INT n,
+               LAPACK_REAL* A,
+               LAPACK_REAL* eigs,
+               LAPACK_INT& info)
+    {
+#ifdef PLATFORM_acml
+    dsyev_wrapper(jobz,uplo,n,A,eigs,info);
+#else
+    char range = 'A';
+    LAPACK_INT lda = n;
+    LAPACK_REAL vl = 0, vu = 0, abstol = 0;
+    LAPACK_INT il = 0, iu = 0, m = 0;
+    auto Z = std::vector<LAPACK_REAL>(jobz == 'V' ? n*n : 1);
+    LAPACK_INT ldz = std::max(LAPACK_INT(1),n);
+    auto isuppz = std::vector<LAPACK_INT>(2*std::max(LAPACK_INT(1),n));
+
+    //Compute optimal workspace sizes
+    LAPACK_INT lwork = -1, liwork = -1;
+    LAPACK_REAL wkopt = 0;
+    LAPACK_INT iwkopt = 0;
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&n,A,&lda,&vl,&vu,&il,&iu,&abstol,&m,eigs,
+                    Z.data(),&ldz,isuppz.data(),&wkopt,&lwork,&iwkopt,&liwork,&info);
+    lwork = LAPACK_INT(wkopt);
+    liwork = iwkopt;
+    auto work = std::vector<LAPACK_REAL>(lwork);
+    auto iwork = std::vector<LAPACK_INT>(liwork);
+    F77NAME(dsyevr)(&jobz,&range,&uplo,&n,A,&lda,&vl,&vu,&il,&iu,&abstol,&m,eigs,
+                    Z.data(),&ldz,isuppz.data(),work.data(),&lwork,iwork.data(),&liwork,&info);
+    if(jobz == 'V') std::copy(Z.begin(),Z.end(),A);
+#endif
+    }
+
 //
 // dscal
 //
@@ -289,6 +289,13 @@ void F77NAME(dsyev)(char *jobz, char *uplo, int *n, double *a, int *lda,
 void F77NAME(dsyev)(const char* jobz, const char* uplo, const LAPACK_INT* n, double* a,
             const LAPACK_INT* lda, double* w, double* work, const LAPACK_INT* lwork,
             LAPACK_INT* info );
+
+void F77NAME(dsyevr)(const char* jobz, const char* range, const char* uplo, const LAPACK_INT* n,
+            double* a, const LAPACK_INT* lda, const double* vl, const double* vu,
+            const LAPACK_INT* il, const LAPACK_INT* iu, const double* abstol, LAPACK_INT* m,
+            double* w, double* z, const LAPACK_INT* ldz, LAPACK_INT* isuppz,
+            double* work, const LAPACK_INT* lwork, LAPACK_INT* iwork, const LAPACK_INT* liwork,
+            LAPACK_INT* info );
 #endif
 
 #ifdef ITENSOR_USE_CBLAS
@@ -551,6 +558,20 @@ dsyev_wrapper(char jobz,        //if jobz=='V', compute eigs and evecs
               LAPACK_REAL* eigs, //eigenvalues on return
               LAPACK_INT& info);  //error info
 
+//
+// dsyevr
+//
+// Same as dsyev, but uses the faster MRRR algorithm.
+// Eigenvectors are also returned in A.
+//
+void
+dsyevr_wrapper(char jobz,        //if jobz=='V', compute eigs and evecs
+               char uplo,        //if uplo=='U', read from upper triangle of A
+               LAPACK_INT n,     //number of cols of A
+               LAPACK_REAL* A,    //symmetric matrix A
+               LAPACK_REAL* eigs, //eigenvalues on return
+               LAPACK_INT& info);  //error info
+
 //
 // dscal
 //
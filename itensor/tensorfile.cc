@@ -0,0 +1,559 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include "itensor/tensorfile.h"
+#include "itensor/util/compress.h"
+
+namespace itensor {
+
+using std::string;
+using std::vector;
+
+static char const tensorfile_magic[8] = {'I','T','T','E','N','S','O','R'};
+uint32_t const tensorfile_version = 1;
+uint32_t const tensorfile_bom = 0x01020304;
+size_t const tensorfile_align = 64;
+
+struct TensorFilePreamble
+    {
+    char magic[8];
+    uint32_t version = 0;
+    uint32_t bom = 0;
+    uint64_t header_offset = 0;
+    uint64_t header_size = 0;
+    };
+static_assert(sizeof(TensorFilePreamble) == 32,"Unexpected size of TensorFilePreamble");
+
+bool static
+isLittleEndian()
+    {
+    uint32_t x = 1;
+    unsigned char c = 0;
+    std::memcpy(&c,&x,1);
+    return c == 1;
+    }
+
+TensorFileWriter::
+TensorFileWriter(string const& fname)
+  : fname_(fname),
+    tmpname_(fname+".tmp"),
+    s_(tmpname_.c_str(),std::ios::binary)
+    {
+    if(not isLittleEndian())
+        {
+        Error("TensorFileWriter: only supported on little-endian hosts");
+        }
+    if(!s_.good()) throw ITError("Couldn't open file \"" + tmpname_ + "\" for writing");
+    auto pre = TensorFilePreamble();
+    s_.write(reinterpret_cast<char const*>(&pre),sizeof(pre));
+    pos_ = sizeof(pre);
+    }
+
+TensorFileWriter::
+~TensorFileWriter()
+    {
+    if(not s_.is_open()) return;
+    try { close(); }
+    catch(...) { }
+    }
+
+void TensorFileWriter::
+append(ITensor const& T)
+    {
+    PROFILE_REGION("tensorfile write");
+    if(not s_.is_open()) Error("TensorFileWriter: append called after close");
+    auto& h = entries_;
+    auto type = StorageType::Null;
+    if(T.store()) type = doTask(StorageType{},T.store());
+    itensor::write(h,T.inds());
+    itensor::write(h,T.scale());
+    itensor::write(h,type);
+    auto G = GetRawData();
+    auto store = string();
+    if(isDenseType(type))
+        {
+        doTask(G,T.store());
+        auto pad = (tensorfile_align-pos_%tensorfile_align)%tensorfile_align;
+        auto zeros = vector<char>(pad,0);
+        s_.write(zeros.data(),pad);
+        pos_ += pad;
+        }
+    else
+        {
+        std::ostringstream ss;
+        T.write(ss);
+        store = ss.str();
+        }
+    itensor::write(h,pos_);
+    itensor::write(h,G.bytes);
+    itensor::write(h,G.offsets ? *G.offsets : BlockOffsets());
+    itensor::write(h,store);
+    if(G.bytes > 0)
+        {
+        s_.write(G.data,G.bytes);
+        pos_ += G.bytes;
+        }
+    n_ += 1;
+    }
+
+void TensorFileWriter::
+close(string const& kind,
+      vector<long> const& meta)
+    {
+    if(not s_.is_open()) return;
+    std::ostringstream h;
+    itensor::write(h,kind);
+    itensor::write(h,meta);
+    itensor::write(h,n_);
+    h << entries_.str();
+    auto header = h.str();
+    s_.write(header.data(),header.size());
+
+    auto pre = TensorFilePreamble();
+    std::memcpy(pre.magic,tensorfile_magic,8);
+    pre.version = tensorfile_version;
+    pre.bom = tensorfile_bom;
+    pre.header_offset = pos_;
+    pre.header_size = header.size();
+    s_.seekp(0);
+    s_.write(reinterpret_cast<char const*>(&pre),sizeof(pre));
+    auto ok = s_.good();
+    s_.close();
+    if(!ok) throw ITError("Error writing file \"" + tmpname_ + "\"");
+    //Replace fname_ only now: renaming keeps the old
+    //file alive for tensors which still map it
+#if defined(_WIN32)
+    std::remove(fname_.c_str());
+#endif
+    if(std::rename(tmpname_.c_str(),fname_.c_str()) != 0)
+        {
+        throw ITError("Couldn't rename \"" + tmpname_ + "\" to \"" + fname_ + "\"");
+        }
+    }
+
+void
+writeTensorFile(string const& fname,
+                vector<ITensor> const& Ts,
+                string const& kind,
+                vector<long> const& meta)
+    {
+    TensorFileWriter W(fname);
+    for(auto& T : Ts) W.append(T);
+    W.close(kind,meta);
+    }
+
+TensorFile::
+TensorFile(string const& fname)
+  : file_(std::make_shared<MappedFile>(fname))
+    {
+    auto& file = *file_;
+    auto pre = TensorFilePreamble();
+    if(file.size() < sizeof(pre))
+        {
+        throw ITError("File \"" + fname + "\" is not a TensorFile");
+        }
+    std::memcpy(&pre,file.data(),sizeof(pre));
+    if(std::memcmp(pre.magic,tensorfile_magic,8) != 0)
+        {
+        throw ITError("File \"" + fname + "\" is not a TensorFile");
+        }
+    if(pre.bom != tensorfile_bom)
+        {
+        throw ITError("TensorFile \"" + fname + "\" has wrong byte order for this host");
+        }
+    if(pre.version > tensorfile_version)
+        {
+        throw ITError(format("TensorFile \"%s\" has unsupported version %d",fname,pre.version));
+        }
+    if(pre.header_offset+pre.header_size > file.size())
+        {
+        throw ITError("TensorFile \"" + fname + "\" is truncated");
+        }
+
+    auto buf = MemoryBuf(file.data()+pre.header_offset,pre.header_size);
+    std::istream h(&buf);
+    itensor::read(h,kind_);
+    itensor::read(h,meta_);
+    size_t n = 0;
+    itensor::read(h,n);
+    entries_.resize(n);
+    for(auto& e : entries_)
+        {
+        itensor::read(h,e.inds);
+        itensor::read(h,e.scale);
+        itensor::read(h,e.type);
+        itensor::read(h,e.offset);
+        itensor::read(h,e.bytes);
+        itensor::read(h,e.offsets);
+        itensor::read(h,e.store);
+        if(e.offset+e.bytes > pre.header_offset
+           || (isDenseType(e.type) && e.offset%tensorfile_align != 0))
+            {
+            throw ITError("TensorFile \"" + fname + "\" has an invalid data section");
+            }
+        }
+    if(!h.good()) throw ITError("Error reading header of TensorFile \"" + fname + "\"");
+    }
+
+//Tensor of entry e with uninitialized storage
+template<typename StoreType>
+ITensor static
+newDense(TensorFile::Entry const& e)
+    {
+    using value_type = typename StoreType::value_type;
+    auto store = newITData<StoreType>(undef,e.bytes/sizeof(value_type));
+    return ITensor(e.inds,std::move(store),e.scale);
+    }
+
+template<typename StoreType>
+ITensor static
+newQDense(TensorFile::Entry const& e)
+    {
+    using value_type = typename StoreType::value_type;
+    auto store = newITData<StoreType>(undef,e.offsets,e.bytes/sizeof(value_type));
+    return ITensor(e.inds,std::move(store),e.scale);
+    }
+
+ITensor TensorFile::
+read(size_t n) const
+    {
+    auto& e = entries_.at(n);
+    if(not isDenseType(e.type))
+        {
+        PROFILE_REGION("tensorfile read");
+        auto buf = MemoryBuf(e.store.data(),e.store.size());
+        std::istream s(&buf);
+        auto T = ITensor();
+        T.read(s);
+        return T;
+        }
+    auto store = ITensor::storage_ptr();
+    if(e.type == StorageType::DenseReal)
+        {
+        store = newITData<MappedDenseReal>(file_,e.offset,e.bytes/sizeof(Real));
+        }
+    else if(e.type == StorageType::DenseCplx)
+        {
+        store = newITData<MappedDenseCplx>(file_,e.offset,e.bytes/sizeof(Cplx));
+        }
+    else if(e.type == StorageType::QDenseReal)
+        {
+        store = newITData<MappedQDenseReal>(file_,e.offsets,e.offset,e.bytes/sizeof(Real));
+        }
+    else
+        {
+        store = newITData<MappedQDenseCplx>(file_,e.offsets,e.offset,e.bytes/sizeof(Cplx));
+        }
+    return ITensor(e.inds,std::move(store),e.scale);
+    }
+
+vector<ITensor>
+readTensorFile(string const& fname)
+    {
+    TensorFile F(fname);
+    auto Ts = vector<ITensor>(F.size());
+    for(auto n : range(F.size())) Ts[n] = F.read(n);
+    return Ts;
+    }
+
+
+//
+// Spill files
+//
+
+static char const spill_magic[8] = {'I','T','S','P','I','L','L','1'};
+
+//Compressed units are QN blocks, split
+//further if larger than this
+static size_t const spill_max_unit = size_t(1) << 22;
+
+SpillCodec
+spillCodec(Args const& args)
+    {
+    auto name = args.getString("WriteCompression","None");
+    if(name == "None") return SpillCodec::None;
+    if(name == "LZ") return SpillCodec::LZ;
+    if(name == "Mapped") return SpillCodec::Mapped;
+    Error("Unknown value \"" + name + "\" for WriteCompression, expected None, LZ or Mapped");
+    return SpillCodec::None;
+    }
+
+double static
+secondsSince(std::chrono::steady_clock::time_point t0)
+    {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()-t0).count();
+    }
+
+std::mutex static&
+spillStatsMutex()
+    {
+    static std::mutex m;
+    return m;
+    }
+
+SpillStats&
+spillStats()
+    {
+    static SpillStats st;
+    return st;
+    }
+
+Real SpillStats::
+ioTimeSaved() const
+    {
+    if(stored_bytes <= 0) return 0.;
+    return (raw_bytes-stored_bytes)/stored_bytes*(write_time+read_time);
+    }
+
+std::ostream&
+operator<<(std::ostream& s, SpillStats const& st)
+    {
+    s << format("Spill files: %d written, %d read, %.1f MB stored as %.1f MB (ratio %.2f)\n",
+                st.nwrite,st.nread,st.raw_bytes/1E6,st.stored_bytes/1E6,st.ratio());
+    s << format("    compress %.3fs, decompress %.3fs, write %.3fs, read %.3fs, est. I/O time saved %.3fs",
+                st.compress_time,st.decompress_time,st.write_time,st.read_time,st.ioTimeSaved());
+    return s;
+    }
+
+//Byte ranges [first,second) of the units compressed separately
+vector<std::pair<size_t,size_t>> static
+spillUnits(GetRawData const& G, size_t elsize)
+    {
+    auto starts = vector<size_t>();
+    if(G.offsets)
+        {
+        for(auto& bo : *G.offsets) starts.push_back(bo.offset*elsize);
+        }
+    if(starts.empty() || starts.front() != 0) starts.insert(starts.begin(),0);
+    auto units = vector<std::pair<size_t,size_t>>();
+    for(auto n : range(starts.size()))
+        {
+        auto end = (n+1 < starts.size()) ? starts[n+1] : G.bytes;
+        for(auto b = starts[n]; b < end; b += spill_max_unit)
+            {
+            units.emplace_back(b,std::min(end,b+spill_max_unit));
+            }
+        }
+    return units;
+    }
+
+size_t static
+elementSize(StorageType::Type type)
+    {
+    return (type == StorageType::DenseReal || type == StorageType::QDenseReal) ? sizeof(Real) : sizeof(Cplx);
+    }
+
+void
+writeSpill(string const& fname,
+           ITensor const& T,
+           SpillCodec codec)
+    {
+    PROFILE_REGION("spill write");
+    auto type = StorageType::Null;
+    if(T.store()) type = doTask(StorageType{},T.store());
+    if(codec == SpillCodec::Mapped)
+        {
+        TensorFileWriter W(fname);
+        W.append(T);
+        W.close("Spill");
+        return;
+        }
+    if(codec == SpillCodec::None || not isDenseType(type))
+        {
+        writeToFile(fname,T);
+        return;
+        }
+
+    auto G = GetRawData();
+    doTask(G,T.store());
+    auto units = spillUnits(G,elementSize(type));
+
+    auto t0 = std::chrono::steady_clock::now();
+    auto packed = vector<string>(units.size());
+#pragma omp parallel for schedule(dynamic)
+    for(size_t n = 0; n < units.size(); ++n)
+        {
+        auto b = units[n].first,
+             e = units[n].second;
+        packed[n] = shuffleCompress(G.data+b,e-b,sizeof(Real));
+        }
+    auto tcomp = secondsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    std::ofstream s(fname.c_str(),std::ios::binary);
+    if(!s.good()) throw ITError("Couldn't open file \"" + fname + "\" for writing");
+    s.write(spill_magic,8);
+    itensor::write(s,int(codec));
+    itensor::write(s,T.inds());
+    itensor::write(s,T.scale());
+    itensor::write(s,type);
+    itensor::write(s,G.bytes);
+    itensor::write(s,G.offsets ? *G.offsets : BlockOffsets());
+    itensor::write(s,units.size());
+    size_t stored = 0;
+    for(auto n : range(units.size()))
+        {
+        auto raw = units[n].second-units[n].first;
+        //Keep incompressible units as they are
+        auto compressed = (packed[n].size() < raw);
+        itensor::write(s,compressed);
+        if(compressed)
+            {
+            itensor::write(s,packed[n].size());
+            s.write(packed[n].data(),packed[n].size());
+            stored += packed[n].size();
+            }
+        else
+            {
+            itensor::write(s,raw);
+            s.write(G.data+units[n].first,raw);
+            stored += raw;
+            }
+        }
+    if(!s.good()) throw ITError("Error writing file \"" + fname + "\"");
+    s.close();
+    auto twrite = secondsSince(t0);
+
+    std::lock_guard<std::mutex> lock(spillStatsMutex());
+    auto& st = spillStats();
+    st.nwrite += 1;
+    st.raw_bytes += G.bytes;
+    st.stored_bytes += stored;
+    st.compress_time += tcomp;
+    st.write_time += twrite;
+    }
+
+void
+readSpill(string const& fname,
+          ITensor & T)
+    {
+    PROFILE_REGION("spill read");
+    std::ifstream s(fname.c_str(),std::ios::binary);
+    if(!s.good()) throw ITError("Couldn't open file \"" + fname + "\" for reading");
+    char magic[8] = {};
+    s.read(magic,8);
+    if(s.good() && std::memcmp(magic,tensorfile_magic,8) == 0)
+        {
+        s.close();
+        T = TensorFile(fname).read(0);
+        return;
+        }
+    if(!s.good() || std::memcmp(magic,spill_magic,8) != 0)
+        {
+        s.clear();
+        s.seekg(0);
+        T.read(s);
+        return;
+        }
+
+    auto t0 = std::chrono::steady_clock::now();
+    int codec = 0;
+    itensor::read(s,codec);
+    if(codec != int(SpillCodec::LZ)) throw ITError("Unknown codec in spill file \"" + fname + "\"");
+    auto is = IndexSet();
+    auto scale = LogNum();
+    auto type = StorageType::Null;
+    size_t bytes = 0;
+    auto offsets = BlockOffsets();
+    size_t nunits = 0;
+    itensor::read(s,is);
+    itensor::read(s,scale);
+    itensor::read(s,type);
+    itensor::read(s,bytes);
+    itensor::read(s,offsets);
+    itensor::read(s,nunits);
+    auto compressed = vector<bool>(nunits);
+    auto packed = vector<string>(nunits);
+    size_t stored = 0;
+    for(auto n : range(nunits))
+        {
+        bool c = false;
+        size_t size = 0;
+        itensor::read(s,c);
+        itensor::read(s,size);
+        compressed[n] = c;
+        packed[n].resize(size);
+        s.read(&packed[n][0],size);
+        stored += size;
+        }
+    if(!s.good()) throw ITError("Error reading spill file \"" + fname + "\"");
+    auto tread = secondsSince(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    auto e = TensorFile::Entry();
+    e.inds = is;
+    e.scale = scale;
+    e.type = type;
+    e.bytes = bytes;
+    e.offsets = offsets;
+    if(type == StorageType::DenseReal) T = newDense<DenseReal>(e);
+    else if(type == StorageType::DenseCplx) T = newDense<DenseCplx>(e);
+    else if(type == StorageType::QDenseReal) T = newQDense<QDenseReal>(e);
+    else if(type == StorageType::QDenseCplx) T = newQDense<QDenseCplx>(e);
+    else throw ITError("Unexpected storage type in spill file \"" + fname + "\"");
+
+    //T owns its freshly allocated storage,
+    //so its data can be written in place
+    auto R = GetMutableRawData();
+    doTask(R,T.store());
+    auto G = GetRawData();
+    G.bytes = R.bytes;
+    G.offsets = &offsets;
+    auto units = spillUnits(G,elementSize(type));
+    auto corrupted = (R.bytes != bytes || units.size() != nunits);
+    for(auto n : range(nunits))
+        {
+        if(corrupted) break;
+        auto raw = units[n].second-units[n].first;
+        if(not compressed[n] && packed[n].size() != raw) corrupted = true;
+        }
+    if(corrupted) throw ITError("Corrupted spill file \"" + fname + "\"");
+
+    //Exceptions cannot leave the parallel region, so
+    //each unit records its own and they are rethrown after
+    auto failure = vector<std::exception_ptr>(nunits);
+#pragma omp parallel for schedule(dynamic)
+    for(size_t n = 0; n < nunits; ++n)
+        {
+        auto b = units[n].first,
+             e = units[n].second;
+        try
+            {
+            if(compressed[n]) shuffleDecompress(packed[n].data(),packed[n].size(),R.data+b,e-b,sizeof(Real));
+            else              std::memcpy(R.data+b,packed[n].data(),e-b);
+            }
+        catch(...)
+            {
+            failure[n] = std::current_exception();
+            }
+        }
+    for(auto& f : failure) if(f) std::rethrow_exception(f);
+    auto tdecomp = secondsSince(t0);
+
+    std::lock_guard<std::mutex> lock(spillStatsMutex());
+    auto& st = spillStats();
+    st.nread += 1;
+    st.decompress_time += tdecomp;
+    st.read_time += tread;
+    }
+
+} //namespace itensor
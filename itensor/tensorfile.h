@@ -0,0 +1,245 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_TENSORFILE_H
+#define __ITENSOR_TENSORFILE_H
+
+#include <sstream>
+#include "itensor/itensor.h"
+#include "itensor/util/mapped_file.h"
+
+namespace itensor {
+
+//
+// Binary file format for a list of ITensors
+// designed to be memory mapped:
+//
+//   [0,32)   preamble: magic "ITTENSOR", format version,
+//            byte order mark, offset and size of the header
+//   data     one section per Dense/QDense tensor holding
+//            its elements, aligned to 64 bytes
+//   header   kind string, integer metadata and for each
+//            tensor its IndexSet, scale, storage type,
+//            data offset and size (and QDense block offsets);
+//            other storage types are stored in the header
+//
+// Data sections are little-endian and written in the
+// memory layout of the storage, so they are used in
+// place in the mapped file: ITensors returned by read()
+// (and readTensorFile) have MappedDense or MappedQDense
+// storage (see itdata/mapped.h), which is only copied
+// into memory when the tensor is first modified.
+//
+// The mapping stays valid while any such ITensor exists,
+// also after the TensorFile is destroyed. Files are written
+// under a temporary name and renamed when complete, so
+// tensors mapped from an older file of the same name are
+// not affected by writing a new one.
+//
+class TensorFile
+    {
+    public:
+
+    struct Entry
+        {
+        IndexSet inds;
+        LogNum scale;
+        StorageType::Type type = StorageType::Null;
+        size_t offset = 0;   //position of data section in file
+        size_t bytes = 0;    //size of data section
+        BlockOffsets offsets;//QDense block offsets
+        std::string store;   //serialized non-Dense storage
+        };
+
+    private:
+    std::shared_ptr<MappedFile const> file_;
+    std::string kind_;
+    std::vector<long> meta_;
+    std::vector<Entry> entries_;
+    public:
+
+    TensorFile() { }
+
+    //Maps the file and reads its header;
+    //tensor data is not touched
+    explicit
+    TensorFile(std::string const& fname);
+
+    explicit operator bool() const { return file_ && bool(*file_); }
+
+    size_t
+    size() const { return entries_.size(); }
+
+    //Kind of object stored, e.g. "ITensors" or "MPS"
+    std::string const&
+    kind() const { return kind_; }
+
+    //Integer metadata saved with the tensors
+    std::vector<long> const&
+    meta() const { return meta_; }
+
+    Entry const&
+    entry(size_t n) const { return entries_.at(n); }
+
+    IndexSet const&
+    inds(size_t n) const { return entries_.at(n).inds; }
+
+    //Read-only view of the elements of tensor n
+    //directly in the mapped file (no copy).
+    //T must be Real for DenseReal/QDenseReal
+    //and Cplx for DenseCplx/QDenseCplx storage.
+    template<typename T>
+    DataRange<const T>
+    data(size_t n) const;
+
+    //Returns tensor n as an ITensor whose Dense or
+    //QDense data stays in the mapped file until the
+    //tensor is modified
+    ITensor
+    read(size_t n) const;
+
+    ITensor
+    operator()(size_t n) const { return read(n); }
+    };
+
+template<typename T>
+DataRange<const T> TensorFile::
+data(size_t n) const
+    {
+    auto& e = entries_.at(n);
+    auto isreal = (e.type == StorageType::DenseReal || e.type == StorageType::QDenseReal);
+    auto iscplx = (e.type == StorageType::DenseCplx || e.type == StorageType::QDenseCplx);
+    if(not ((isreal && std::is_same<T,Real>::value) || (iscplx && std::is_same<T,Cplx>::value)))
+        {
+        throw ITError("TensorFile::data: element type does not match storage of tensor");
+        }
+    auto p = reinterpret_cast<T const*>(file_->data()+e.offset);
+    return makeDataRange(p,e.bytes/sizeof(T));
+    }
+
+//
+// Writes a TensorFile one tensor at a time,
+// so only the tensor being appended has to
+// be in memory. The header is written by close
+// (or by the destructor, with default arguments).
+//
+class TensorFileWriter
+    {
+    std::string fname_,
+                tmpname_;
+    std::ofstream s_;
+    std::ostringstream entries_;
+    size_t pos_ = 0;
+    size_t n_ = 0;
+    public:
+
+    explicit
+    TensorFileWriter(std::string const& fname);
+
+    TensorFileWriter(TensorFileWriter const&) = delete;
+    TensorFileWriter& operator=(TensorFileWriter const&) = delete;
+
+    ~TensorFileWriter();
+
+    //Number of tensors appended so far
+    size_t
+    size() const { return n_; }
+
+    void
+    append(ITensor const& T);
+
+    void
+    close(std::string const& kind = "ITensors",
+          std::vector<long> const& meta = std::vector<long>());
+    };
+
+//
+// Writes Ts to fname in the TensorFile format
+//
+void
+writeTensorFile(std::string const& fname,
+                std::vector<ITensor> const& Ts,
+                std::string const& kind = "ITensors",
+                std::vector<long> const& meta = std::vector<long>());
+
+//
+// Reads all tensors of a TensorFile
+// (with storage in the mapped file)
+//
+std::vector<ITensor>
+readTensorFile(std::string const& fname);
+
+//
+// Spill files: single tensors written to disk and
+// read back later, as by MPS and LocalMPO when
+// doWrite(true) is used.
+//
+// The codec is chosen by the "WriteCompression" argument:
+//   "None" (default): files written by writeToFile
+//   "LZ": data of Dense and QDense storage is byte
+//         shuffled and LZ compressed (util/compress.h),
+//         one QN block at a time
+//   "Mapped": TensorFiles holding one tensor, read back
+//         with storage in the mapped file (see above)
+//
+enum class SpillCodec { None = 0, LZ = 1, Mapped = 2 };
+
+SpillCodec
+spillCodec(Args const& args);
+
+void
+writeSpill(std::string const& fname,
+           ITensor const& T,
+           SpillCodec codec);
+
+//Reads files written by writeSpill with any
+//codec, or by writeToFile
+void
+readSpill(std::string const& fname,
+          ITensor & T);
+
+//
+// Running totals over all spill files
+// written and read with the "LZ" codec
+//
+struct SpillStats
+    {
+    long nwrite = 0,
+         nread = 0;
+    double raw_bytes = 0,      //size of the uncompressed data
+           stored_bytes = 0;   //size written to disk
+    double compress_time = 0,  //seconds (wall time)
+           decompress_time = 0,
+           write_time = 0,
+           read_time = 0;
+
+    Real
+    ratio() const { return stored_bytes > 0 ? raw_bytes/stored_bytes : 1.; }
+
+    //Estimate of the write and read time saved by
+    //compression, using the measured disk bandwidth
+    Real
+    ioTimeSaved() const;
+    };
+
+SpillStats&
+spillStats();
+
+std::ostream&
+operator<<(std::ostream& s, SpillStats const& st);
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,415 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "itensor/tn/ctmrg.h"
+
+namespace itensor {
+
+using std::string;
+
+//Index i with the arrow it has on T
+Index static
+indexOn(ITensor const& T,
+        Index const& i)
+    {
+    for(auto& j : inds(T)) if(j == i) return j;
+    Error("indexOn: Index not found");
+    return i;
+    }
+
+//The Index paired with i across a bond or a tensor T:
+//prime(i) if i is unprimed, noPrime(i) otherwise
+Index static
+partner(Index const& i)
+    {
+    return primeLevel(i) == 0 ? prime(i) : noPrime(i);
+    }
+
+//Eigenvalues of spec (or their square roots for an
+//SVD spectrum), normalized to sum to 1
+Vector static
+normalizedSpectrum(Spectrum const& spec,
+                   bool svd)
+    {
+    auto s = Vector(spec.size());
+    for(auto i : range(s.size()))
+        {
+        s(i) = svd ? std::sqrt(spec.eigs()(i)) : std::fabs(spec.eigs()(i));
+        }
+    s /= sumels(s);
+    return s;
+    }
+
+static const char* const sidename[4] = {"up","right","down","left"};
+
+CTMRG::
+CTMRG(ITensor T,
+      Index const& h,
+      Index const& v,
+      Args const& args)
+  : T_(std::move(T)),
+    args_(args)
+    {
+    if(order(T_) != 4
+       || !hasIndex(T_,h) || !hasIndex(T_,prime(h))
+       || !hasIndex(T_,v) || !hasIndex(T_,prime(v)))
+        {
+        Error("CTMRG: T must have indices h, h', v and v'");
+        }
+    t_[Up] = indexOn(T_,v);
+    t_[Right] = indexOn(T_,prime(h));
+    t_[Down] = indexOn(T_,prime(v));
+    t_[Left] = indexOn(T_,h);
+
+    maxdim_ = args.getInt("MaxDim",maxdim_);
+    cutoff_ = args.getReal("Cutoff",cutoff_);
+    eigmethod_ = args.getString("EigMethod",eigmethod_);
+    symmetric_ = args.getBool("Symmetric",symmetric_);
+    auto projector = args.getString("Projector","Isometric");
+    if(projector == "Oblique") oblique_ = true;
+    else if(projector != "Isometric") Error("CTMRG: Projector '" + projector + "' not recognized");
+    if(symmetric_)
+        {
+        if(hasQNs(T_)) Error("CTMRG: symmetric moves require T without QNs");
+        if(dim(h) != dim(v)) Error("CTMRG: symmetric moves require dim(h) == dim(v)");
+        }
+    init(args);
+    }
+
+void CTMRG::
+init(Args const& args)
+    {
+    auto boundary = args.getString("Boundary","Free");
+    if(boundary != "Free" && boundary != "Fixed")
+        {
+        Error("CTMRG: Boundary '" + boundary + "' not recognized");
+        }
+    for(auto s : range(4))
+        {
+        auto tags = format("CTM,Link,%s",sidename[s]);
+        x_[s] = hasQNs(T_) ? Index(QN(),1,tags) : Index(1,tags);
+
+        //Boundary vector on the leg t of T facing side s,
+        //over the states with zero QN
+        auto t = dag(t_[s]);
+        auto E = ITensor(dag(x_[s]),prime(x_[s]),t);
+        auto nset = 0;
+        auto n = 0;
+        for(auto b : range1(hasQNs(t) ? nblock(t) : 1))
+            {
+            auto bs = hasQNs(t) ? blocksize(t,b) : dim(t);
+            if(!hasQNs(t) || qn(t,b) == QN())
+                {
+                for(auto j : range1(bs))
+                    {
+                    if(boundary == "Fixed" && nset > 0) break;
+                    E.set(1,1,n+j,1.);
+                    ++nset;
+                    }
+                }
+            n += bs;
+            }
+        if(nset == 0) Error("CTMRG: T has no states of zero QN for the boundary");
+        E_[s] = E;
+        spec_[s] = Vector(1);
+        spec_[s](0) = 1.;
+        }
+
+    C_[UL] = ITensor(x_[Up],x_[Left]);
+    C_[UR] = ITensor(dag(prime(x_[Up])),x_[Right]);
+    C_[DR] = ITensor(dag(prime(x_[Down])),dag(prime(x_[Right])));
+    C_[DL] = ITensor(x_[Down],dag(prime(x_[Left])));
+    for(auto& C : C_) C.set(1,1,1.);
+
+    nsteps_ = 0;
+    change_ = 1.;
+    truncerr_ = 0.;
+    }
+
+long CTMRG::
+maxLinkDim() const
+    {
+    long m = 0;
+    for(auto& x : x_) m = std::max(m,long(dim(x)));
+    return m;
+    }
+
+Real CTMRG::
+step()
+    {
+    truncerr_ = 0.;
+    auto spec = std::array<Vector,4>{};
+    if(symmetric_)
+        {
+        truncerr_ = symmetricStep(spec[UL]);
+        spec.fill(spec[UL]);
+        }
+    else
+        {
+        for(auto s : {Left,Right,Up,Down})
+            {
+            truncerr_ = std::max(truncerr_,move(s));
+            }
+        for(auto c : range(4))
+            {
+            ITensor U(inds(C_[c])[0]),D,V;
+            spec[c] = normalizedSpectrum(svd(C_[c],U,D,V,{"Truncate",false}),true);
+            }
+        }
+    ++nsteps_;
+    updateSpectra(std::move(spec));
+    return change_;
+    }
+
+int CTMRG::
+run(Args const& args)
+    {
+    auto getInt = [&](const char* name, int def)
+        { return args.defined(name) ? args.getInt(name) : args_.getInt(name,def); };
+    auto getReal = [&](const char* name, Real def)
+        { return args.defined(name) ? args.getReal(name) : args_.getReal(name,def); };
+    auto maxiter = getInt("MaxIter",500);
+    auto miniter = getInt("MinIter",4);
+    auto tol = getReal("ConvergenceTol",1E-10);
+    auto quiet = args.defined("Quiet") ? args.getBool("Quiet") : args_.getBool("Quiet",true);
+
+    auto n = 0;
+    while(n < maxiter)
+        {
+        step();
+        ++n;
+        if(!quiet)
+            {
+            printfln("CTMRG step %d: change = %.3E, truncerr = %.3E, maxdim = %d",
+                     nsteps_,change_,truncerr_,maxLinkDim());
+            }
+        if(n >= miniter && change_ < tol) break;
+        }
+    return n;
+    }
+
+//
+// Moves on side s: the corners Ca, Cb and edge Es of side s
+// absorb the adjacent edges Ea, Eb and one row or column of T.
+// For the left move, with bonds x of the left side:
+//
+//   Ca -- Ea --       Ctop --
+//   |     |            | cut
+//   Es -- T --   =>    M ---
+//   |     |            | cut'
+//   Cb -- Eb --       Cbot --
+//
+// The two new bonds are truncated with projectors Pu, Pd,
+// inserting Pu*Pd on cut and prime(Pu)*prime(Pd) on cut'.
+// Both kinds of projectors are computed from the grown
+// corners Qa = Ctop*Es*T, which ends on cut', and
+// Qb = Cbot*Es*T, which ends on cut.
+//
+Real CTMRG::
+move(Side s)
+    {
+    //Corners and edges next to side s, upper or left end first
+    static const int nb[4][4] = {{UL,Left,UR,Right},
+                                 {UR,Up,DR,Down},
+                                 {DL,Left,DR,Right},
+                                 {UL,Up,DL,Down}};
+    auto& Ca = C_[nb[s][0]];
+    auto const& Ea = E_[nb[s][1]];
+    auto& Cb = C_[nb[s][2]];
+    auto const& Eb = E_[nb[s][3]];
+    auto& Es = E_[s];
+
+    auto ia = commonIndex(Ca,Ea),
+         ib = commonIndex(Cb,Eb);
+    auto fa = partner(ia),
+         fb = partner(ib);
+
+    auto Ctop = Ca*Ea;
+    auto Cbot = Cb*Eb;
+    auto cut = IndexSet(commonIndex(Ctop,Es),commonIndex(Ctop,T_));
+    auto cutp = prime(cut);
+    auto Qa = (Ctop*Es)*T_;
+    auto Qb = (Cbot*Es)*T_;
+    auto svdargs = Args("MaxDim",maxdim_,
+                        "Cutoff",cutoff_,
+                        "LeftTags",format("CTM,Link,%s",sidename[s]));
+
+    ITensor Pu,Pd;
+    Spectrum spec;
+    if(oblique_)
+        {
+        //Qa*Qb = U*D*V, Pu = Qb*dag(V)/D, Pd = Qa*dag(U),
+        //so that Qa*Pu*Pd*Qb is the truncated SVD of Qa*Qb
+        auto to = partner(t_[s]);
+        auto Qs = replaceInds(Qb,{to},{sim(to)});
+        auto M = Qa*prime(Qs,cut);
+        ITensor U(uniqueInds(inds(Qa),cutp)),D,V;
+        spec = svd(M,U,D,V,svdargs);
+        D.apply([](Real x) { return x > 0. ? 1./x : 0.; });
+        Pu = (Qs*dag(V))*dag(D);
+        Pd = replaceInds(Qa,cutp,cut)*dag(U);
+        }
+    else
+        {
+        //Isometry onto the dominant eigenvectors of
+        //rho = Qa*dag(Qa) + dag(Qb)*Qb on the cut
+        auto A = replaceInds(Qa,cutp,cut);
+        auto B = dag(Qb);
+        auto rho = A*dag(prime(A,cut));
+        rho += B*dag(prime(B,cut));
+        ITensor U,D;
+        spec = diagPosSemiDef(rho,U,D,{svdargs,
+                                       "Tags",format("CTM,Link,%s",sidename[s]),
+                                       "EigMethod",eigmethod_});
+        Pu = U;
+        Pd = dag(U);
+        }
+
+    auto to = partner(t_[s]);
+    Ca = replaceInds(Ctop*Pu,{fa},{ia});
+    Es = replaceInds(((Es*Pd)*T_)*prime(Pu),{to},{t_[s]});
+    Cb = replaceInds(Cbot*prime(Pd),{fb},{ib});
+    Ca /= norm(Ca);
+    Es /= norm(Es);
+    Cb /= norm(Cb);
+    x_[s] = commonIndex(Ca,Es);
+    return spec.truncerr();
+    }
+
+//
+// Step for T symmetric under the reflections of the lattice:
+// the grown upper left corner is diagonalized, and the
+// new corner and left edge are copied to the other sides
+//
+Real CTMRG::
+symmetricStep(Vector & cspec)
+    {
+    auto xl = x_[Left],
+         xu = x_[Up];
+    auto h = t_[Left],
+         v = t_[Up];
+
+    auto Cg = ((C_[UL]*E_[Left])*E_[Up])*T_;
+    Cg.replaceInds({prime(xl),prime(v),prime(xu),prime(h)},
+                   {xl,v,prime(xl),prime(v)});
+
+    ITensor U,D;
+    auto spec = diagPosSemiDef(Cg,U,D,{"MaxDim",maxdim_,
+                                       "Cutoff",cutoff_,
+                                       "Tags","CTM,Link,left",
+                                       "EigMethod",eigmethod_});
+    auto n = commonIndex(U,D);
+
+    auto El = ((E_[Left]*U)*T_)*dag(prime(U));
+    El.replaceInds({prime(h)},{h});
+    El /= norm(El);
+
+    x_[Left] = n;
+    for(auto s : {Up,Right,Down}) x_[s] = setTags(n,format("CTM,Link,%s",sidename[s]));
+
+    auto C = replaceInds(toDense(D),{n,prime(n)},{x_[Up],x_[Left]});
+    C /= norm(C);
+
+    E_[Up] = replaceInds(El,{n,prime(n),h},{x_[Up],prime(x_[Up]),v});
+    E_[Right] = replaceInds(El,{n,prime(n),h},{x_[Right],prime(x_[Right]),prime(h)});
+    E_[Down] = replaceInds(El,{n,prime(n),h},{x_[Down],prime(x_[Down]),prime(v)});
+    E_[Left] = std::move(El);
+
+    C_[UR] = replaceInds(C,{x_[Up],x_[Left]},{prime(x_[Up]),x_[Right]});
+    C_[DR] = replaceInds(C,{x_[Up],x_[Left]},{prime(x_[Down]),prime(x_[Right])});
+    C_[DL] = replaceInds(C,{x_[Up],x_[Left]},{x_[Down],prime(x_[Left])});
+    C_[UL] = std::move(C);
+
+    cspec = normalizedSpectrum(spec,false);
+    return spec.truncerr();
+    }
+
+void CTMRG::
+updateSpectra(std::array<Vector,4> && spec)
+    {
+    auto change = 0.;
+    for(auto c : range(4))
+        {
+        auto& s = spec[c];
+        auto& s0 = spec_[c];
+        auto d = 0.;
+        for(auto i : range(std::max(s.size(),s0.size())))
+            {
+            auto a = i < s.size() ? s(i) : 0.,
+                 b = i < s0.size() ? s0(i) : 0.;
+            d += std::fabs(a-b);
+            }
+        change = std::max(change,d);
+        s0 = std::move(s);
+        }
+    change_ = change;
+    }
+
+Cplx CTMRG::
+contractC(ITensor const& X) const
+    {
+    auto top = (C_[UL]*E_[Up])*C_[UR];
+    auto bot = (C_[DL]*E_[Down])*C_[DR];
+    auto Z = (((top*E_[Left])*X)*E_[Right])*bot;
+    return eltC(Z);
+    }
+
+Real CTMRG::
+kappa() const
+    {
+    auto Z1 = contractC(T_);
+
+    auto const& xu = x_[Up];
+    auto const& xr = x_[Right];
+    auto const& xd = x_[Down];
+    auto const& xl = x_[Left];
+
+    auto Z0 = C_[UL]*replaceInds(C_[UR],{prime(xu)},{xu});
+    Z0 *= replaceInds(C_[DL],{prime(xl)},{xl});
+    Z0 *= replaceInds(C_[DR],{prime(xd),prime(xr)},{xd,xr});
+
+    auto top = (C_[UL]*E_[Up])*C_[UR];
+    auto bot = (C_[DL]*E_[Down])*C_[DR];
+    auto Zh = top*replaceInds(bot,{prime(xl),t_[Down],prime(xr)},
+                                  {xl,t_[Up],xr});
+
+    auto left = (C_[UL]*E_[Left])*C_[DL];
+    auto right = (C_[UR]*E_[Right])*C_[DR];
+    auto Zv = left*replaceInds(right,{prime(xu),t_[Right],prime(xd)},
+                                     {xu,t_[Left],xd});
+
+    return std::real(Z1*eltC(Z0)/(eltC(Zh)*eltC(Zv)));
+    }
+
+std::tuple<ITensor,Index,Index>
+normTensor(ITensor const& A,
+           Index const& h,
+           Index const& v)
+    {
+    auto bh = addTags(h,"bra"),
+         bv = addTags(v,"bra");
+    auto B = replaceInds(dag(A),{h,prime(h),v,prime(v)},
+                                {bh,prime(bh),bv,prime(bv)});
+    auto [Ch,H] = combiner(IndexSet(indexOn(A,h),indexOn(B,bh)),{"Tags=","Link,H"});
+    auto [Cv,V] = combiner(IndexSet(indexOn(A,v),indexOn(B,bv)),{"Tags=","Link,V"});
+    auto T = A*B;
+    T *= Ch;
+    T *= dag(prime(Ch));
+    T *= Cv;
+    T *= dag(prime(Cv));
+    return std::make_tuple(T,H,V);
+    }
+
+} //namespace itensor
@@ -0,0 +1,213 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_CTMRG_H
+#define __ITENSOR_CTMRG_H
+
+#include <array>
+#include "itensor/decomp.h"
+
+namespace itensor {
+
+//
+// Corner transfer matrix renormalization group for
+// infinite, translation invariant 2D networks made of
+// a single tensor T(h,h',v,v'), such as the partition
+// function of a classical model or the norm of a PEPS
+// (see normTensor below).
+//
+// h and h' are the left and right legs of T, v and v'
+// its up and down legs. For tensors with QNs, h' and v'
+// must have arrows opposite to h and v, and T must
+// have zero divergence.
+//
+// The environment is made of four corners and four
+// edges (half-row and half-column transfer matrices):
+//
+//     C[UL] -- E[Up] -- C[UR]
+//       |        |        |
+//     E[Left] -- T -- E[Right]
+//       |        |        |
+//     C[DL] -- E[Down] -- C[DR]
+//
+// Each bond of the environment is an Index x of one
+// side (up, right, down or left) and its prime, x
+// being on the upper or left end of the bond.
+//
+// Named arguments:
+//  "MaxDim"         - maximum bond dimension chi of the
+//                     environment (default 32)
+//  "Cutoff"         - truncation error cutoff of the
+//                     projectors (default 1E-12)
+//  "Symmetric"      - if true, T must be invariant under
+//                     the reflections of the square lattice
+//                     and each step grows a single corner and
+//                     edge, copying them to the other sides.
+//                     Only for tensors without QNs.
+//                     (default false)
+//  "Projector"      - for directional moves, "Isometric"
+//                     (default): the dominant subspace of the
+//                     grown corners on both sides of the cut,
+//                     or "Oblique": projectors from the SVD of
+//                     the product of the grown corners, which
+//                     are more accurate for networks without
+//                     reflection symmetry
+//  "EigMethod"      - LAPACK routine for the eigenvalue
+//                     problems of isometric and symmetric
+//                     moves, see diagHermitian (default
+//                     "dsyevr", which is several times faster
+//                     than dsyev on these dense spectra)
+//  "Boundary"       - initial edges: "Free" (default) sums
+//                     over the zero-QN states of each leg of T,
+//                     "Fixed" uses its first such state
+//  "MaxIter"        - maximum number of steps of run()
+//                     (default 500)
+//  "MinIter"        - minimum number of steps of run()
+//                     (default 4)
+//  "ConvergenceTol" - run() stops once the corner spectra
+//                     change by less than this (default 1E-10)
+//  "Quiet"          - if false, run() prints each step
+//                     (default true)
+//
+class CTMRG
+    {
+    public:
+
+    enum CornerPos { UL = 0, UR = 1, DR = 2, DL = 3 };
+    enum Side { Up = 0, Right = 1, Down = 2, Left = 3 };
+
+    private:
+
+    ITensor T_;
+    //Legs of T facing each side
+    std::array<Index,4> t_;
+    //Bond indices of the environment on each side
+    std::array<Index,4> x_;
+    std::array<ITensor,4> C_;
+    std::array<ITensor,4> E_;
+    //Normalized corner spectra of the last step
+    std::array<Vector,4> spec_;
+    Args args_;
+    int maxdim_ = 32;
+    Real cutoff_ = 1E-12;
+    std::string eigmethod_ = "dsyevr";
+    bool symmetric_ = false;
+    bool oblique_ = false;
+    Real truncerr_ = 0.;
+    Real change_ = 1.;
+    int nsteps_ = 0;
+
+    public:
+
+    CTMRG() { }
+
+    CTMRG(ITensor T,
+          Index const& h,
+          Index const& v,
+          Args const& args = Args::global());
+
+    //Performs a single step (moves in all four directions)
+    //and returns the change of the corner spectra
+    Real
+    step();
+
+    //Steps until the corner spectra converge or "MaxIter"
+    //is reached (arguments override those given to the
+    //constructor). Returns the number of steps done.
+    int
+    run(Args const& args = Args::global());
+
+    ITensor const&
+    T() const { return T_; }
+
+    ITensor const&
+    corner(CornerPos c) const { return C_.at(c); }
+
+    ITensor const&
+    edge(Side s) const { return E_.at(s); }
+
+    //Bond index of the environment on side s
+    Index const&
+    link(Side s) const { return x_.at(s); }
+
+    //Steps done so far
+    int
+    nsteps() const { return nsteps_; }
+
+    //Change of the corner spectra during the last step
+    Real
+    change() const { return change_; }
+
+    //Largest truncation error of the last step
+    Real
+    truncerr() const { return truncerr_; }
+
+    //Largest bond dimension of the environment
+    long
+    maxLinkDim() const;
+
+    //Singular values of corner c, normalized to sum to 1
+    Vector const&
+    cornerSpectrum(CornerPos c) const { return spec_.at(c); }
+
+    //Contraction of the environment with X in place of the
+    //tensor T (X must have the indices of T)
+    Cplx
+    contractC(ITensor const& X) const;
+
+    //Partition function per site
+    //kappa = Z(T)*Z(corners)/(Z(rows)*Z(columns))
+    Real
+    kappa() const;
+
+    //Expectation value <X> = Z(X)/Z(T)
+    Real
+    expect(ITensor const& X) const { return std::real(expectC(X)); }
+
+    Cplx
+    expectC(ITensor const& X) const { return contractC(X)/contractC(T_); }
+
+    private:
+
+    void
+    init(Args const& args);
+
+    //Absorbs one row or column of T into the
+    //edge on side s and renormalizes it
+    Real
+    move(Side s);
+
+    Real
+    symmetricStep(Vector & cspec);
+
+    void
+    updateSpectra(std::array<Vector,4> && spec);
+    };
+
+//
+// Double layer tensor of the norm network of a PEPS
+// tensor A, which has the legs h,h',v,v' of T above plus
+// physical indices. Returns T = A*dag(A) with the pairs
+// of legs combined, and the new indices H and V such that
+// T has indices H,H',V,V'.
+//
+std::tuple<ITensor,Index,Index>
+normTensor(ITensor const& A,
+           Index const& h,
+           Index const& v);
+
+} //namespace itensor
+
+#endif
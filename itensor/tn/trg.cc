@@ -0,0 +1,242 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "itensor/tn/trg.h"
+#include "itensor/util/cputime.h"
+
+namespace itensor {
+
+//Trace of T(h,h',v,v') over both pairs of legs,
+//for h and v as they appear on T
+Cplx static
+traceHV(ITensor const& T,
+        Index const& h,
+        Index const& v)
+    {
+    auto tr = T*delta(dag(h),prime(h));
+    tr *= delta(dag(v),prime(v));
+    return eltC(tr);
+    }
+
+TRG::
+TRG(ITensor T,
+    Index const& h,
+    Index const& v,
+    Args const& args)
+  : T_(std::move(T))
+    {
+    if(order(T_) != 4
+       || !hasIndex(T_,h) || !hasIndex(T_,prime(h))
+       || !hasIndex(T_,v) || !hasIndex(T_,prime(v)))
+        {
+        Error("TRG: T must have indices h, h', v and v'");
+        }
+    for(auto& i : inds(T_))
+        {
+        if(i == h) h_ = i;
+        if(i == v) v_ = i;
+        }
+
+    auto method = args.getString("Method","TRG");
+    if(method == "HOTRG") hotrg_ = true;
+    else if(method != "TRG") Error("TRG: Method '" + method + "' not recognized");
+    nscales_ = args.getInt("NScales",nscales_);
+    quiet_ = args.getBool("Quiet",quiet_);
+    svdargs_ = Args("MaxDim",args.getInt("MaxDim",16),
+                    "Cutoff",args.getReal("Cutoff",0.),
+                    "SVDMethod",args.getString("SVDMethod","randomized"),
+                    "Oversample",args.getInt("Oversample",10),
+                    "PowerIter",args.getInt("PowerIter",2));
+
+    auto nrm = norm(T_);
+    if(nrm == 0.) Error("TRG: T is zero");
+    T_ /= nrm;
+    lognorm_ = std::log(nrm);
+    }
+
+Real TRG::
+logZ() const
+    {
+    auto sites = std::pow(2.,scales_.size());
+    return lognorm_ + std::log(std::abs(traceHV(T_,h_,v_)))/sites;
+    }
+
+Real TRG::
+step()
+    {
+    auto timer = cpu_time();
+    auto sc = TRGScale();
+    sc.scale = scales_.size()+1;
+    if(!hotrg_)             sc.truncerr = trgStep();
+    else if(sc.scale%2 == 1) sc.truncerr = hotrgStep(h_,v_,"TRG,H");
+    else                    sc.truncerr = hotrgStep(v_,h_,"TRG,V");
+
+    //Each tensor now stands for 2^scale sites
+    auto nrm = norm(T_);
+    if(nrm == 0.) Error("TRG: coarse-grained tensor is zero");
+    T_ /= nrm;
+    lognorm_ += std::log(nrm)/std::pow(2.,sc.scale);
+
+    sc.maxdim = std::max(dim(h_),dim(v_));
+    scales_.push_back(sc);
+    auto& last = scales_.back();
+    last.logZ = logZ();
+    last.time = timer.sincemark().wall;
+    return last.logZ;
+    }
+
+Real TRG::
+run(Args const& args)
+    {
+    auto nscales = args.getInt("NScales",nscales_);
+    auto quiet = args.getBool("Quiet",quiet_);
+    for(int n = 0; n < nscales; ++n)
+        {
+        step();
+        if(!quiet)
+            {
+            auto& sc = scales_.back();
+            printfln("%s scale %d: logZ = %.12f, truncerr = %.3E, maxdim = %d, time = %.3fs",
+                     hotrg_ ? "HOTRG" : "TRG",sc.scale,sc.logZ,sc.truncerr,sc.maxdim,sc.time);
+            }
+        }
+    return logZ();
+    }
+
+//
+// Levin-Nave step: T is factored along its two diagonals,
+// as T = Fh*Fhp with Fh on the legs h',v' and Fhp on h,v,
+// and as T = Fv*Fvp with Fv on h,v' and Fvp on h',v. The
+// four halves around a plaquette of the lattice, relabeled
+// to the legs they share, make the new tensor with legs
+// a, a' (between Fh and Fhp) and b, b' (between Fv and Fvp).
+//
+Real TRG::
+trgStep()
+    {
+    auto h = h_,
+         v = v_;
+    auto hp = prime(h),
+         vp = prime(v);
+
+    auto Fh = ITensor(hp,vp),
+         Fv = ITensor(h,vp);
+    ITensor Fhp,Fvp;
+    auto spech = factor(T_,Fh,Fhp,{svdargs_,"Tags","TRG,H"});
+    auto specv = factor(T_,Fv,Fvp,{svdargs_,"Tags","TRG,V"});
+    auto a = commonIndex(Fh,Fhp),
+         b = commonIndex(Fv,Fvp);
+
+    Fh.replaceInds({hp},{h});
+    Fhp.replaceInds({a,h},{prime(a),hp});
+    Fv.replaceInds({vp},{v});
+    Fvp.replaceInds({b,v},{prime(b),vp});
+
+    auto total = sqr(norm(T_));
+    //Contracting the plaquette in pairs keeps the
+    //intermediates at chi^4 elements (left to right
+    //they reach chi^5) for the same O(chi^6) cost
+    T_ = (Fh*Fv)*(Fhp*Fvp);
+    h_ = a;
+    v_ = b;
+    auto kept = std::min(sumels(spech.eigs()),sumels(specv.eigs()));
+    return std::max(0.,1.-kept/total);
+    }
+
+//
+// HOTRG step merging T with the copy Tb below it:
+//
+//        v                      v
+//        |                      |
+//   h -- T -- h'                |
+//        |          =>  x -- [U*T*Tb*U] -- x'
+//   hb - Tb - hb'               |
+//        |                      |
+//        vb'                    v'
+//
+// The pairs h,hb and h',hb' are truncated to x, x' by the
+// isometry U onto the dominant subspace of M*dag(M), M = T*Tb,
+// on the side (left or right) with the smaller truncation
+// error. Returns this error, and updates h to x.
+//
+Real TRG::
+hotrgStep(Index & h,
+          Index const& v,
+          char const* tags)
+    {
+    auto hp = prime(h),
+         vp = prime(v);
+    auto hb = sim(h),
+         vb = sim(v);
+    auto hbp = prime(hb),
+         vbp = prime(vb);
+    auto Tb = replaceInds(T_,{h,hp,v,vp},{hb,hbp,vp,vbp});
+
+    //M*dag(M) on the legs l of T and lb of Tb, each
+    //half contracted first at a cost of O(chi^6)
+    auto vx = sim(vp);
+    auto half = [&vp,&vx](ITensor const& A, IndexSet const& l, IndexSet const& lx)
+        {
+        return A*dag(replaceInds(A,IndexSet(l,vp),IndexSet(lx,vx)));
+        };
+    auto trace = std::real(eltC(half(T_,{},{})*half(Tb,{},{})));
+
+    //rho is positive semi-definite with eigenvalues the squared
+    //singular values of M, so it is diagonalized rather than
+    //factored by svd, which would apply the cutoff to their squares
+    auto isometry = [&](Index const& l,
+                        Index const& lb,
+                        ITensor & U)
+        {
+        auto lx = sim(l),
+             lbx = sim(lb);
+        auto rho = half(T_,{l},{lx})*half(Tb,{lb},{lbx});
+        rho.replaceInds({lx,lbx},{dag(prime(l)),dag(prime(lb))});
+        ITensor D;
+        diagPosSemiDef(rho,U,D,{svdargs_,"Tags",tags});
+        //rho = dag(U)*D*prime(U), so the eigenvectors are dag(U)
+        U = dag(U);
+        return std::max(0.,1.-sumels(D)/trace);
+        };
+    ITensor UL,UR;
+    auto errL = isometry(h,hb,UL);
+    auto errR = isometry(hp,hbp,UR);
+
+    //U*dag(U) is inserted on the bonds between merged
+    //tensors, U on the side it was computed for
+    ITensor Wl,Wr;
+    Index x;
+    if(errL <= errR)
+        {
+        x = uniqueIndex(UL,{T_,Tb});
+        Wl = dag(UL);
+        Wr = replaceInds(UL,{h,hb,x},{hp,hbp,prime(x)});
+        }
+    else
+        {
+        x = uniqueIndex(UR,{T_,Tb});
+        Wl = replaceInds(UR,{hp,hbp},{h,hb});
+        Wr = dag(replaceInds(UR,{x},{prime(x)}));
+        }
+
+    //O(chi^7), with intermediates of chi^5 elements
+    T_ = ((Wl*T_)*Tb)*Wr;
+    T_.replaceInds({vbp},{vp});
+
+    for(auto& i : inds(T_)) if(i == x) h = i;
+    return std::min(errL,errR);
+    }
+
+} //namespace itensor
@@ -0,0 +1,139 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_TRG_H
+#define __ITENSOR_TRG_H
+
+#include "itensor/decomp.h"
+
+namespace itensor {
+
+//
+// Tensor renormalization group for infinite square
+// lattice networks made of a single tensor T(h,h',v,v'),
+// with the same conventions as CTMRG (see ctmrg.h):
+// h, h' are the left and right legs of T and v, v' its
+// up and down legs. T may have QNs (for example Z2 or
+// U(1) symmetric models), in which case it is coarse
+// grained block by block.
+//
+// Each scale halves the number of tensors, either by
+// the TRG of Levin and Nave (PRL 99, 120601 (2007)),
+// splitting T in two along both diagonals and contracting
+// the four halves around a plaquette, or by HOTRG (Xie et
+// al., PRB 86, 045139 (2012)), merging two neighboring
+// tensors with an isometry, alternating between the
+// vertical and horizontal directions. The costs are
+// O(chi^6) per scale for TRG and O(chi^7) for HOTRG.
+//
+// The truncated decompositions of TRG use the randomized
+// SVD of svd(...) ("SVDMethod","randomized"), which only
+// computes the chi largest singular values. HOTRG finds
+// its isometries with diagPosSemiDef of the
+// chi^2 x chi^2 matrices M*dag(M).
+//
+// Named arguments:
+//  "Method"     - "TRG" (default) or "HOTRG"
+//  "MaxDim"     - maximum bond dimension chi (default 16)
+//  "Cutoff"     - truncation error cutoff (default 0)
+//  "SVDMethod"  - "randomized" (default), or a method of a
+//                 full SVD such as "gesdd" (TRG only)
+//  "Oversample" - extra random vectors of the randomized
+//                 SVD (default 10)
+//  "PowerIter"  - power iterations of the randomized SVD
+//                 (default 2)
+//  "NScales"    - number of scales done by run() (default 20)
+//  "Quiet"      - if false, run() prints each scale
+//                 (default true)
+//
+
+//Results of a single coarse-graining scale
+struct TRGScale
+    {
+    int scale = 0;
+    //Estimate of ln(Z)/N after this scale
+    Real logZ = 0.;
+    Real truncerr = 0.;
+    long maxdim = 0;
+    //Wall time of this scale in seconds
+    Real time = 0.;
+    };
+
+class TRG
+    {
+    ITensor T_;
+    Index h_,
+          v_;
+    Args svdargs_;
+    bool hotrg_ = false;
+    int nscales_ = 20;
+    bool quiet_ = true;
+    //Sum of the logs of the normalizations,
+    //weighted by the sites per tensor
+    Real lognorm_ = 0.;
+    std::vector<TRGScale> scales_;
+
+    public:
+
+    TRG() { }
+
+    TRG(ITensor T,
+        Index const& h,
+        Index const& v,
+        Args const& args = Args::global());
+
+    //Coarse grains by one scale and returns
+    //the estimate of ln(Z)/N
+    Real
+    step();
+
+    //Does "NScales" scales (arguments override those
+    //given to the constructor) and returns ln(Z)/N
+    Real
+    run(Args const& args = Args::global());
+
+    //Coarse-grained tensor, normalized, and its legs
+    ITensor const&
+    T() const { return T_; }
+
+    Index const&
+    h() const { return h_; }
+
+    Index const&
+    v() const { return v_; }
+
+    //Free energy per site ln(Z)/N estimated
+    //by the last scale
+    Real
+    logZ() const;
+
+    //Scales done so far
+    std::vector<TRGScale> const&
+    scales() const { return scales_; }
+
+    private:
+
+    Real
+    trgStep();
+
+    Real
+    hotrgStep(Index & h,
+              Index const& v,
+              char const* tags);
+    };
+
+} //namespace itensor
+
+#endif
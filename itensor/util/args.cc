@@ -16,6 +16,7 @@
 #include <cerrno>
 #include <algorithm>
 #include <iostream>
+#include <sstream>
 #include "itensor/util/args.h"
 #include "itensor/util/error.h"
 #include "itensor/util/readwrite.h"
@@ -465,6 +466,16 @@ write(std::ostream& s) const
     itensor::write(s,vals_);
     }
 
+std::string Args::
+key() const
+    {
+    //The common case of no arguments needs no allocation
+    if(vals_.empty()) return std::string();
+    std::ostringstream s;
+    write(s);
+    return s.str();
+    }
+
 Args
 operator+(Args args, Args const& other)
     {
@@ -182,6 +182,12 @@ class Args
     void
     write(std::ostream& s) const;
 
+    // Exact serialization of the names and values of
+    // all arguments, e.g. for use as a cache key
+    // (empty if no arguments are defined)
+    std::string
+    key() const;
+
     private:
 
     void
@@ -0,0 +1,198 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include "itensor/util/compress.h"
+#include "itensor/util/error.h"
+
+namespace itensor {
+
+//
+// Format: a list of sequences, each made of
+//   token       : 4 bits literal length, 4 bits match length - 4
+//                 (15 means more length bytes follow)
+//   [lit. len]  : bytes of 255 ending with a byte < 255
+//   literals
+//   offset      : 2 bytes, little endian (absent in the last sequence)
+//   [match len] : bytes of 255 ending with a byte < 255
+//
+static size_t const lz_min_match = 4;
+static size_t const lz_max_offset = 65535;
+static int const lz_hash_log = 14;
+
+uint32_t static
+read32(char const* p)
+    {
+    uint32_t v;
+    std::memcpy(&v,p,4);
+    return v;
+    }
+
+uint32_t static
+lzHash(uint32_t v)
+    {
+    return (v*2654435761u) >> (32-lz_hash_log);
+    }
+
+void static
+putLength(std::string & out, size_t len)
+    {
+    while(len >= 255)
+        {
+        out.push_back(char(255));
+        len -= 255;
+        }
+    out.push_back(char(len));
+    }
+
+void static
+putSequence(std::string & out,
+            char const* lit, size_t nlit,
+            size_t offset, size_t mlen)
+    {
+    auto ml = (mlen > 0) ? mlen-lz_min_match : 0;
+    auto token = (std::min<size_t>(nlit,15) << 4) | std::min<size_t>(ml,15);
+    out.push_back(char(token));
+    if(nlit >= 15) putLength(out,nlit-15);
+    out.append(lit,nlit);
+    if(mlen == 0) return;
+    out.push_back(char(offset & 0xFF));
+    out.push_back(char(offset >> 8));
+    if(ml >= 15) putLength(out,ml-15);
+    }
+
+std::string
+lzCompress(char const* in, size_t n)
+    {
+    auto out = std::string();
+    out.reserve(n+n/255+16);
+    auto table = std::vector<int64_t>(size_t(1) << lz_hash_log,-1);
+    size_t anchor = 0,
+           ip = 0;
+    while(ip+lz_min_match <= n)
+        {
+        auto v = read32(in+ip);
+        auto& slot = table[lzHash(v)];
+        auto ref = slot;
+        slot = ip;
+        if(ref >= 0 && ip-ref <= lz_max_offset && read32(in+ref) == v)
+            {
+            auto len = lz_min_match;
+            while(ip+len < n && in[ref+len] == in[ip+len]) ++len;
+            putSequence(out,in+anchor,ip-anchor,ip-ref,len);
+            ip += len;
+            anchor = ip;
+            }
+        else
+            {
+            //Move faster through incompressible data
+            ip += 1+((ip-anchor) >> 6);
+            }
+        }
+    if(anchor < n) putSequence(out,in+anchor,n-anchor,0,0);
+    return out;
+    }
+
+size_t static
+getLength(unsigned char const*& p, unsigned char const* end)
+    {
+    size_t len = 0;
+    unsigned char b = 255;
+    while(b == 255)
+        {
+        if(p >= end) throw ITError("lzDecompress: corrupted input");
+        b = *p++;
+        len += b;
+        }
+    return len;
+    }
+
+void
+lzDecompress(char const* in, size_t nin,
+             char* out, size_t nout)
+    {
+    auto p = reinterpret_cast<unsigned char const*>(in);
+    auto end = p+nin;
+    size_t op = 0;
+    while(p < end)
+        {
+        auto token = *p++;
+        size_t nlit = token >> 4;
+        if(nlit == 15) nlit += getLength(p,end);
+        if(nlit > size_t(end-p) || op+nlit > nout) throw ITError("lzDecompress: corrupted input");
+        std::memcpy(out+op,p,nlit);
+        p += nlit;
+        op += nlit;
+        if(p >= end) break;
+
+        if(end-p < 2) throw ITError("lzDecompress: corrupted input");
+        size_t offset = p[0] | (size_t(p[1]) << 8);
+        p += 2;
+        size_t mlen = token & 15;
+        if(mlen == 15) mlen += getLength(p,end);
+        mlen += lz_min_match;
+        if(offset == 0 || offset > op || op+mlen > nout) throw ITError("lzDecompress: corrupted input");
+        //Byte by byte since source and destination may overlap
+        auto src = out+op-offset;
+        for(size_t k = 0; k < mlen; ++k) out[op+k] = src[k];
+        op += mlen;
+        }
+    if(op != nout) throw ITError("lzDecompress: size of decompressed data does not match");
+    }
+
+void
+byteShuffle(char const* in, size_t n, size_t elsize, char* out)
+    {
+    auto nel = n/elsize;
+    for(size_t i = 0; i < nel; ++i)
+    for(size_t b = 0; b < elsize; ++b)
+        {
+        out[b*nel+i] = in[i*elsize+b];
+        }
+    std::memcpy(out+nel*elsize,in+nel*elsize,n-nel*elsize);
+    }
+
+void
+byteUnshuffle(char const* in, size_t n, size_t elsize, char* out)
+    {
+    auto nel = n/elsize;
+    for(size_t b = 0; b < elsize; ++b)
+    for(size_t i = 0; i < nel; ++i)
+        {
+        out[i*elsize+b] = in[b*nel+i];
+        }
+    std::memcpy(out+nel*elsize,in+nel*elsize,n-nel*elsize);
+    }
+
+std::string
+shuffleCompress(char const* in, size_t n, size_t elsize)
+    {
+    auto buf = std::vector<char>(n);
+    byteShuffle(in,n,elsize,buf.data());
+    return lzCompress(buf.data(),n);
+    }
+
+void
+shuffleDecompress(char const* in, size_t nin,
+                  char* out, size_t nout, size_t elsize)
+    {
+    auto buf = std::vector<char>(nout);
+    lzDecompress(in,nin,buf.data(),nout);
+    byteUnshuffle(buf.data(),nout,elsize,out);
+    }
+
+} //namespace itensor
@@ -0,0 +1,62 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_COMPRESS_H_
+#define __ITENSOR_COMPRESS_H_
+
+#include <string>
+
+namespace itensor {
+
+//
+// Fast lossless compression of byte arrays with a
+// simple LZ77 coder (sequences of literals and
+// matches within the last 64kB, as in LZ4).
+// Decompression needs the original size.
+//
+std::string
+lzCompress(char const* in, size_t n);
+
+void
+lzDecompress(char const* in, size_t nin,
+             char* out, size_t nout);
+
+//
+// Reorders bytes of an array of elements of size
+// elsize so that byte b of every element is stored
+// together (bytes not filling a whole element
+// are kept at the end). Exponents and leading
+// bytes of floating point numbers become long
+// repetitive runs which compress well.
+//
+void
+byteShuffle(char const* in, size_t n, size_t elsize, char* out);
+
+void
+byteUnshuffle(char const* in, size_t n, size_t elsize, char* out);
+
+//
+// Byte shuffle followed by lzCompress
+//
+std::string
+shuffleCompress(char const* in, size_t n, size_t elsize);
+
+void
+shuffleDecompress(char const* in, size_t nin,
+                  char* out, size_t nout, size_t elsize);
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,276 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include "itensor/util/contractstats.h"
+#include "itensor/util/instrument.h"
+#include "itensor/util/print.h"
+#include "itensor/util/error.h"
+#include "itensor/util/iterate.h"
+
+namespace itensor {
+
+using std::string;
+using std::vector;
+
+bool
+operator<(ContractShape const& a, ContractShape const& b)
+    {
+    return std::tie(a.kind,a.m,a.k,a.n,a.permA,a.permB,a.permC,a.cplxA,a.cplxB)
+         < std::tie(b.kind,b.m,b.k,b.n,b.permA,b.permB,b.permC,b.cplxA,b.cplxB);
+    }
+
+double
+contractFlops(ContractShape const& s)
+    {
+    //A complex times complex multiply-add is 8 real FLOPs,
+    //real times complex is done as two real GEMMs
+    auto f = 2.*s.m*s.k*s.n;
+    if(s.cplxA && s.cplxB) return 4*f;
+    if(s.cplxA || s.cplxB) return 2*f;
+    return f;
+    }
+
+double
+contractBytes(ContractShape const& s)
+    {
+    auto ea = s.cplxA ? 16. : 8.,
+         eb = s.cplxB ? 16. : 8.,
+         ec = (s.cplxA || s.cplxB) ? 16. : 8.;
+    auto a = ea*s.m*s.k,
+         b = eb*s.k*s.n,
+         c = ec*s.m*s.n;
+    //Each permutation reads the tensor and writes a copy
+    return a+b+c + (s.permA ? 2*a : 0.) + (s.permB ? 2*b : 0.) + (s.permC ? 2*c : 0.);
+    }
+
+string ContractClass::
+bound() const
+    {
+    auto overhead = time-permute_time-gemm_time;
+    if(permute_time >= gemm_time && permute_time >= overhead) return "perm";
+    //GEMMs this small are dominated by call overhead
+    if(overhead >= gemm_time || (calls > 0 && flops/calls < 1E4)) return "latency";
+    return "gemm";
+    }
+
+namespace {
+
+struct ThreadContractStats
+    {
+    std::map<ContractShape,ContractClass> classes;
+    };
+
+} //namespace
+
+ThreadRegistry<ThreadContractStats> static&
+contractStatsState()
+    {
+    static ThreadRegistry<ThreadContractStats> st;
+    return st;
+    }
+
+static thread_local char const* contract_stats_kind = "tensor";
+
+ContractStatsKind::
+ContractStatsKind(char const* kind)
+  : prev_(contract_stats_kind)
+    {
+    contract_stats_kind = kind;
+    }
+
+ContractStatsKind::
+~ContractStatsKind()
+    {
+    contract_stats_kind = prev_;
+    }
+
+char const*
+contractStatsKind() { return contract_stats_kind; }
+
+ContractStats&
+contractStats()
+    {
+    static ContractStats S;
+    return S;
+    }
+
+void ContractStats::
+record(ContractShape const& shape,
+       double time,
+       double permute_time,
+       double gemm_time)
+    {
+    auto& c = contractStatsState().local().classes[shape];
+    if(c.calls == 0) c.shape = shape;
+    c.calls += 1;
+    c.flops += contractFlops(shape);
+    c.bytes += contractBytes(shape);
+    c.time += time;
+    c.permute_time += permute_time;
+    c.gemm_time += gemm_time;
+    }
+
+void ContractStats::
+reset()
+    {
+    auto& st = contractStatsState();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    for(auto& ts : st.data) ts->classes.clear();
+    }
+
+void static
+add(ContractClass & to, ContractClass const& c)
+    {
+    to.calls += c.calls;
+    to.flops += c.flops;
+    to.bytes += c.bytes;
+    to.time += c.time;
+    to.permute_time += c.permute_time;
+    to.gemm_time += c.gemm_time;
+    }
+
+vector<ContractClass> ContractStats::
+classes() const
+    {
+    auto& st = contractStatsState();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    auto merged = std::map<ContractShape,ContractClass>();
+    for(auto& ts : st.data)
+    for(auto& sc : ts->classes)
+        {
+        auto& c = merged[sc.first];
+        c.shape = sc.first;
+        add(c,sc.second);
+        }
+    auto res = vector<ContractClass>();
+    res.reserve(merged.size());
+    for(auto& sc : merged) res.push_back(sc.second);
+    std::sort(res.begin(),res.end(),[](auto& a, auto& b) { return a.time > b.time; });
+    return res;
+    }
+
+ContractClass ContractStats::
+total() const
+    {
+    auto t = ContractClass();
+    t.shape.kind = "total";
+    for(auto& c : classes()) add(t,c);
+    return t;
+    }
+
+string static
+permString(ContractShape const& s)
+    {
+    auto p = string();
+    if(s.permA) p += "A";
+    if(s.permB) p += "B";
+    if(s.permC) p += "C";
+    return p.empty() ? "-" : p;
+    }
+
+string static
+typeString(ContractShape const& s)
+    {
+    return string(s.cplxA ? "C" : "R") + (s.cplxB ? "C" : "R");
+    }
+
+void ContractStats::
+print(std::ostream& s, long max_classes) const
+    {
+    auto cls = classes();
+    auto tot = ContractClass();
+    for(auto& c : cls) add(tot,c);
+
+    s << "-----------------------------------------------------\n";
+    s << format("Contractions: %d calls in %d shape classes, %.4f s, %.3f GFLOP/s, %.2f%% of time permuting\n",
+                tot.calls,cls.size(),tot.time,tot.gflops(),
+                tot.time > 0 ? 100*tot.permute_time/tot.time : 0.);
+    s << format("%-7s %8s %8s %8s %4s %2s %9s %10s %6s %8s %8s %6s  %s\n",
+                "kind","m","k","n","perm","ty","calls","time (s)","%time",
+                "GFLOP/s","FLOP/B","%perm","bound");
+    for(auto i : range(std::min<long>(max_classes,cls.size())))
+        {
+        auto& c = cls[i];
+        auto& sh = c.shape;
+        s << format("%-7s %8d %8d %8d %4s %2s %9d %10.4f %6.2f %8.3f %8.2f %6.2f  %s\n",
+                    sh.kind,sh.m,sh.k,sh.n,permString(sh),typeString(sh),c.calls,c.time,
+                    tot.time > 0 ? 100*c.time/tot.time : 0.,c.gflops(),c.intensity(),
+                    c.time > 0 ? 100*c.permute_time/c.time : 0.,c.bound());
+        }
+    if(long(cls.size()) > max_classes)
+        {
+        s << format("(%d more shape classes)\n",long(cls.size())-max_classes);
+        }
+
+    //Histogram by decades of FLOPs per call
+    auto hist = std::map<int,ContractClass>();
+    for(auto& c : cls)
+        {
+        auto fpc = c.flops/c.calls;
+        auto decade = fpc >= 1. ? int(std::floor(std::log10(fpc))) : 0;
+        add(hist[decade],c);
+        }
+    s << format("\n%-16s %9s %10s %6s %8s %8s %6s\n",
+                "FLOPs per call","calls","time (s)","%time","GFLOP/s","FLOP/B","%perm");
+    for(auto& h : hist)
+        {
+        auto& c = h.second;
+        s << format("[1E%02d,1E%02d) %4s %9d %10.4f %6.2f %8.3f %8.2f %6.2f\n",
+                    h.first,h.first+1,"",c.calls,c.time,
+                    tot.time > 0 ? 100*c.time/tot.time : 0.,c.gflops(),c.intensity(),
+                    c.time > 0 ? 100*c.permute_time/c.time : 0.);
+        }
+    s << "-----------------------------------------------------";
+    }
+
+std::ostream&
+operator<<(std::ostream& s, ContractStats const& S)
+    {
+    S.print(s);
+    return s;
+    }
+
+void ContractStats::
+writeCSV(string const& fname) const
+    {
+    std::ofstream f(fname.c_str());
+    if(!f.good()) Error("ContractStats: couldn't open file " + fname);
+    f << "kind,m,k,n,permA,permB,permC,cplxA,cplxB,calls,flops,bytes,time_s,permute_s,gemm_s,gflops,bound\n";
+    for(auto& c : classes())
+        {
+        auto& sh = c.shape;
+        f << format("%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.6E,%.6E,%.9f,%.9f,%.9f,%.6f,%s\n",
+                    sh.kind,sh.m,sh.k,sh.n,int(sh.permA),int(sh.permB),int(sh.permC),
+                    int(sh.cplxA),int(sh.cplxB),c.calls,c.flops,c.bytes,
+                    c.time,c.permute_time,c.gemm_time,c.gflops(),c.bound());
+        }
+    }
+
+//
+// Enable logging when ITENSOR_CONTRACT_STATS is set
+// and print the report at exit
+//
+static EnvSwitch contract_stats_from_env("ITENSOR_CONTRACT_STATS",
+                                  [] { contractStatsState(); contractStats().enable(true); },
+                                  [] { std::cout << contractStats() << std::endl; });
+
+} //namespace itensor
@@ -0,0 +1,169 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_CONTRACTSTATS_H
+#define __ITENSOR_CONTRACTSTATS_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+//
+// Runtime contraction statistics
+//
+// When enabled, every tensor contraction going through
+// contract(TenRefc,Labels,...) - the dense contractions
+// and each block pair of a QDense contraction - is logged
+// with its GEMM shape (m x k times k x n), whether A, B or
+// C had to be permuted, its FLOPs, the bytes it moved and
+// the time spent permuting, in GEMM and in total.
+//
+// Calls are grouped into shape classes (kind, m, k, n,
+// permutations, real/complex) for the report, which gives
+// the achieved GFLOP/s and arithmetic intensity of each
+// class and marks those dominated by permutations ("perm")
+// or by per-call overhead ("latency").
+//
+// Off by default; enable with contractStats().enable(true)
+// or by setting the environment variable ITENSOR_CONTRACT_STATS
+// (the report is then printed at exit). While off, a
+// contraction costs one flag check.
+//
+
+namespace itensor {
+
+namespace detail {
+inline std::atomic<bool> contract_stats_on{false};
+}
+
+struct ContractShape
+    {
+    std::string kind; //"dense", "qdense", or "tensor" (direct calls)
+    long m = 0,
+         k = 0,
+         n = 0;
+    bool permA = false,
+         permB = false,
+         permC = false;
+    bool cplxA = false,
+         cplxB = false;
+    };
+
+bool
+operator<(ContractShape const& a, ContractShape const& b);
+
+struct ContractClass
+    {
+    ContractShape shape;
+    long calls = 0;
+    double flops = 0., //total over calls
+           bytes = 0.,
+           time = 0.,  //seconds
+           permute_time = 0.,
+           gemm_time = 0.;
+
+    double
+    gflops() const { return time > 0. ? 1E-9*flops/time : 0.; }
+
+    //FLOPs per byte moved
+    double
+    intensity() const { return bytes > 0. ? flops/bytes : 0.; }
+
+    //"perm", "latency" or "gemm": where most of the time went
+    std::string
+    bound() const;
+    };
+
+class ContractStats
+    {
+    public:
+
+    bool
+    enabled() const { return detail::contract_stats_on.load(std::memory_order_relaxed); }
+
+    void
+    enable(bool val) { detail::contract_stats_on.store(val); }
+
+    void
+    reset();
+
+    //Called by contract for each logged contraction
+    void
+    record(ContractShape const& shape,
+           double time,
+           double permute_time,
+           double gemm_time);
+
+    //All shape classes, largest total time first
+    std::vector<ContractClass>
+    classes() const;
+
+    //Totals over all classes
+    ContractClass
+    total() const;
+
+    //
+    // Reports: should be made when no other
+    // thread is contracting
+    //
+
+    //One line per shape class
+    void
+    writeCSV(std::string const& fname) const;
+
+    //Report of the max_classes shape classes with the largest
+    //total time and a histogram of all calls by FLOPs per call
+    void
+    print(std::ostream& s, long max_classes = 25) const;
+    };
+
+ContractStats&
+contractStats();
+
+std::ostream&
+operator<<(std::ostream& s, ContractStats const& S);
+
+//
+// Sets the kind of contraction logged by this
+// thread for the lifetime of the object
+//
+class ContractStatsKind
+    {
+    char const* prev_ = nullptr;
+    public:
+
+    explicit
+    ContractStatsKind(char const* kind);
+
+    ~ContractStatsKind();
+
+    ContractStatsKind(ContractStatsKind const&) = delete;
+    ContractStatsKind& operator=(ContractStatsKind const&) = delete;
+    };
+
+char const*
+contractStatsKind();
+
+//FLOPs and bytes moved of a contraction of the given shape
+double
+contractFlops(ContractShape const& s);
+
+double
+contractBytes(ContractShape const& s);
+
+} //namespace itensor
+
+#endif
@@ -49,21 +49,50 @@ namespace h5::array_interface {
   //                    write
   //--------------------------------------------------------
 
-  void write(group g, std::string const &name, h5_array_view const &v, bool compress) {
+  // Default chunk size in bytes when none is given.
+  // Chunks must be smaller than 4GB, and small chunks
+  // keep reads of parts of a dataset cheap.
+  constexpr hsize_t default_chunk_bytes = hsize_t(1) << 20;
 
-    g.unlink(name);
+  // zstd filter id registered with the HDF Group
+  constexpr H5Z_filter_t zstd_filter_id = 32015;
+
+  proplist make_dataset_proplist(h5_array_view const &v, compression const &c) {
+
+    if (c.kind == compression::none or v.rank() == 0) return H5P_DEFAULT;
 
-    // Some properties for the dataset : add compression
-    proplist cparms = H5P_DEFAULT;
-    if (compress and (v.rank() != 0)) {
-      int n_dims = v.rank();
-      std::vector<hsize_t> chunk_dims(n_dims);
-      for (int i = 0; i < v.rank(); ++i) chunk_dims[i] = std::max(v.slab.count[i], hsize_t{1});
-      cparms = H5Pcreate(H5P_DATASET_CREATE);
-      H5Pset_chunk(cparms, n_dims, chunk_dims.data());
-      // FIXME : OLD COMMIT
-      H5Pset_deflate(cparms, 8);
+    auto n_dims = v.rank();
+    v_t chunk_dims(n_dims);
+    hsize_t row_bytes = H5Tget_size(v.ty);
+    for (int i = 0; i < n_dims; ++i) {
+      chunk_dims[i] = std::max(v.slab.count[i], hsize_t{1});
+      if (i > 0) row_bytes *= chunk_dims[i];
     }
+    auto rows = c.chunk;
+    if (rows == 0) rows = std::max(default_chunk_bytes / row_bytes, hsize_t{1});
+    chunk_dims[0] = std::min(chunk_dims[0], rows);
+
+    proplist cparms = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(cparms, n_dims, chunk_dims.data());
+    if (c.kind == compression::deflate) {
+      H5Pset_shuffle(cparms);
+      H5Pset_deflate(cparms, c.level);
+    } else if (c.kind == compression::zstd) {
+      if (H5Zfilter_avail(zstd_filter_id) <= 0) throw std::runtime_error("The zstd HDF5 filter plugin (id 32015) is not available");
+      unsigned int level = c.level;
+      H5Pset_filter(cparms, zstd_filter_id, H5Z_FLAG_MANDATORY, 1, &level);
+    } else if (c.kind == compression::scale_offset) {
+      H5Pset_scaleoffset(cparms, H5Z_SO_FLOAT_DSCALE, c.digits);
+    }
+    return cparms;
+  }
+
+  void write(group g, std::string const &name, h5_array_view const &v, compression const &c) {
+
+    g.unlink(name);
+
+    // Some properties for the dataset : chunking and compression
+    proplist cparms = make_dataset_proplist(v, c);
 
     // dataspace for the dataset in the file
     dataspace file_dspace = H5Screate_simple(v.slab.rank(), v.slab.count.data(), nullptr);
@@ -83,6 +112,15 @@ namespace h5::array_interface {
     if (v.is_complex) h5_write_attribute(ds, "__complex__", "1");
   }
 
+  void write(group g, std::string const &name, h5_array_view const &v, bool compress) {
+    compression c;
+    if (compress) {
+      c.kind  = compression::deflate;
+      c.level = 8;
+    }
+    write(g, name, v, c);
+  }
+
   //-------------------------------------------------------------
 
   void write_attribute(hid_t id, std::string const &name, h5_array_view v) {
@@ -146,6 +184,34 @@ namespace h5::array_interface {
     }
   }
 
+  //--------------------------------------------------------
+
+  void read_slice(group g, std::string const &name, h5_array_view v, hsize_t offset, hsize_t count) {
+
+    dataset ds             = g.open_dataset(name);
+    dataspace file_d_space = H5Dget_space(ds);
+    auto lt                = get_h5_lengths_type(g, name);
+
+    if (H5Tequal(v.ty, lt.ty) <= 0)
+      throw std::runtime_error("h5 read. Type mismatch : expecting a " + get_name_of_h5_type(v.ty)
+                               + " while the array stored in the hdf5 file has type " + get_name_of_h5_type(lt.ty));
+    if (lt.rank() != v.rank() or lt.rank() == 0)
+      throw std::runtime_error("h5 read_slice. Rank mismatch reading dataset " + name);
+    if (offset + count > lt.lengths[0])
+      throw std::runtime_error("h5 read_slice. Rows out of range reading dataset " + name);
+    if (count == 0) return;
+
+    v_t file_offset(lt.rank(), 0), file_count = lt.lengths;
+    file_offset[0] = offset;
+    file_count[0]  = count;
+    herr_t err = H5Sselect_hyperslab(file_d_space, H5S_SELECT_SET, file_offset.data(), nullptr, file_count.data(), nullptr);
+    if (err < 0) throw std::runtime_error("Cannot set hyperslab");
+
+    dataspace mem_d_space = make_mem_dpace(v);
+    err = H5Dread(ds, v.ty, mem_d_space, file_d_space, H5P_DEFAULT, v.start);
+    if (err < 0) throw std::runtime_error("Error reading slice of the dataset " + name + " in the group" + g.name());
+  }
+
   //-------------------------------------------------------------
 
   void read_attribute(hid_t id, std::string const &name, h5_array_view v) {
@@ -70,12 +70,36 @@ namespace h5::array_interface {
   // Retrieve lengths and hdf5 type from a file
   h5_lengths_type get_h5_lengths_type(group g, std::string const &name);
 
+  // Storage layout and filters of a written dataset.
+  // none is a contiguous dataset; the other kinds use chunks of
+  // chunk rows (first dimension) of the array, or a bounded
+  // automatic size if chunk == 0.
+  //   deflate      : lossless zlib compression at the given level
+  //   zstd         : lossless, needs the zstd HDF5 filter plugin (id 32015)
+  //   scale_offset : lossy, keeps digits decimal digits, i.e. the
+  //                  absolute error is at most 0.5*10^-digits
+  struct compression {
+    enum kind_t { none, deflate, zstd, scale_offset };
+    kind_t kind   = none;
+    int level     = 1;
+    int digits    = 12;
+    hsize_t chunk = 0;
+  };
+
   // Write the view of the array to the group
+  void write(group g, std::string const &name, h5_array_view const &a, compression const &c);
+
+  // Same as above with deflate compression (level 8) if compress is true
   void write(group g, std::string const &name, h5_array_view const &a, bool compress);
 
   // EXPLAIN
   void read(group g, std::string const &name, h5_array_view v, h5_lengths_type lt);
 
+  // Read only the rows [offset,offset+count) of the first dimension
+  // of the dataset into v, which must have count rows.
+  // For chunked datasets only the chunks overlapping the rows are read.
+  void read_slice(group g, std::string const &name, h5_array_view v, hsize_t offset, hsize_t count);
+
   // Write as attribute
   void write_attribute(hid_t id, std::string const &name, h5_array_view v);
 
@@ -24,7 +24,11 @@
 
 #ifdef ITENSOR_USE_HDF5
 
+#include <cmath>
 #include "itensor/util/h5/h5.hpp"
+#include "itensor/util/args.h"
+#include "itensor/util/error.h"
+#include "itensor/util/print.h"
 
 namespace itensor {
 
@@ -46,6 +50,58 @@ h5_open(std::string const& name, char mode)
     return h5::file(name.c_str(),mode);
     }
 
+//
+// Dataset compression used when writing tensor data,
+// read from the arguments:
+//    "Compression": "None" (default, contiguous dataset),
+//                   "Deflate", "Zstd" (lossless) or
+//                   "Lossy" (HDF5 scale-offset filter)
+//    "CompressionLevel": level of "Deflate" (default 1) or "Zstd" (default 3)
+//    "LossyDigits": decimal digits kept by "Lossy" (default 12)
+//    "ChunkSize": elements per chunk (default chosen by caller)
+//
+h5::array_interface::compression inline
+h5_compression(Args const& args,
+               unsigned long long chunk = 0)
+    {
+    using compression = h5::array_interface::compression;
+    auto c = compression();
+    auto kind = args.getString("Compression","None");
+    if(kind == "None")         c.kind = compression::none;
+    else if(kind == "Deflate") c.kind = compression::deflate;
+    else if(kind == "Zstd")    c.kind = compression::zstd;
+    else if(kind == "Lossy")   c.kind = compression::scale_offset;
+    else Error("Unknown value \"" + kind + "\" for Compression, expected None, Deflate, Zstd or Lossy");
+    c.level = args.getInt("CompressionLevel",c.kind == compression::zstd ? 3 : 1);
+    c.digits = args.getInt("LossyDigits",12);
+    c.chunk = chunk;
+    if(args.defined("ChunkSize"))
+        {
+        //Read as a Real so that large sizes are not narrowed
+        auto n = args.getReal("ChunkSize");
+        if(!(n > 0.) || n != std::floor(n) || n > 9007199254740992.)
+            {
+            Error(format("ChunkSize must be a positive integer, got %.17g",n));
+            }
+        c.chunk = static_cast<unsigned long long>(n);
+        }
+    return c;
+    }
+
+//
+// View of n contiguous elements at p, in the
+// same layout as h5_write of a std::vector
+//
+template<typename V>
+h5::array_interface::h5_array_view
+h5_data_view(V const* p, unsigned long long n)
+    {
+    auto v = h5::array_interface::h5_array_view(h5::hdf5_type<V>(),(void*)p,1,h5::is_complex_v<V>);
+    v.slab.count[0] = n;
+    v.L_tot[0] = n;
+    return v;
+    }
+
 }
 
 #endif //ITENSOR_USE_HDF5
@@ -0,0 +1,95 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_INSTRUMENT_H
+#define __ITENSOR_INSTRUMENT_H
+
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// Shared plumbing of the instrumentation tools
+// (Profiler, ContractStats) which record from many
+// threads without locking and report over all of them
+//
+
+namespace itensor {
+
+//
+// Per-thread data T of every thread that has
+// recorded, in order of first use. The registry
+// owns the data, so it outlives its thread.
+// Only one ThreadRegistry<T> may exist for a
+// given T, since local() caches the calling
+// thread's data in a thread_local per T.
+//
+template<typename T>
+struct ThreadRegistry
+    {
+    //Guards data (and may guard other shared
+    //state of the tool using the registry)
+    std::mutex mutex;
+    std::vector<std::shared_ptr<T>> data;
+
+    //Data of the calling thread, created on first use
+    T&
+    local()
+        {
+        thread_local T* t = [this]
+            {
+            std::lock_guard<std::mutex> lock(mutex);
+            data.push_back(std::make_shared<T>());
+            return data.back().get();
+            }();
+        return *t;
+        }
+    };
+
+//
+// Calls enable() if the environment variable var
+// is set, and then report() when destroyed, i.e. at
+// exit for a namespace-scope EnvSwitch. Static state
+// used by report() should be constructed by enable(),
+// so that it is destroyed after the EnvSwitch.
+//
+class EnvSwitch
+    {
+    std::function<void()> report_;
+    public:
+
+    EnvSwitch(char const* var,
+              std::function<void()> const& enable,
+              std::function<void()> report)
+        {
+        if(!std::getenv(var)) return;
+        enable();
+        report_ = std::move(report);
+        }
+
+    EnvSwitch(EnvSwitch const&) = delete;
+    EnvSwitch& operator=(EnvSwitch const&) = delete;
+
+    ~EnvSwitch()
+        {
+        if(report_) report_();
+        }
+    };
+
+} //namespace itensor
+
+#endif
@@ -0,0 +1,173 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_MAPPED_FILE_H_
+#define __ITENSOR_MAPPED_FILE_H_
+
+#include <string>
+#include <streambuf>
+#include <utility>
+#include "itensor/util/error.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace itensor {
+
+//
+// Read-only view of a whole file.
+//
+// On POSIX systems the file is memory mapped
+// (private, read-only) so pages are only read
+// from disk (or the page cache) when touched.
+// Elsewhere the file is read into memory.
+//
+class MappedFile
+    {
+    std::string fname_;
+    char const* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    std::vector<char> buf_;
+#endif
+    public:
+
+    MappedFile() { }
+
+    explicit
+    MappedFile(std::string const& fname) { open(fname); }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    MappedFile(MappedFile && other) { *this = std::move(other); }
+
+    MappedFile&
+    operator=(MappedFile && other)
+        {
+        if(this == &other) return *this;
+        close();
+        fname_ = std::move(other.fname_);
+        data_ = other.data_;
+        size_ = other.size_;
+#if defined(_WIN32)
+        buf_ = std::move(other.buf_);
+#endif
+        other.data_ = nullptr;
+        other.size_ = 0;
+        return *this;
+        }
+
+    ~MappedFile() { close(); }
+
+    void
+    open(std::string const& fname)
+        {
+        close();
+        fname_ = fname;
+#if defined(_WIN32)
+        std::ifstream s(fname.c_str(),std::ios::binary|std::ios::ate);
+        if(!s.good()) throw ITError("Couldn't open file \"" + fname + "\" for reading");
+        size_ = s.tellg();
+        buf_.resize(size_);
+        s.seekg(0);
+        s.read(buf_.data(),size_);
+        data_ = buf_.data();
+#else
+        auto fd = ::open(fname.c_str(),O_RDONLY);
+        if(fd < 0) throw ITError("Couldn't open file \"" + fname + "\" for reading");
+        struct stat st;
+        if(::fstat(fd,&st) != 0)
+            {
+            ::close(fd);
+            throw ITError("Couldn't stat file \"" + fname + "\"");
+            }
+        size_ = st.st_size;
+        if(size_ > 0)
+            {
+            auto p = ::mmap(nullptr,size_,PROT_READ,MAP_PRIVATE,fd,0);
+            if(p == MAP_FAILED)
+                {
+                ::close(fd);
+                throw ITError("Couldn't memory map file \"" + fname + "\"");
+                }
+            data_ = static_cast<char const*>(p);
+            }
+        //The mapping stays valid after closing fd
+        ::close(fd);
+#endif
+        }
+
+    void
+    close()
+        {
+#if defined(_WIN32)
+        buf_.clear();
+#else
+        if(data_) ::munmap(const_cast<char*>(data_),size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        }
+
+    explicit operator bool() const { return data_ != nullptr; }
+
+    std::string const&
+    name() const { return fname_; }
+
+    char const*
+    data() const { return data_; }
+
+    size_t
+    size() const { return size_; }
+
+    //Hint that bytes [offset,offset+len) will be read soon
+    void
+    willNeed(size_t offset, size_t len) const
+        {
+#if !defined(_WIN32)
+        if(!data_ || len == 0) return;
+        auto page = size_t(::sysconf(_SC_PAGESIZE));
+        auto start = (offset/page)*page;
+        ::madvise(const_cast<char*>(data_)+start,offset+len-start,MADV_WILLNEED);
+#endif
+        }
+    };
+
+//
+// std::streambuf reading from a fixed range of
+// memory, so the stream versions of read can be
+// used on a MappedFile without copying
+//
+class MemoryBuf : public std::streambuf
+    {
+    public:
+    MemoryBuf(char const* p, size_t size)
+        {
+        auto b = const_cast<char*>(p);
+        setg(b,b,b+size);
+        }
+    };
+
+} //namespace itensor
+
+#endif
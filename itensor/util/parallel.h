@@ -16,11 +16,13 @@
 #ifndef __ITENSOR_PARALLEL_H
 #define __ITENSOR_PARALLEL_H
 #include "mpi.h"
+#include <climits>
 #include <sstream>
 #include <vector>
 #include <type_traits>
 #include "itensor/util/readwrite.h"
 #include "itensor/util/args.h"
+#include "itensor/itensor.h"
 
 #define DEFAULT_BUFSIZE 500000
 
@@ -39,6 +41,14 @@ template <class T, class... Rest>
 void 
 broadcast(Environment const& env, T & obj, Rest &... rest);
 
+void
+broadcast(Environment const& env, ITensor & T);
+
+class CommRequest;
+
+CommRequest
+ibroadcast(Environment const& env, ITensor & T);
+
 template <typename T>
 void 
 scatterVector(Environment const& env, std::vector<T> &v);
@@ -54,6 +64,11 @@ template <typename T>
 T
 allSum(Environment const& env, T &obj);
 
+void
+allReduce(Environment const& env, 
+          ITensor & T,
+          Args const& args = Args::global());
+
 class Environment
     {
     int rank_,
@@ -119,6 +134,46 @@ class Environment
 
     };
 
+//
+// Handle to non-blocking transfers started by
+// MailBox::isend/ireceive and ibroadcast.
+// The buffers involved must not be used until
+// wait() returns; the destructor also waits.
+//
+class CommRequest
+    {
+    std::vector<MPI_Request> reqs_;
+    std::shared_ptr<ITData const> keep_;
+    public:
+
+    CommRequest() { }
+
+    CommRequest(std::vector<MPI_Request>&& reqs,
+                std::shared_ptr<ITData const> keep = nullptr)
+      : reqs_(std::move(reqs)),
+        keep_(std::move(keep))
+        { }
+
+    CommRequest(CommRequest&& other) = default;
+    CommRequest& 
+    operator=(CommRequest&& other)
+        {
+        wait();
+        reqs_ = std::move(other.reqs_);
+        keep_ = std::move(other.keep_);
+        return *this;
+        }
+
+    ~CommRequest() { wait(); }
+
+    //Returns true if all transfers have completed
+    bool
+    test();
+
+    void
+    wait();
+    };
+
 class MailBox
     {
     Environment const* env_;
@@ -173,6 +228,22 @@ class MailBox
     void 
     send(std::stringstream const& data);
 
+    //ITensors with Dense or QDense storage are
+    //transferred directly from/into their storage
+    void
+    send(ITensor const& T);
+    void
+    receive(ITensor& T);
+
+    //Non-blocking versions: the (small) header is
+    //exchanged right away, the tensor data in the
+    //background. T must not be modified (isend) or
+    //accessed (ireceive) before the request completes.
+    CommRequest
+    isend(ITensor const& T);
+    CommRequest
+    ireceive(ITensor& T);
+
     template <class T> 
     void 
     broadcast(T& obj) const { checkValid(); env_->broadcast(obj); }
@@ -204,6 +275,9 @@ class MailBox
     int
     sizeTag() const { return tag_+1; }
 
+    void
+    receiveHeader(ITensor& T, char*& data, size_t& bytes);
+
     }; //class MailBox
 
 void inline
@@ -305,7 +379,7 @@ template <class T>
 void Environment::
 broadcast(T& obj) const 
     { 
-    itensor::broadcast<T>(*this,obj); 
+    itensor::broadcast(*this,obj); 
     }
 
 template <class T, class... Rest>
@@ -502,10 +576,8 @@ template <class T, typename... Args>
 T MailBox::
 receive(Args&&... args)
     { 
-    std::stringstream data; 
-    receive(data); 
     T obj(std::forward<Args>(args)...);
-    itensor::read(data,obj);
+    receive(obj);
     return obj;
     }
 
@@ -540,6 +612,315 @@ send(T const& obj)
     send(data); 
     }
 
+
+//
+// Raw transfers of ITensor data
+//
+
+namespace detail {
+
+//Largest message sent in one piece (MPI counts are int);
+//unittest/mpi_test.cc lowers it to test the splitting
+#ifndef ITENSOR_MPI_MAX_MESSAGE
+#define ITENSOR_MPI_MAX_MESSAGE (size_t(1) << 30)
+#endif
+size_t const max_message_bytes = ITENSOR_MPI_MAX_MESSAGE;
+
+//Writes the header describing T; returns the location
+//and size of the data to send after it (or nullptr if
+//T is not Dense/QDense and was serialized completely)
+inline char const*
+writeHeader(std::ostream& s, ITensor const& T, size_t& bytes)
+    {
+    auto type = StorageType::Null;
+    if(T.store()) type = doTask(StorageType{},T.store());
+    itensor::write(s,type);
+    bytes = 0;
+    if(not isDenseType(type))
+        {
+        T.write(s);
+        return nullptr;
+        }
+    itensor::write(s,T.inds());
+    itensor::write(s,T.scale());
+    auto R = GetRawData();
+    doTask(R,T.store());
+    itensor::write(s,R.offsets ? *R.offsets : BlockOffsets());
+    itensor::write(s,R.bytes);
+    bytes = R.bytes;
+    return R.data;
+    }
+
+//Reads a header written by writeHeader and makes T,
+//with uninitialized storage to receive bytes of data
+inline char*
+readHeader(std::istream& s, ITensor& T, size_t& bytes)
+    {
+    auto type = StorageType::Null;
+    itensor::read(s,type);
+    bytes = 0;
+    if(not isDenseType(type))
+        {
+        T.read(s);
+        return nullptr;
+        }
+    auto is = IndexSet();
+    auto scale = LogNum();
+    auto offsets = BlockOffsets();
+    itensor::read(s,is);
+    itensor::read(s,scale);
+    itensor::read(s,offsets);
+    itensor::read(s,bytes);
+    auto store = ITensor::storage_ptr();
+    char* data = nullptr;
+    if(type == StorageType::DenseReal)
+        {
+        store = newITData<DenseReal>(undef,bytes/sizeof(Real));
+        data = reinterpret_cast<char*>(static_cast<ITWrap<DenseReal>&>(*store).d.data());
+        }
+    else if(type == StorageType::DenseCplx)
+        {
+        store = newITData<DenseCplx>(undef,bytes/sizeof(Cplx));
+        data = reinterpret_cast<char*>(static_cast<ITWrap<DenseCplx>&>(*store).d.data());
+        }
+    else if(type == StorageType::QDenseReal)
+        {
+        store = newITData<QDenseReal>(undef,offsets,bytes/sizeof(Real));
+        data = reinterpret_cast<char*>(static_cast<ITWrap<QDenseReal>&>(*store).d.data());
+        }
+    else
+        {
+        store = newITData<QDenseCplx>(undef,offsets,bytes/sizeof(Cplx));
+        data = reinterpret_cast<char*>(static_cast<ITWrap<QDenseCplx>&>(*store).d.data());
+        }
+    T = ITensor(std::move(is),std::move(store),scale);
+    return data;
+    }
+
+//Calls f(p,n) for consecutive pieces of at most
+//max_message_bytes bytes of the range [data,data+bytes)
+template<typename Char, typename F>
+void
+forEachPiece(Char* data, size_t bytes, F&& f)
+    {
+    for(size_t b = 0; b < bytes; b += max_message_bytes)
+        {
+        f(data+b,int(std::min(max_message_bytes,bytes-b)));
+        }
+    }
+
+} //namespace detail
+
+inline bool CommRequest::
+test()
+    {
+    if(reqs_.empty()) return true;
+    int done = 0;
+    MPI_Testall(reqs_.size(),reqs_.data(),&done,MPI_STATUSES_IGNORE);
+    if(done) 
+        {
+        reqs_.clear();
+        keep_.reset();
+        }
+    return done;
+    }
+
+inline void CommRequest::
+wait()
+    {
+    if(reqs_.empty()) return;
+    MPI_Waitall(reqs_.size(),reqs_.data(),MPI_STATUSES_IGNORE);
+    reqs_.clear();
+    keep_.reset();
+    }
+
+void inline MailBox::
+send(ITensor const& T)
+    {
+    std::stringstream header;
+    size_t bytes = 0;
+    auto data = detail::writeHeader(header,T,bytes);
+    send(header);
+    detail::forEachPiece(data,bytes,[this](char const* p, int n)
+        {
+        MPI_Send(const_cast<char*>(p),n,MPI_BYTE,other_node_,tag(),com);
+        });
+    }
+
+void inline MailBox::
+receiveHeader(ITensor& T, char*& data, size_t& bytes)
+    {
+    std::stringstream header;
+    receive(header);
+    data = detail::readHeader(header,T,bytes);
+    }
+
+void inline MailBox::
+receive(ITensor& T)
+    {
+    char* data = nullptr;
+    size_t bytes = 0;
+    receiveHeader(T,data,bytes);
+    detail::forEachPiece(data,bytes,[this](char* p, int n)
+        {
+        MPI_Recv(p,n,MPI_BYTE,other_node_,tag(),com,MPI_STATUS_IGNORE);
+        });
+    }
+
+CommRequest inline MailBox::
+isend(ITensor const& T)
+    {
+    std::stringstream header;
+    size_t bytes = 0;
+    auto data = detail::writeHeader(header,T,bytes);
+    send(header);
+    auto reqs = std::vector<MPI_Request>();
+    detail::forEachPiece(data,bytes,[this,&reqs](char const* p, int n)
+        {
+        reqs.emplace_back();
+        MPI_Isend(const_cast<char*>(p),n,MPI_BYTE,other_node_,tag(),com,&reqs.back());
+        });
+    return CommRequest(std::move(reqs),T.store().p);
+    }
+
+CommRequest inline MailBox::
+ireceive(ITensor& T)
+    {
+    char* data = nullptr;
+    size_t bytes = 0;
+    receiveHeader(T,data,bytes);
+    auto reqs = std::vector<MPI_Request>();
+    detail::forEachPiece(data,bytes,[this,&reqs](char* p, int n)
+        {
+        reqs.emplace_back();
+        MPI_Irecv(p,n,MPI_BYTE,other_node_,tag(),com,&reqs.back());
+        });
+    return CommRequest(std::move(reqs),T.store());
+    }
+
+//
+// Broadcasts T from node 0: the header is serialized,
+// the data of Dense and QDense storage is broadcast
+// directly from/into the storage
+//
+void inline
+broadcast(Environment const& env, ITensor & T)
+    {
+    auto req = ibroadcast(env,T);
+    req.wait();
+    }
+
+CommRequest inline
+ibroadcast(Environment const& env, ITensor & T)
+    {
+    if(env.nnodes() == 1) return CommRequest();
+    const int root = 0;
+    std::stringstream header;
+    size_t bytes = 0;
+    char* data = nullptr;
+    if(env.rank() == root) 
+        {
+        data = const_cast<char*>(detail::writeHeader(header,T,bytes));
+        }
+    env.broadcast(header);
+    if(env.rank() != root) 
+        {
+        data = detail::readHeader(header,T,bytes);
+        }
+    auto reqs = std::vector<MPI_Request>();
+    detail::forEachPiece(data,bytes,[&reqs,root](char* p, int n)
+        {
+        reqs.emplace_back();
+        MPI_Ibcast(p,n,MPI_BYTE,root,MPI_COMM_WORLD,&reqs.back());
+        });
+    //Keep the send buffer (root) or receive
+    //buffer (other nodes) alive until completion
+    return CommRequest(std::move(reqs),T.store());
+    }
+
+
+//
+// Sums T over all nodes in place, leaving the result
+// on every node. T must have the same indices (in the
+// same order), storage type and QN block structure on
+// all nodes; this is checked by comparing a hash of
+// the structure unless "CheckStructure" is false.
+// The elements of Dense and QDense storage are then
+// reduced directly with MPI_Allreduce, in pieces of
+// "ChunkSize" elements (at least 1, at most INT_MAX)
+// with several in flight at once.
+// Other storage types fall back to allSum.
+//
+void inline
+allReduce(Environment const& env, 
+          ITensor & T,
+          Args const& args)
+    {
+    if(env.nnodes() == 1) return;
+    auto check = args.getBool("CheckStructure",true);
+    auto chunk_size = args.getInt("ChunkSize",1<<20);
+    if(chunk_size < 1) Error("allReduce: ChunkSize must be at least 1");
+    //MPI counts are int
+    auto chunk = size_t(std::min(chunk_size,long(INT_MAX)));
+    int const max_pending = 4;
+
+    auto type = StorageType::Null;
+    if(T.store()) type = doTask(StorageType{},T.store());
+
+    if(check)
+        {
+        auto s = std::ostringstream();
+        itensor::write(s,type);
+        itensor::write(s,T.inds());
+        if(isDenseType(type))
+            {
+            auto R = GetRawData();
+            doTask(R,T.store());
+            if(R.offsets) itensor::write(s,*R.offsets);
+            }
+        //All nodes agree iff max(h) == h and max(~h) == ~h
+        unsigned long long h = std::hash<std::string>()(s.str());
+        unsigned long long hs[2] = {h,~h},
+                           hmax[2] = {0,0};
+        MPI_Allreduce(hs,hmax,2,MPI_UNSIGNED_LONG_LONG,MPI_MAX,MPI_COMM_WORLD);
+        if(hmax[0] != hs[0] || hmax[1] != hs[1]) 
+            {
+            Error("allReduce: ITensor indices or storage differ between nodes");
+            }
+        }
+
+    if(not isDenseType(type))
+        {
+        T = allSum(env,T);
+        return;
+        }
+
+    //Bring the scale factor into the data; GetMutableRawData
+    //makes sure the storage is not shared with other ITensors
+    T.scaleTo(1.);
+
+    auto R = GetMutableRawData();
+    doTask(R,T.store());
+    //Complex numbers are summed as pairs of Reals
+    auto x = reinterpret_cast<Real*>(R.data);
+    auto n = R.bytes/sizeof(Real);
+
+    auto reqs = std::vector<MPI_Request>();
+    for(size_t b = 0; b < n; b += chunk)
+        {
+        if(reqs.size() == max_pending)
+            {
+            int done = 0;
+            MPI_Waitany(reqs.size(),reqs.data(),&done,MPI_STATUS_IGNORE);
+            reqs.erase(reqs.begin()+done);
+            }
+        reqs.emplace_back();
+        auto count = std::min(chunk,n-b);
+        MPI_Iallreduce(MPI_IN_PLACE,x+b,int(count),MPI_DOUBLE,MPI_SUM,MPI_COMM_WORLD,&reqs.back());
+        }
+    MPI_Waitall(reqs.size(),reqs.data(),MPI_STATUSES_IGNORE);
+    }
+
 } //namespace itensor
 
 #endif
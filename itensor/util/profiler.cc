@@ -0,0 +1,358 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "itensor/util/profiler.h"
+#include "itensor/util/instrument.h"
+#include "itensor/util/print.h"
+#include "itensor/util/error.h"
+#include "itensor/util/iterate.h"
+
+namespace itensor {
+
+using std::string;
+using std::vector;
+using clock_type = std::chrono::steady_clock;
+
+namespace detail {
+
+struct ProfileNode
+    {
+    int region = -1;
+    int parent = -1;
+    long count = 0;
+    double total = 0.;
+    vector<std::pair<int,int>> children; //(region,node)
+    };
+
+struct TraceEvent
+    {
+    int region = 0;
+    double start = 0., //seconds since profiler start
+           dur = 0.;
+    };
+
+struct ThreadProfile
+    {
+    vector<ProfileNode> nodes; //nodes[0] is the root
+    int current = 0;
+    vector<TraceEvent> events;
+
+    ThreadProfile() : nodes(1) { }
+
+    int
+    child(int parent, int region)
+        {
+        for(auto& c : nodes[parent].children)
+            {
+            if(c.first == region) return c.second;
+            }
+        auto n = int(nodes.size());
+        nodes.emplace_back();
+        nodes.back().region = region;
+        nodes.back().parent = parent;
+        nodes[parent].children.emplace_back(region,n);
+        return n;
+        }
+    };
+
+} //namespace detail
+
+using detail::ProfileNode;
+using detail::ThreadProfile;
+
+namespace {
+
+struct ProfilerState
+    {
+    //threads.mutex also guards names
+    ThreadRegistry<ThreadProfile> threads;
+    vector<string> names;
+    std::atomic<bool> tracing{false};
+    std::atomic<long> max_events{1000000};
+    clock_type::time_point epoch = clock_type::now();
+    };
+
+} //namespace
+
+ProfilerState static&
+profilerState()
+    {
+    static ProfilerState st;
+    return st;
+    }
+
+int
+profileRegionId(string const& name)
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    auto it = std::find(st.names.begin(),st.names.end(),name);
+    if(it != st.names.end()) return int(it-st.names.begin());
+    st.names.push_back(name);
+    return int(st.names.size())-1;
+    }
+
+void ProfileScope::
+enter(int region)
+    {
+    tp_ = &profilerState().threads.local();
+    parent_ = tp_->current;
+    node_ = tp_->child(parent_,region);
+    tp_->current = node_;
+    start_ = clock_type::now();
+    }
+
+void ProfileScope::
+exit()
+    {
+    auto end = clock_type::now();
+    auto dur = std::chrono::duration<double>(end-start_).count();
+    auto& n = tp_->nodes[node_];
+    n.count += 1;
+    n.total += dur;
+    tp_->current = parent_;
+    auto& st = profilerState();
+    if(st.tracing.load(std::memory_order_relaxed)
+       && long(tp_->events.size()) < st.max_events.load(std::memory_order_relaxed))
+        {
+        auto start = std::chrono::duration<double>(start_-st.epoch).count();
+        tp_->events.push_back({n.region,start,dur});
+        }
+    tp_ = nullptr;
+    }
+
+Profiler&
+profiler()
+    {
+    static Profiler P;
+    return P;
+    }
+
+void Profiler::
+trace(bool val, long max_events)
+    {
+    auto& st = profilerState();
+    st.max_events = max_events;
+    st.tracing = val;
+    }
+
+bool Profiler::
+tracing() const { return profilerState().tracing; }
+
+void Profiler::
+reset()
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    for(auto& tp : st.threads.data)
+        {
+        for(auto& n : tp->nodes)
+            {
+            n.count = 0;
+            n.total = 0.;
+            }
+        tp->events.clear();
+        }
+    }
+
+//Self time of node n: total time minus time in children
+double static
+selfTime(vector<ProfileNode> const& nodes, int n)
+    {
+    auto t = nodes[n].total;
+    for(auto& c : nodes[n].children) t -= nodes[c.second].total;
+    return t;
+    }
+
+//Tree of all threads combined by region path
+vector<ProfileNode> static
+mergedTree(ProfilerState const& st)
+    {
+    auto M = ThreadProfile();
+    for(auto& tp : st.threads.data)
+        {
+        auto& nodes = tp->nodes;
+        //Node in M for each node of this thread (parents come first)
+        auto map = vector<int>(nodes.size(),0);
+        for(auto n : range(1,nodes.size()))
+            {
+            map[n] = M.child(map[nodes[n].parent],nodes[n].region);
+            M.nodes[map[n]].count += nodes[n].count;
+            M.nodes[map[n]].total += nodes[n].total;
+            }
+        }
+    return M.nodes;
+    }
+
+string static
+pathOf(ProfilerState const& st, vector<ProfileNode> const& nodes, int n)
+    {
+    auto path = st.names.at(nodes[n].region);
+    for(auto p = nodes[n].parent; p > 0; p = nodes[p].parent)
+        {
+        path = st.names.at(nodes[p].region) + "/" + path;
+        }
+    return path;
+    }
+
+//Node of the merged tree for path, -1 if not found
+int static
+findPath(ProfilerState const& st, vector<ProfileNode> const& nodes, string const& path)
+    {
+    int n = 0;
+    size_t b = 0;
+    while(b <= path.size())
+        {
+        auto e = path.find('/',b);
+        if(e == string::npos) e = path.size();
+        auto name = path.substr(b,e-b);
+        int next = -1;
+        for(auto& c : nodes[n].children)
+            {
+            if(st.names.at(c.first) == name) next = c.second;
+            }
+        if(next < 0) return -1;
+        n = next;
+        b = e+1;
+        }
+    return n;
+    }
+
+double Profiler::
+time(string const& path) const
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    auto M = mergedTree(st);
+    auto n = findPath(st,M,path);
+    return n < 0 ? 0. : M[n].total;
+    }
+
+long Profiler::
+calls(string const& path) const
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    auto M = mergedTree(st);
+    auto n = findPath(st,M,path);
+    return n < 0 ? 0 : M[n].count;
+    }
+
+void static
+printNode(std::ostream& s,
+          ProfilerState const& st,
+          vector<ProfileNode> const& M,
+          int n,
+          int depth)
+    {
+    if(n > 0 && M[n].count > 0)
+        {
+        s << format("\n%10d %12.4f %12.4f  %s%s",M[n].count,M[n].total,selfTime(M,n),
+                    string(2*(depth-1),' '),st.names.at(M[n].region));
+        }
+    //Children with the largest total time first
+    auto children = M[n].children;
+    std::sort(children.begin(),children.end(),[&M](auto& a, auto& b)
+        { return M[a.second].total > M[b.second].total; });
+    for(auto& c : children) printNode(s,st,M,c.second,depth+1);
+    }
+
+void Profiler::
+print(std::ostream& s) const
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    auto M = mergedTree(st);
+    s << "-----------------------------------------------------\n";
+    s << format("Profile (%d thread%s)\n",st.threads.data.size(),st.threads.data.size() == 1 ? "" : "s");
+    s << format("%10s %12s %12s  %s","calls","total (s)","self (s)","region");
+    printNode(s,st,M,0,0);
+    s << "\n-----------------------------------------------------";
+    }
+
+std::ostream&
+operator<<(std::ostream& s, Profiler const& P)
+    {
+    P.print(s);
+    return s;
+    }
+
+void Profiler::
+writeCSV(string const& fname) const
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    std::ofstream f(fname.c_str());
+    if(!f.good()) Error("Profiler: couldn't open file " + fname);
+    f << "thread,path,calls,total_s,self_s\n";
+    for(auto tid : range(st.threads.data.size()))
+        {
+        auto& nodes = st.threads.data[tid]->nodes;
+        for(auto n : range(1,nodes.size()))
+            {
+            if(nodes[n].count == 0) continue;
+            f << format("%d,\"%s\",%d,%.9f,%.9f\n",tid,pathOf(st,nodes,n),
+                        nodes[n].count,nodes[n].total,selfTime(nodes,n));
+            }
+        }
+    }
+
+string static
+jsonEscape(string const& s)
+    {
+    auto r = string();
+    for(auto c : s)
+        {
+        if(c == '"' || c == '\\') r.push_back('\\');
+        r.push_back(c);
+        }
+    return r;
+    }
+
+void Profiler::
+writeChromeTrace(string const& fname) const
+    {
+    auto& st = profilerState();
+    std::lock_guard<std::mutex> lock(st.threads.mutex);
+    std::ofstream f(fname.c_str());
+    if(!f.good()) Error("Profiler: couldn't open file " + fname);
+    f << "{\"traceEvents\":[";
+    auto first = true;
+    for(auto tid : range(st.threads.data.size()))
+    for(auto& e : st.threads.data[tid]->events)
+        {
+        if(!first) f << ",";
+        first = false;
+        f << format("\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    jsonEscape(st.names.at(e.region)),tid,1E6*e.start,1E6*e.dur);
+        }
+    f << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
+
+//
+// Enable profiling when ITENSOR_PROFILE is set
+// and print the profile at exit
+//
+static EnvSwitch profile_from_env("ITENSOR_PROFILE",
+                           [] { profilerState(); profiler().enable(true); },
+                           [] { std::cout << profiler() << std::endl; });
+
+} //namespace itensor
@@ -0,0 +1,179 @@
+//
+// Copyright 2018 The Simons Foundation, Inc. - All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#ifndef __ITENSOR_PROFILER_H
+#define __ITENSOR_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <iosfwd>
+
+//
+// Named, hierarchical region profiler
+//
+// Mark a region with
+//
+//     PROFILE_REGION("svd");
+//
+// which times the rest of the enclosing scope, or with
+//
+//     PROFILE_START(p,"davidson");
+//     ...
+//     PROFILE_STOP(p);
+//
+// Regions entered while another region is active on the
+// same thread are recorded as its children, so times are
+// kept for each path such as "dmrg sweep/davidson/product".
+// Every thread records into its own tree; reports combine
+// the threads.
+//
+// Profiling is off by default and switched on at runtime
+// by profiler().enable(true) or by setting the environment
+// variable ITENSOR_PROFILE (the summary is then printed at
+// exit). While off, a region costs one flag check.
+// Defining ITENSOR_NO_PROFILER removes regions at compile time.
+//
+
+#ifndef ITENSOR_NO_PROFILER
+
+#define ITENSOR_PROFILE_CAT2(a,b) a##b
+#define ITENSOR_PROFILE_CAT(a,b) ITENSOR_PROFILE_CAT2(a,b)
+
+//Region id of name, looked up once per call site
+#define PROFILE_ID(name) \
+    ([]{ static int const profile_id_ = itensor::profileRegionId(name); return profile_id_; }())
+
+#define PROFILE_REGION(name) \
+    itensor::ProfileScope ITENSOR_PROFILE_CAT(profile_scope_,__LINE__)(PROFILE_ID(name));
+
+#define PROFILE_START(var,name) \
+    itensor::ProfileScope var(PROFILE_ID(name));
+
+#define PROFILE_STOP(var) \
+    var.stop();
+
+#else
+
+#define PROFILE_REGION(name)
+#define PROFILE_START(var,name)
+#define PROFILE_STOP(var)
+
+#endif
+
+namespace itensor {
+
+namespace detail {
+struct ThreadProfile;
+inline std::atomic<bool> profiling_on{false};
+}
+
+//Id of the region called name (registered on first use)
+int
+profileRegionId(std::string const& name);
+
+class Profiler
+    {
+    public:
+
+    bool
+    enabled() const { return detail::profiling_on.load(std::memory_order_relaxed); }
+
+    void
+    enable(bool val) { detail::profiling_on.store(val); }
+
+    //Also record every region entry as an event for
+    //writeChromeTrace (at most max_events per thread)
+    void
+    trace(bool val, long max_events = 1000000);
+
+    bool
+    tracing() const;
+
+    //Set all times and counts to zero and drop trace events
+    void
+    reset();
+
+    //
+    // Reports: should be made when no other
+    // thread is inside a profiled region
+    //
+
+    //Events recorded with trace(true) in the Chrome
+    //trace event format (chrome://tracing, Perfetto)
+    void
+    writeChromeTrace(std::string const& fname) const;
+
+    //One line per thread and region path:
+    //thread,path,calls,total_s,self_s
+    void
+    writeCSV(std::string const& fname) const;
+
+    //Total time of region path ("a/b/c") summed
+    //over threads, and its number of calls
+    double
+    time(std::string const& path) const;
+
+    long
+    calls(std::string const& path) const;
+
+    void
+    print(std::ostream& s) const;
+    };
+
+Profiler&
+profiler();
+
+std::ostream&
+operator<<(std::ostream& s, Profiler const& P);
+
+//
+// Times a region from construction until stop()
+// or destruction; use through the macros above
+//
+class ProfileScope
+    {
+    detail::ThreadProfile* tp_ = nullptr;
+    int node_ = 0,
+        parent_ = 0;
+    std::chrono::steady_clock::time_point start_;
+    public:
+
+    explicit
+    ProfileScope(int region)
+        {
+        if(detail::profiling_on.load(std::memory_order_relaxed)) enter(region);
+        }
+
+    ProfileScope(ProfileScope const&) = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+    ~ProfileScope() { stop(); }
+
+    void
+    stop() { if(tp_) exit(); }
+
+    private:
+
+    void
+    enter(int region);
+
+    void
+    exit();
+    };
+
+} //namespace itensor
+
+#endif
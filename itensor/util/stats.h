@@ -19,6 +19,7 @@
 #include "itensor/real.h"
 #include "itensor/tensor/vec.h"
 #include "itensor/global.h"
+#include "itensor/util/readwrite.h"
 
 namespace itensor {
 
@@ -141,6 +142,147 @@ class Stats
 
     };
 
+
+//
+// Mean and error bar of a series of correlated
+// samples (such as a Markov chain), corrected for
+// autocorrelation by binning: samples are averaged
+// in bins of 1,2,4,8,... samples and the error is
+// taken from the bin sizes that still have at least
+// min_bins bins. Memory use is O(log(n)).
+//
+// Series of independent chains can be combined
+// with +=, which adds up completed bins (unfinished
+// bins of the argument are dropped).
+//
+class BinningStats
+    {
+    std::vector<Real> sum_,   //sum of bin averages, bins of size 2^l
+                      sum2_;  //sum of squares of bin averages
+    std::vector<long> nbin_;  //number of bins of size 2^l
+    std::vector<Real> part_;  //unfinished bin of size 2^l
+    std::vector<bool> half_;  //part_[l] holds half a bin
+    public:
+
+    static int const min_bins = 32;
+
+    BinningStats() { }
+
+    void
+    putin(Real x)
+        {
+        for(size_t l = 0; ; ++l)
+            {
+            if(l == nbin_.size())
+                {
+                sum_.push_back(0.);
+                sum2_.push_back(0.);
+                nbin_.push_back(0);
+                part_.push_back(0.);
+                half_.push_back(false);
+                }
+            sum_[l] += x;
+            sum2_[l] += x*x;
+            nbin_[l] += 1;
+            //Pair up bins of size 2^l into a bin of size 2^(l+1)
+            if(not half_[l])
+                {
+                part_[l] = x;
+                half_[l] = true;
+                return;
+                }
+            x = (part_[l]+x)/2.;
+            half_[l] = false;
+            }
+        }
+
+    long
+    count() const { return nbin_.empty() ? 0 : nbin_[0]; }
+
+    Real
+    avg() const { return count() > 0 ? sum_[0]/nbin_[0] : 0.; }
+
+    //Error bar from bins of size 2^level,
+    //ignoring correlations between bins
+    Real
+    err(int level) const
+        {
+        if(level >= int(nbin_.size()) || nbin_[level] < 2) return 0.;
+        auto n = Real(nbin_[level]);
+        auto av = sum_[level]/n;
+        auto var = std::max(0.,sum2_[level]/n-av*av);
+        return std::sqrt(var/(n-1));
+        }
+
+    //Error bar corrected for autocorrelation: the
+    //largest err(level) over bin sizes with at least
+    //min_bins bins
+    Real
+    err() const
+        {
+        auto e = err(0);
+        for(int l = 1; l < int(nbin_.size()) && nbin_[l] >= min_bins; ++l)
+            {
+            e = std::max(e,err(l));
+            }
+        return e;
+        }
+
+    //Estimate of the integrated autocorrelation
+    //time (1/2 for uncorrelated samples)
+    Real
+    tau() const
+        {
+        auto e0 = err(0);
+        if(e0 == 0.) return 0.5;
+        return 0.5*sqr(err()/e0);
+        }
+
+    BinningStats&
+    operator+=(BinningStats const& other)
+        {
+        if(other.nbin_.size() > nbin_.size())
+            {
+            auto n = other.nbin_.size();
+            sum_.resize(n,0.);
+            sum2_.resize(n,0.);
+            nbin_.resize(n,0);
+            part_.resize(n,0.);
+            half_.resize(n,false);
+            }
+        for(auto l : range(other.nbin_.size()))
+            {
+            sum_[l] += other.sum_[l];
+            sum2_[l] += other.sum2_[l];
+            nbin_[l] += other.nbin_[l];
+            }
+        return *this;
+        }
+
+    void
+    write(std::ostream& s) const
+        {
+        itensor::write(s,sum_);
+        itensor::write(s,sum2_);
+        itensor::write(s,nbin_);
+        itensor::write(s,part_);
+        auto half = std::vector<char>(half_.begin(),half_.end());
+        itensor::write(s,half);
+        }
+
+    void
+    read(std::istream& s)
+        {
+        itensor::read(s,sum_);
+        itensor::read(s,sum2_);
+        itensor::read(s,nbin_);
+        itensor::read(s,part_);
+        auto half = std::vector<char>();
+        itensor::read(s,half);
+        half_.assign(half.begin(),half.end());
+        }
+    };
+
 } //namespace itensor
 
 #endif
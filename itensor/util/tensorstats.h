@@ -21,6 +21,12 @@
 #include "itensor/util/print.h"
 #include "itensor/itensor.h"
 
+//
+// Compile-time record of the dims and labels of dense
+// contractions, for generating benchmark inputs.
+// For runtime statistics including timings and
+// QDense blocks see itensor/util/contractstats.h
+//
 //#define COLLECT_TSTATS
 
 #ifdef COLLECT_TSTATS
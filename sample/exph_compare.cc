@@ -0,0 +1,76 @@
+#include "itensor/all.h"
+
+using namespace itensor;
+
+//
+// Compares the accuracy and construction time of the
+// MPO approximations to exp(-tau*H) returned by toExpH
+// ("ZW1" and "WII", first and second order) for a
+// Heisenberg chain and a Hubbard chain.
+//
+// The error is measured against the exact exponential
+// of the full Hamiltonian, so the chains are kept short.
+//
+
+ITensor
+fullTensor(MPO const& W)
+    {
+    auto T = W(1);
+    for(auto j : range1(2,length(W))) T *= W(j);
+    return T;
+    }
+
+void
+compare(std::string const& name,
+        AutoMPO const& ampo)
+    {
+    auto Hf = fullTensor(toMPO(ampo));
+    println("\n",name);
+    printfln("%6s %6s %6s %12s %10s %8s","tau","Approx","Order","error","time (s)","maxdim");
+    for(Real tau : {0.1,0.05,0.025})
+        {
+        auto X = expHermitian(Hf,-tau);
+        for(auto approx : {"ZW1","WII"})
+        for(auto order : {1,2})
+            {
+            auto t = cpu_time();
+            auto U = toExpH(ampo,tau,{"Approx",approx,"Order",order});
+            auto time = t.sincemark().wall;
+            auto err = norm(fullTensor(U)-X)/norm(X);
+            printfln("%6.3f %6s %6d %12.4E %10.4f %8d",tau,approx,order,err,time,maxLinkDim(U));
+            }
+        }
+    }
+
+int
+main()
+    {
+    int N = 8;
+
+    auto spins = SpinHalf(N);
+    auto heis = AutoMPO(spins);
+    for(auto j : range1(N-1))
+        {
+        heis += 0.5,"S+",j,"S-",j+1;
+        heis += 0.5,"S-",j,"S+",j+1;
+        heis +=     "Sz",j,"Sz",j+1;
+        }
+    compare("Heisenberg chain, N = 8",heis);
+
+    int Ne = 4;
+    Real t1 = 1.0;
+    Real U = 4.0;
+    auto electrons = Electron(Ne);
+    auto hubb = AutoMPO(electrons);
+    for(auto j : range1(Ne-1))
+        {
+        hubb += -t1,"Cdagup",j,"Cup",j+1;
+        hubb += -t1,"Cdagup",j+1,"Cup",j;
+        hubb += -t1,"Cdagdn",j,"Cdn",j+1;
+        hubb += -t1,"Cdagdn",j+1,"Cdn",j;
+        }
+    for(auto j : range1(Ne)) hubb += U,"Nupdn",j;
+    compare("Hubbard chain, N = 4, U = 4",hubb);
+
+    return 0;
+    }
@@ -19,6 +19,7 @@ ctmrg(ITensor T,
   ITensor Uv;
   for(auto i : range1(nsteps))
     {
+    (void)i;
     // Get the grown corner transfer matrix (CTM)
     auto Clu_new = Al * Clu * Au * T;
 
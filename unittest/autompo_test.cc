@@ -284,6 +284,123 @@ SECTION("No QN MPO")
         }
     }
 
+SECTION("addTerms")
+    {
+    auto N = 8;
+    auto sites = SpinHalf(N);
+
+    auto ampo = AutoMPO(sites);
+    for(auto j : range1(N-1))
+        {
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        ampo += "Sz",j,"Sz",j+1;
+        }
+
+    //Same Hamiltonian, with the Sz Sz terms
+    //split into two halves to check merging
+    auto terms = std::vector<HTerm>();
+    for(auto j : range1(N-1))
+        {
+        auto pm = HTerm(),
+             mp = HTerm(),
+             zz = HTerm();
+        pm.add("S+",j,0.5);
+        pm.add("S-",j+1);
+        mp.add("S-",j,0.5);
+        mp.add("S+",j+1);
+        zz.add("Sz",j,0.5);
+        zz.add("Sz",j+1);
+        terms.push_back(zz);
+        terms.push_back(pm);
+        terms.push_back(mp);
+        terms.push_back(zz);
+        }
+    auto bulk = AutoMPO(sites);
+    bulk.addTerms(terms);
+    CHECK(bulk.size() == ampo.size());
+
+    auto bulk_terms = bulk.terms();
+    auto it = bulk_terms.begin();
+    for(auto& t : ampo.terms())
+        {
+        CHECK(t == *it);
+        ++it;
+        }
+
+    //Adding to a non-empty AutoMPO merges with existing terms
+    bulk.addTerms(terms);
+    CHECK(bulk.size() == ampo.size());
+    auto ampo_terms = ampo.terms();
+    for(auto& t : bulk.terms())
+        {
+        CHECK_CLOSE(t.coef,2*ampo_terms.find(t)->coef);
+        }
+
+    auto H = toMPO(ampo);
+    auto Hb = toMPO(bulk);
+    auto state = InitState(sites);
+    for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+    auto psi = randomMPS(state);
+    CHECK_CLOSE(inner(psi,Hb,psi),2*inner(psi,H,psi));
+    }
+
+SECTION("Term storage")
+    {
+    auto N = 8;
+    auto sites = SpinHalf(N);
+
+    //Enough repeated terms that added terms are
+    //merged several times while they are added
+    auto ampo = AutoMPO(sites);
+    for(auto r : range(200))
+    for(auto i : range1(N))
+    for(auto j : range1(i+1,N))
+        {
+        ampo += 0.5,"S+",i,"S-",j;
+        ampo += 0.5,"S-",i,"S+",j;
+        if(r == 0) ampo += 3.0,"Sz",i,"Sz",j;
+        }
+    //Longer terms than are stored compactly
+    ampo += 2.0,"Sz",1,"Sz",2,"Sz",3,"Sz",4,"Sz",5;
+    ampo += 2.0,"Sz",1,"Sz",2,"Sz",3,"Sz",4,"Sz",5;
+    ampo += "Sz",1,"Sz",2,"Sz",3,"Sz",4;
+
+    auto nterms = 3*N*(N-1)/2+2;
+    CHECK(ampo.size() == nterms);
+    auto terms = ampo.terms();
+    CHECK(int(terms.size()) == nterms);
+    for(auto& t : terms)
+        {
+        if(t.Nops() == 5) CHECK_CLOSE(t.coef,4.);
+        else if(t.Nops() == 4) CHECK_CLOSE(t.coef,1.);
+        else if(t.first().op == "Sz") CHECK_CLOSE(t.coef,3.);
+        else CHECK_CLOSE(t.coef,100.);
+        }
+
+    //Terms added since the last merge are counted once
+    ampo += 0.5,"S+",1,"S-",2;
+    ampo += "Sx",1,"Sx",2;
+    ampo += "Sx",1,"Sx",2;
+    CHECK(ampo.size() == nterms+1);
+
+    //Merged and recently added terms are visited
+    //together, in the order of the set of terms
+    terms = ampo.terms();
+    CHECK(int(terms.size()) == nterms+1);
+    auto it = terms.begin();
+    for(auto& t : ampo.termRange())
+        {
+        CHECK(t == *it);
+        ++it;
+        }
+    CHECK(it == terms.end());
+
+    ampo.reset();
+    CHECK(ampo.size() == 0);
+    CHECK(ampo.terms().empty());
+    }
+
 SECTION("Single Site Ops")
     {
     int L = 10;
@@ -411,6 +528,53 @@ SECTION("toExpH ITensor (QN conservation)")
         }
     }
 
+SECTION("toExpH WII and Order 2")
+    {
+    //Compare against exp(-tau*H) computed from the
+    //full Hamiltonian tensor of a short chain
+    auto full = [](MPO const& W)
+        {
+        auto T = W(1);
+        for(auto j : range1(2,length(W))) T *= W(j);
+        return T;
+        };
+
+    int N = 6;
+    auto sites = SpinHalf(N);
+    auto ampo = AutoMPO(sites);
+    for(int j = 1; j < N; ++j)
+        {
+        ampo +=     "Sz",j,"Sz",j+1;
+        ampo += 0.5,"S+",j,"S-",j+1;
+        ampo += 0.5,"S-",j,"S+",j+1;
+        }
+    for(int j = 1; j <= N; ++j) ampo += 0.3,"Sz",j;
+    auto Hf = full(toMPO(ampo));
+
+    auto err = [&](Cplx tau, Args const& args)
+        {
+        auto X = expHermitian(Hf,-tau);
+        return norm(full(toExpH(ampo,tau,args))-X)/norm(X);
+        };
+
+    for(auto tau : {Cplx(0.1,0.),Cplx(0.,0.1)})
+        {
+        auto zw1 = err(tau,{"Approx","ZW1"});
+        auto wii = err(tau,{"Approx","WII"});
+        auto zw1_2 = err(tau,{"Approx","ZW1","Order",2});
+        auto wii_2 = err(tau,{"Approx","WII","Order",2});
+        CHECK(wii < zw1);
+        CHECK(zw1_2 < 0.1*zw1);
+        CHECK(wii_2 < 0.1*wii);
+        CHECK(wii_2 < zw1_2);
+        }
+
+    //Halving tau should reduce the Order 2 error by ~2^3
+    auto e1 = err(0.1,{"Approx","WII","Order",2});
+    auto e2 = err(0.05,{"Approx","WII","Order",2});
+    CHECK(e1/e2 > 6.);
+    }
+
 SECTION("Electron, Complex Hopping")
     {
     auto N = 10;
@@ -1,10 +1,14 @@
 #include "test.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
 #include "itensor/util/cputime.h"
 #include "itensor/util/iterate.h"
 #include "itensor/tensor/contract.h"
 #include "itensor/util/set_scoped.h"
 #include "itensor/util/args.h"
 #include "itensor/global.h"
+#include "itensor/util/contractstats.h"
 
 using namespace itensor;
 
@@ -793,3 +797,86 @@ TEST_CASE("Contract Test")
     
         } // Contract Loop
     }
+
+TEST_CASE("Contraction Stats")
+    {
+    auto& S = contractStats();
+    S.reset();
+
+    SECTION("Disabled")
+        {
+        Tensor A(2,3),
+               B(3,4),
+               C(2,4);
+        contract(A,{1,2},B,{2,3},C,{1,3});
+        CHECK(S.classes().empty());
+        }
+
+    SECTION("Shapes")
+        {
+        S.enable(true);
+
+        Tensor A(2,3),
+               B(3,4),
+               C(2,4);
+        for(auto& elt : A) elt = Global::random();
+        for(auto& elt : B) elt = Global::random();
+        contract(A,{1,2},B,{2,3},C,{1,3});
+        contract(A,{1,2},B,{2,3},C,{1,3});
+
+        //Contracted index in the middle of P: must permute
+        Tensor P(2,3,4),
+               Q(3,5),
+               R(2,4,5);
+        for(auto& elt : P) elt = Global::random();
+        for(auto& elt : Q) elt = Global::random();
+            {
+            ContractStatsKind kind("dense");
+            contract(P,{1,2,3},Q,{2,4},R,{1,3,4});
+            }
+
+        S.enable(false);
+
+        auto cls = S.classes();
+        REQUIRE(cls.size() == 2);
+        auto& mat = (cls[0].shape.kind == "tensor") ? cls[0] : cls[1];
+        auto& perm = (cls[0].shape.kind == "tensor") ? cls[1] : cls[0];
+
+        CHECK(mat.calls == 2);
+        CHECK(mat.shape.m == 2);
+        CHECK(mat.shape.k == 3);
+        CHECK(mat.shape.n == 4);
+        CHECK(!mat.shape.permA);
+        CHECK(!mat.shape.permB);
+        CHECK(!mat.shape.permC);
+        CHECK_CLOSE(mat.flops,2*(2*2*3*4));
+        CHECK(mat.time >= mat.gemm_time);
+
+        CHECK(perm.shape.kind == "dense");
+        CHECK(perm.calls == 1);
+        CHECK(perm.shape.m*perm.shape.k*perm.shape.n == 2*3*4*5);
+        CHECK(perm.shape.k == 3);
+        CHECK((perm.shape.permA || perm.shape.permB || perm.shape.permC));
+        CHECK_CLOSE(perm.flops,2*2*3*4*5);
+
+        auto tot = S.total();
+        CHECK(tot.calls == 3);
+        CHECK_CLOSE(tot.flops,mat.flops+perm.flops);
+
+        auto s = std::ostringstream();
+        s << S;
+        CHECK(s.str().find("Contractions: 3 calls in 2 shape classes") != std::string::npos);
+
+        S.writeCSV("contract_stats.csv");
+        std::ifstream f("contract_stats.csv");
+        auto line = std::string();
+        auto nlines = 0;
+        while(std::getline(f,line)) ++nlines;
+        CHECK(nlines == 3);
+        f.close();
+        std::remove("contract_stats.csv");
+
+        S.reset();
+        CHECK(S.classes().empty());
+        }
+    }
@@ -0,0 +1,72 @@
+#include "test.h"
+#include "itensor/tn/ctmrg.h"
+#include "ising_test_helper.h"
+
+using namespace itensor;
+
+TEST_CASE("CTMRGTest")
+{
+auto betac = 0.5*std::log(1+std::sqrt(2.));
+auto beta = 1.1*betac;
+auto logZ = onsagerLogZ(beta);
+auto m = std::pow(1-std::pow(std::sinh(2*beta),-4),1./8);
+
+auto h = Index(2,"h"),
+     v = Index(2,"v");
+auto T = isingTensor(h,v,beta);
+auto Tsz = isingTensor(h,v,beta,true);
+
+SECTION("Symmetric")
+    {
+    auto ctm = CTMRG(T,h,v,{"MaxDim",16,"Symmetric",true});
+    auto nsteps = ctm.run();
+    CHECK(nsteps < 500);
+    CHECK(ctm.change() < 1E-10);
+    CHECK(ctm.maxLinkDim() == 16);
+    CHECK(std::fabs(std::log(ctm.kappa())-logZ) < 1E-10);
+    CHECK(std::fabs(std::fabs(ctm.expect(Tsz))-m) < 1E-10);
+    }
+
+SECTION("Directional")
+    {
+    for(auto projector : {"Isometric","Oblique"})
+        {
+        auto ctm = CTMRG(T,h,v,{"MaxDim",16,"Projector",projector});
+        ctm.run();
+        CHECK(std::fabs(std::log(ctm.kappa())-logZ) < 1E-9);
+        CHECK(std::fabs(std::fabs(ctm.expect(Tsz))-m) < 1E-5);
+        CHECK_CLOSE(ctm.expect(T),1.);
+        }
+    }
+
+SECTION("QN")
+    {
+    auto hq = Index(QN({"P",0,2}),1,QN({"P",1,2}),1,"h"),
+         vq = Index(QN({"P",0,2}),1,QN({"P",1,2}),1,"v");
+    auto Tq = isingTensor(hq,vq,beta);
+    CHECK(hasQNs(Tq));
+    auto ctm = CTMRG(Tq,hq,vq,{"MaxDim",16});
+    ctm.run({"MaxIter",100});
+    CHECK(hasQNs(ctm.corner(CTMRG::UL)));
+    CHECK(std::fabs(std::log(ctm.kappa())-logZ) < 1E-9);
+    }
+
+SECTION("PEPS Norm")
+    {
+    auto s = Index(2,"s"),
+         a = Index(2,"a"),
+         b = Index(2,"b");
+    auto A = randomITensor(s,a,prime(a),b,prime(b));
+    auto [TA,H,V] = normTensor(A,a,b);
+    CHECK(order(TA) == 4);
+    CHECK(dim(H) == 4);
+    CHECK(hasIndex(TA,prime(V)));
+
+    auto iso = CTMRG(TA,H,V,{"MaxDim",12});
+    iso.run({"MaxIter",100});
+    auto obl = CTMRG(TA,H,V,{"MaxDim",12,"Projector","Oblique"});
+    obl.run({"MaxIter",100});
+    CHECK(std::fabs(iso.kappa()/obl.kappa()-1) < 1E-8);
+    }
+
+}
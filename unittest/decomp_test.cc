@@ -182,6 +182,48 @@ SECTION("ITensor SVD")
 
     }
 
+SECTION("Randomized SVD")
+    {
+    auto i = Index(8,"i"),
+         j = Index(8,"j"),
+         l = Index(5,"l");
+    //Rank 5, so that the truncated SVD is exact
+    auto A = randomITensor(i,j,l)*randomITensor(l,prime(i),prime(j));
+    ITensor U(i,j),D,V;
+    auto spec = svd(A,U,D,V,{"MaxDim",6,"SVDMethod","randomized"});
+    CHECK(norm(A-U*D*V) < 1E-10*norm(A));
+    CHECK(dim(commonIndex(U,D)) <= 6);
+    CHECK(spec.truncerr() < 1E-10);
+
+    auto s = Index(QN(0),4,QN(1),4,"s"),
+         t = Index(QN(0),4,QN(1),4,"t"),
+         m = Index(QN(0),2,QN(1),2,"m");
+    auto B = randomITensor(QN(1),s,t,m)*randomITensor(QN(),dag(m),dag(prime(s)),dag(prime(t)));
+    auto [Ub,Db,Vb] = svd(B,{s,t},{"MaxDim",6,"SVDMethod","randomized"});
+    CHECK(hasQNs(Ub));
+    CHECK(norm(B-Ub*Db*Vb) < 1E-10*norm(B));
+
+    //Full rank with decaying singular values, truncated
+    //by MaxDim and by Cutoff: the truncation must match gesdd
+    auto k = Index(64,"k");
+    auto w = std::vector<Real>(dim(k));
+    for(auto n : range(w)) w[n] = std::pow(0.7,n);
+    auto C = randomITensor(i,j,k)*diagITensor(w,k,prime(k))*randomITensor(prime(k),prime(i),prime(j));
+    for(auto args : {Args("MaxDim",10),Args("Cutoff",1E-3)})
+        {
+        ITensor Ur(i,j),Dr,Vr;
+        auto specr = svd(C,Ur,Dr,Vr,{args,"SVDMethod","randomized","Oversample",20});
+        ITensor Ug(i,j),Dg,Vg;
+        auto specg = svd(C,Ug,Dg,Vg,{args,"SVDMethod","gesdd"});
+        CHECK(specg.truncerr() > 1E-6);
+        CHECK(dim(commonIndex(Ur,Dr)) == dim(commonIndex(Ug,Dg)));
+        CHECK(std::abs(specr.truncerr()-specg.truncerr()) < 1E-2*specg.truncerr());
+        auto errr = norm(C-Ur*Dr*Vr),
+             errg = norm(C-Ug*Dg*Vg);
+        CHECK(std::abs(errr-errg) < 1E-2*errg);
+        }
+    }
+
 SECTION("QN ITensor SVD")
     {
 
@@ -686,6 +728,21 @@ SECTION("ITensor diagHermitian")
         diagHermitian(T,U,D);
         CHECK(norm(T-U*D*prime(U,4)) < 1E-12);
         }
+
+    SECTION("EigMethod dsyevr")
+        {
+        auto i = Index(40);
+        auto T = randomITensor(i,prime(i));
+        T += swapTags(T,"0","1");
+        ITensor U,D,Ur,Dr;
+        diagHermitian(T,U,D);
+        diagHermitian(T,Ur,Dr,{"EigMethod","dsyevr"});
+        CHECK(norm(T-Ur*Dr*prime(Ur)) < 1E-12);
+        for(auto n : range1(dim(i)))
+            {
+            CHECK_CLOSE(elt(Dr,n,n),elt(D,n,n));
+            }
+        }
     }
 
 SECTION("ITensor diagHermitian (with QNs)")
@@ -703,6 +760,16 @@ SECTION("ITensor diagHermitian (with QNs)")
         CHECK(norm(T-dag(U)*D*prime(U)) < 1E-12);
         }
 
+    SECTION("Rank 2 - EigMethod dsyevr")
+        {
+        auto I = Index(QN(-1),4,QN(+1),4,"I");
+        auto T = randomITensor(QN(),dag(I),prime(I));
+        T += swapTags(dag(T),"0","1");
+        auto [U,D] = diagHermitian(T,{"EigMethod","dsyevr"});
+        CHECK(hasIndex(U,I));
+        CHECK(norm(T-dag(U)*D*prime(U)) < 1E-12);
+        }
+
     SECTION("Complex Rank 2")
         {
         auto I = Index(QN(-1),4,QN(+1),4,"I");
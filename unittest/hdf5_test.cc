@@ -175,5 +175,66 @@ SECTION("MPS")
     CHECK(abs(inner(M,H,M)-inner(M,read_H,M)) < 1E-8);
     }
 
+SECTION("Compressed ITensor")
+    {
+    auto i = Index(40,"i");
+    auto j = Index(30,"j");
+    auto T = randomITensorC(i,j);
+    auto s = SpinHalf(4);
+    auto Q = randomITensor(QN({"Sz",0}),prime(s(1)),prime(s(2)),dag(s(1)),dag(s(2)));
+
+    auto fo = h5_open("test.h5",'w');
+    h5_write(fo,"deflate",T,{"Compression","Deflate","CompressionLevel",6,"ChunkSize",100});
+    h5_write(fo,"lossy",T,{"Compression","Lossy","LossyDigits",6});
+    h5_write(fo,"qn_deflate",Q,{"Compression","Deflate"});
+    close(fo);
+
+    auto fi = h5_open("test.h5",'r');
+    CHECK(norm(T - h5_read<ITensor>(fi,"deflate")) < 1E-14);
+    CHECK(norm(Q - h5_read<ITensor>(fi,"qn_deflate")) < 1E-14);
+    auto L = h5_read<ITensor>(fi,"lossy");
+    auto maxerr = 0.;
+    for(auto n : range1(dim(i)))
+    for(auto m : range1(dim(j)))
+        {
+        maxerr = std::max(maxerr,std::abs(eltC(L,i=n,j=m)-eltC(T,i=n,j=m)));
+        }
+    CHECK(maxerr < 1E-6);
+    CHECK(maxerr > 0.);
+    }
+
+SECTION("Partial reads")
+    {
+    auto N = 4;
+    auto s = SpinHalf(N);
+    auto Q = randomITensor(QN({"Sz",0}),prime(s(1)),prime(s(2)),dag(s(1)),dag(s(2)));
+    auto M = randomMPS(SpinHalf(N,{"ConserveQNs=",false}),4);
+
+    //Z only stores the block {0,0,0,0}
+    auto Z = ITensor(inds(Q));
+    Z.set(prime(s(1))=1,prime(s(2))=1,s(1)=1,s(2)=1,1.);
+    Z *= 0.;
+
+    auto fo = h5_open("test.h5",'w');
+    h5_write(fo,"qnitensor",Q,{"Compression","Deflate","ChunkSize",1});
+    h5_write(fo,"zero_block",Z);
+    h5_write(fo,"mps",M);
+    close(fo);
+
+    auto fi = h5_open("test.h5",'r');
+    auto block = Block({0,1,0,1});
+    auto B = h5_read_block(fi,"qnitensor",block);
+    CHECK(nnzblocks(B) == 1);
+    CHECK(hasSameInds(inds(B),inds(Q)));
+    CHECK(elt(B,prime(s(1))=1,prime(s(2))=2,s(1)=1,s(2)=2)
+       == elt(Q,prime(s(1))=1,prime(s(2))=2,s(1)=1,s(2)=2));
+    //Blocks with zero flux which are not stored are zero
+    auto E = h5_read_block(fi,"zero_block",Block({0,1,1,0}));
+    CHECK(nnzblocks(E) == 1);
+    CHECK(norm(E) == 0.);
+
+    CHECK(norm(h5_read_site(fi,"mps",3) - M(3)) < 1E-14);
+    }
+
 }
 
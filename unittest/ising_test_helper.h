@@ -0,0 +1,47 @@
+#ifndef __ITENSOR_ISING_TEST_HELPER_H
+#define __ITENSOR_ISING_TEST_HELPER_H
+#include "itensor/itensor.h"
+
+namespace itensor {
+
+//Onsager's free energy per site -beta*f of the
+//square lattice Ising model
+Real inline
+onsagerLogZ(Real beta)
+    {
+    auto k = 2*std::sinh(2*beta)/std::pow(std::cosh(2*beta),2);
+    auto N = 20000;
+    auto dth = 0.5*M_PI/N;
+    auto I = 0.;
+    for(auto n : range(N))
+        {
+        auto sn = std::sin((n+0.5)*dth);
+        I += std::log(0.5*(1+std::sqrt(1-k*k*sn*sn)))*dth;
+        }
+    return std::log(2*std::cosh(2*beta)) + I/M_PI;
+    }
+
+//Ising model tensor in the basis of even and odd
+//bond states, with the site spin inserted if odd is true
+ITensor inline
+isingTensor(Index const& h,
+            Index const& v,
+            Real beta,
+            bool odd = false)
+    {
+    auto T = ITensor(h,dag(prime(h)),v,dag(prime(v)));
+    Real lambda[2] = {2*std::cosh(beta),2*std::sinh(beta)};
+    for(auto i : range(2))
+    for(auto j : range(2))
+    for(auto k : range(2))
+    for(auto l : range(2))
+        {
+        if((i+j+k+l)%2 != (odd ? 1 : 0)) continue;
+        T.set(i+1,j+1,k+1,l+1,0.5*std::sqrt(lambda[i]*lambda[j]*lambda[k]*lambda[l]));
+        }
+    return T;
+    }
+
+} //namespace itensor
+
+#endif
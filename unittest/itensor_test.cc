@@ -1,6 +1,8 @@
 #include "test.h"
 #include "itensor/itensor.h"
 #include "itensor/decomp.h"
+#include "itensor/tensorfile.h"
+#include "itensor/util/compress.h"
 #include "itensor/util/cplx_literal.h"
 #include "itensor/util/iterate.h"
 #include "itensor/util/set_scoped.h"
@@ -2192,6 +2194,103 @@ SECTION("Combiner")
                 }
             }
 
+        SECTION("Combine In Place (QN)")
+            {
+            auto s = Index(QN(+1),2,
+                           QN( 0),3,
+                           QN(-1),2,"s");
+            auto l = Index(QN(+2),1,
+                           QN( 0),4,
+                           QN(-2),1,"l");
+            auto T0 = randomITensor(QN(),l,s,prime(s));
+
+            auto checkInPlace = [&T0](ITensor const& C, bool in_place)
+                {
+                auto T = T0*2.;
+                auto* p = T.store().get();
+                T *= C;
+                CHECK((T.store().get() == p) == in_place);
+                CHECK(div(T) == div(T0));
+                CHECK(norm(dag(C)*T-2.*T0) < 1E-11);
+                //Combiner on the left copies but gives the same result
+                auto R = C*T0;
+                CHECK(norm(R-0.5*T) < 1E-11);
+                };
+
+            //Data of combined sectors are already adjacent
+            checkInPlace(std::get<0>(combiner(l)),true);
+            checkInPlace(std::get<0>(combiner(prime(s))),true);
+            checkInPlace(std::get<0>(combiner(s,prime(s))),true);
+            checkInPlace(std::get<0>(combiner(l,s,prime(s))),true);
+            //Combined sectors gather non-adjacent blocks
+            checkInPlace(std::get<0>(combiner(l,s)),false);
+            //Not contiguous or not in order
+            checkInPlace(std::get<0>(combiner(l,prime(s))),false);
+            checkInPlace(std::get<0>(combiner(prime(s),s)),false);
+            }
+
+        SECTION("Matricize")
+            {
+            auto s = Index(3,"s");
+            auto l = Index(4,"l");
+            auto r = Index(5,"r");
+            auto T0 = randomITensorC(l,s,prime(s),r);
+
+            auto checkMatricize = [&T0](IndexSet const& ris, IndexSet const& cis)
+                {
+                auto [Cr,cr] = combiner(ris);
+                auto [Cc,cc] = combiner(cis);
+                auto T = T0*2.;
+                auto* p = T.store().get();
+                auto M = matricize(std::move(T),Cr,Cc);
+                //Permuted, if needed, and combined in the storage of T
+                CHECK(M.store().get() == p);
+                CHECK(order(M) == 2);
+                CHECK(M.inds()[0] == cr);
+                CHECK(M.inds()[1] == cc);
+                CHECK(norm(M-2.*T0*Cr*Cc) < 1E-11);
+                };
+
+            //Row and column indices grouped in order
+            checkMatricize({l,s},{prime(s),r});
+            //Reordered or interleaved
+            checkMatricize({prime(s),r},{l,s});
+            checkMatricize({l,prime(s)},{r,s});
+            checkMatricize({s},{r,l,prime(s)});
+            }
+
+        SECTION("Matricize (QN)")
+            {
+            auto s = Index(QN(+1),2,
+                           QN( 0),3,
+                           QN(-1),2,"s");
+            auto l = Index(QN(+2),1,
+                           QN( 0),4,
+                           QN(-2),1,"l");
+            auto r = Index(QN(+1),3,
+                           QN(-1),2,"r");
+            auto T = randomITensorC(QN(+1),l,s,dag(prime(s)),r);
+
+            auto checkMatricize = [&T](IndexSet const& ris, IndexSet const& cis)
+                {
+                auto [Cr,cr] = combiner(ris);
+                auto [Cc,cc] = combiner(cis);
+                auto M = matricize(T,Cr,Cc);
+                CHECK(order(M) == 2);
+                CHECK(M.inds()[0] == cr);
+                CHECK(M.inds()[1] == cc);
+                CHECK(div(M) == div(T));
+                CHECK(norm(M-T*Cr*Cc) < 1E-12);
+                };
+
+            //Row and column indices grouped in order
+            checkMatricize({l,s},{dag(prime(s)),r});
+            checkMatricize({dag(prime(s)),r},{l,s});
+            //Interleaved or reordered
+            checkMatricize({l,dag(prime(s))},{r,s});
+            checkMatricize({s},{r,l,dag(prime(s))});
+            }
+
         //Uncombine back:
         //auto TT = C * R;
 
@@ -2884,6 +2983,153 @@ SECTION("Test setting elements of QN ITensor")
   CHECK(elt(A,l=1,s=1) == 0.0);
   }
 
+SECTION("TensorFile")
+  {
+  auto i = Index(3,"i"),
+       j = Index(4,"j");
+  auto q = Index(QN(0),2,QN(1),3,"q");
+  auto A = randomITensor(i,j);
+  auto B = randomITensorC(i,j);
+  auto Q = randomITensor(QN(0),q,dag(prime(q)));
+  auto D = diagITensor(std::vector<Real>{1.,2.,3.},i,prime(i));
+  auto fname = "tensorfile_test.dat";
+  writeTensorFile(fname,{A,B,Q,D,ITensor()});
+
+  TensorFile F(fname);
+  CHECK(F.size() == 5);
+  CHECK(F.kind() == "ITensors");
+  CHECK(hasSameInds(F.inds(2),inds(Q)));
+  CHECK(norm(F.read(0)-A) < 1E-14);
+  CHECK(norm(F.read(1)-B) < 1E-14);
+  CHECK(norm(F.read(2)-Q) < 1E-14);
+  CHECK(norm(F.read(3)-D) < 1E-14);
+  CHECK(not F.read(4));
+
+  //Read-only view of the data in the mapped file
+  auto d = F.data<Real>(0);
+  CHECK(d.size() == dim(i)*dim(j));
+  CHECK(d[0] == elt(A,i=1,j=1));
+  CHECK(reinterpret_cast<std::uintptr_t>(d.data()) % 64 == 0);
+  CHECK(F.data<Cplx>(1).size() == dim(i)*dim(j));
+  CHECK_THROWS_AS(F.data<Cplx>(0),ITError);
+
+  //Loaded tensors use the data in the mapped file
+  auto rawData = [](ITensor const& T)
+      {
+      auto G = GetRawData();
+      doTask(G,T.store());
+      return G.data;
+      };
+  auto A1 = F.read(0);
+  CHECK(rawData(A1) == reinterpret_cast<char const*>(d.data()));
+  CHECK(norm(A1*dag(F.read(1))-A*dag(B)) < 1E-12);
+  CHECK(norm(F.read(1)*A1-B*A) < 1E-12);
+  auto Q1 = F.read(2);
+  CHECK(norm(Q1*prime(Q1)-Q*prime(Q)) < 1E-12);
+  CHECK(norm(Q1*prime(Q)-Q*prime(Q)) < 1E-12);
+  CHECK(norm(prime(Q)*Q1-prime(Q)*Q) < 1E-12);
+  CHECK(div(Q1) == div(Q));
+
+  //Const access does not replace the mapped storage,
+  //also for tasks which are done on a copy of the data
+  auto const& cA1 = A1;
+  auto const& cQ1 = Q1;
+  CHECK(elt(cA1,i=2,j=3) == elt(A,i=2,j=3));
+  CHECK(elt(cQ1,q=4,prime(q)=3) == elt(Q,q=4,prime(q)=3));
+  CHECK(std::abs(sumels(cA1)-sumels(A)) < 1E-12);
+  auto nvisit = 0;
+  cQ1.visit([&nvisit](Real) { ++nvisit; });
+  CHECK(nvisit > 0);
+  CHECK(rawData(A1) == reinterpret_cast<char const*>(d.data()));
+  CHECK(rawData(Q1) == reinterpret_cast<char const*>(F.data<Real>(2).data()));
+
+  //Modifying a loaded tensor copies its data
+  //and leaves the file unchanged
+  auto A2 = F.read(0);
+  A2 *= 2;
+  A2.set(i=1,j=1,10.);
+  CHECK(rawData(A2) != rawData(A1));
+  CHECK(elt(A2,i=1,j=1) == 10.);
+  CHECK(norm(F.read(0)-A) < 1E-14);
+
+  //Mapped tensors stay valid after the TensorFile is
+  //closed and the file is replaced
+  auto Q2 = TensorFile(fname).read(2);
+  writeTensorFile(fname,{B});
+  CHECK(norm(Q2-Q) < 1E-14);
+  CHECK(norm(TensorFile(fname).read(0)-B) < 1E-14);
+  writeTensorFile(fname,{A,B,Q,D,ITensor()});
+
+  auto Ts = readTensorFile(fname);
+  CHECK(Ts.size() == 5);
+  CHECK(norm(Ts[2]-Q) < 1E-14);
+  std::remove(fname);
+  }
+
+SECTION("Spill files")
+  {
+  //Codec round trip on repetitive data
+  auto x = std::vector<Real>(1000);
+  for(auto n : range(x)) x[n] = (n%7)*0.25;
+  auto bytes = x.size()*sizeof(Real);
+  auto packed = shuffleCompress(reinterpret_cast<char const*>(x.data()),bytes,sizeof(Real));
+  CHECK(packed.size() < bytes/4);
+  auto y = std::vector<Real>(x.size());
+  shuffleDecompress(packed.data(),packed.size(),reinterpret_cast<char*>(y.data()),bytes,sizeof(Real));
+  CHECK(x == y);
+  CHECK_THROWS_AS(lzDecompress(packed.data(),packed.size()/2,reinterpret_cast<char*>(y.data()),bytes),ITError);
+
+  auto i = Index(30,"i"),
+       j = Index(40,"j");
+  auto q = Index(QN(0),20,QN(1),30,"q");
+  auto A = randomITensor(i,j);
+  auto B = randomITensorC(i,j);
+  auto Q = randomITensor(QN(0),q,dag(prime(q)));
+  auto k = Index(3,"k");
+  auto D = diagITensor(std::vector<Real>{1.,2.,3.},k,prime(k));
+  auto fname = "spill_test.dat";
+  auto st0 = spillStats();
+  for(auto codec : {SpillCodec::None,SpillCodec::LZ,SpillCodec::Mapped})
+  for(auto& T : {A,B,Q,D,ITensor()})
+      {
+      writeSpill(fname,T,codec);
+      auto R = ITensor();
+      readSpill(fname,R);
+      if(T) CHECK(norm(R-T) < 1E-14);
+      else  CHECK(not R);
+      }
+  CHECK(spillStats().nwrite == st0.nwrite+3);
+  CHECK(spillStats().nread == st0.nread+3);
+
+  //Compressible data
+  auto Z = ITensor(i,j);
+  Z.fill(0.5);
+  writeSpill(fname,Z,SpillCodec::LZ);
+  auto R = ITensor();
+  readSpill(fname,R);
+  CHECK(norm(R-Z) < 1E-14);
+  CHECK(spillStats().ratio() > 1.);
+
+  //A compressed unit marked as stored uncompressed
+  //does not have the size of the unit
+  auto z = std::vector<Real>(dim(i)*dim(j),0.5);
+  auto zpacked = shuffleCompress(reinterpret_cast<char const*>(z.data()),z.size()*sizeof(Real),sizeof(Real));
+  {
+  std::fstream f(fname,std::ios::in|std::ios::out|std::ios::binary);
+  auto flag = -long(zpacked.size()+sizeof(size_t)+sizeof(bool));
+  f.seekg(flag,std::ios::end);
+  CHECK(f.get() == 1);
+  f.seekp(flag,std::ios::end);
+  f.write("\0",1);
+  }
+  CHECK_THROWS_AS(readSpill(fname,R),ITError);
+  std::remove(fname);
+
+  CHECK(spillCodec({"WriteCompression","LZ"}) == SpillCodec::LZ);
+  CHECK(spillCodec({"WriteCompression","Mapped"}) == SpillCodec::Mapped);
+  CHECK(spillCodec(Args()) == SpillCodec::None);
+  }
+
 } //TEST_CASE("ITensor")
 
 
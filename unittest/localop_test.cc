@@ -143,6 +143,52 @@ SECTION("LocalOp: check product")
   CHECK_CLOSE(norm(Hpsi2-noPrime(psi2*L0*Op1*Op2*R2)),0.);
   }
 
+SECTION("DeltaRho")
+    {
+    //Reference: combine drho, then form the density matrix
+    auto checkDeltaRho = [](ITensor const& Op1, ITensor const& Op2,
+                            ITensor const& L, ITensor const& R,
+                            ITensor const& AA, IndexSet const& cinds, Direction dir)
+        {
+        auto lop = LocalOp(Op1,Op2,L,R,{"NumCenter=",2});
+        auto [C,ci] = combiner(cinds);
+        auto drho = lop.deltaRho(AA,C,dir);
+
+        auto ref = (dir == Fromleft) ? AA*L*Op1 : AA*R*Op2;
+        ref.noPrime();
+        ref = C * ref;
+        ref *= dag(prime(ref,ci));
+        ref = (ref + dag(swapTags(ref,"0","1")))/2.;
+        CHECK(order(drho) == 2);
+        CHECK(hasIndex(drho,ci));
+        CHECK(hasIndex(drho,prime(ci)));
+        CHECK(norm(drho-ref) < 1E-10*norm(ref));
+        };
+
+    SECTION("ITensor")
+        {
+        auto Op1 = randomITensor(s2,prime(s2),h0,h1);
+        auto s3 = Index(2,"Site");
+        auto Op2 = randomITensor(s3,prime(s3),h1,h2);
+        auto L = randomITensor(l0,prime(l0),h0);
+        auto R = randomITensor(l2,prime(l2),h2);
+        auto AA = randomITensor(l0,s2,s3,l2);
+        checkDeltaRho(Op1,Op2,L,R,AA,{l0,s2},Fromleft);
+        checkDeltaRho(Op1,Op2,L,R,AA,{s3,l2},Fromright);
+        }
+
+    SECTION("QN")
+        {
+        auto Op1 = randomITensor(QN(),dag(S1),prime(S1),dag(H0),H1);
+        auto Op2 = randomITensor(QN(),dag(S2),prime(S2),dag(H1),H2);
+        auto L = randomITensor(QN(),dag(L0),prime(L0),H0);
+        auto R = randomITensor(QN(),L2,dag(prime(L2)),dag(H2));
+        auto AA = randomITensor(QN(),L0,S1,S2,dag(L2));
+        checkDeltaRho(Op1,Op2,L,R,AA,{L0,S1},Fromleft);
+        checkDeltaRho(Op1,Op2,L,R,AA,{S2,dag(L2)},Fromright);
+        }
+    }
+
 SECTION("Diag")
     {
     SECTION("Bulk Case - ITensor")
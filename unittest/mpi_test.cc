@@ -0,0 +1,156 @@
+//
+// Tests of the MPI transfers in util/parallel.h. Built
+// separately from test-g, with a small message piece
+// size so that ITensor data is sent in several pieces:
+//
+//   make mpi
+//
+// runs it on two nodes.
+//
+#define CATCH_CONFIG_RUNNER
+#include "test.h"
+#include "itensor/all_basic.h"
+#include "itensor/util/parallel.h"
+
+using namespace itensor;
+using namespace std;
+
+static Environment* penv = nullptr;
+
+//Dense and QDense ITensors, real and complex, each
+//many pieces long, and ITensors with other storage
+vector<ITensor> static
+testTensors()
+    {
+    auto i = Index(12,"i"),
+         j = Index(9,"j");
+    auto s = Index(QN({"Sz",+1}),4,QN({"Sz",-1}),5,"s"),
+         t = Index(QN({"Sz",+1}),3,QN({"Sz",-1}),6,"t");
+    auto d = vector<Real>(9);
+    for(auto n : range(d.size())) d[n] = n+1;
+    return {2*randomITensor(i,j),
+            randomITensorC(i,j),
+            randomITensor(QN({"Sz",0}),s,dag(t)),
+            randomITensorC(QN({"Sz",0}),s,dag(t)),
+            diagITensor(d,i,j),
+            ITensor()};
+    }
+
+bool static
+sameTensor(ITensor const& A, ITensor const& B)
+    {
+    if(!A || !B) return !A && !B;
+    if(doTask(StorageType{},A.store()) != doTask(StorageType{},B.store())) return false;
+    if(order(A) != order(B)) return false;
+    for(auto n : range1(order(A))) if(inds(A)(n) != inds(B)(n)) return false;
+    return norm(A-B) == 0.;
+    }
+
+TEST_CASE("MPI")
+{
+auto& env = *penv;
+REQUIRE(detail::max_message_bytes < 100);
+auto other = 1-env.rank();
+auto tensors = testTensors();
+
+//Node 0 sends each ITensor to node 1,
+//which sends back what it received
+SECTION("MailBox send/receive")
+    {
+    auto mb = MailBox(env,other);
+    for(auto& T : tensors)
+        {
+        auto R = ITensor();
+        if(env.firstNode())
+            {
+            mb.send(T);
+            mb.receive(R);
+            CHECK(sameTensor(R,T));
+            }
+        else
+            {
+            mb.receive(R);
+            mb.send(R);
+            }
+        }
+    }
+
+SECTION("MailBox isend/ireceive")
+    {
+    auto mb = MailBox(env,other);
+    for(auto& T : tensors)
+        {
+        auto R = ITensor();
+        if(env.firstNode())
+            {
+            auto s = mb.isend(T);
+            auto r = mb.ireceive(R);
+            r.wait();
+            CHECK(s.test());
+            CHECK(sameTensor(R,T));
+            }
+        else
+            {
+            mb.ireceive(R).wait();
+            mb.isend(R).wait();
+            }
+        }
+    }
+
+SECTION("broadcast")
+    {
+    auto mb = MailBox(env,other);
+    for(auto& T : tensors)
+        {
+        auto B = env.firstNode() ? T : ITensor();
+        broadcast(env,B);
+        auto I = env.firstNode() ? T : ITensor();
+        ibroadcast(env,I).wait();
+        if(env.firstNode())
+            {
+            auto R = ITensor();
+            mb.receive(R);
+            CHECK(sameTensor(R,T));
+            mb.receive(R);
+            CHECK(sameTensor(R,T));
+            }
+        else
+            {
+            mb.send(B);
+            mb.send(I);
+            }
+        }
+    }
+
+SECTION("allReduce")
+    {
+    for(auto& T : tensors)
+        {
+        if(!T) continue;
+        broadcast(env,T);
+        for(auto chunk : {5,1<<20})
+            {
+            //A shares its storage with T,
+            //which must not be modified
+            auto nrm = norm(T);
+            auto A = T;
+            allReduce(env,A,{"ChunkSize",chunk});
+            CHECK(norm(T) == nrm);
+            CHECK(norm(A-2*T) < 1E-12*nrm);
+            }
+        }
+    }
+}
+
+int
+main(int argc, char* argv[])
+    {
+    Environment env(argc,argv);
+    if(env.nnodes() != 2)
+        {
+        if(env.firstNode()) println("mpi_test must be run on 2 nodes");
+        return 1;
+        }
+    penv = &env;
+    return Catch::Session().run(argc,argv);
+    }
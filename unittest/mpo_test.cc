@@ -7,7 +7,9 @@
 #include "itensor/mps/sites/electron.h"
 #include "itensor/mps/autompo.h"
 #include "itensor/mps/dmrg.h"
+#include "itensor/mps/TEvolObserver.h"
 #include "mps_mpo_test_helper.h"
+#include <filesystem>
 
 using namespace itensor;
 using namespace std;
@@ -601,4 +603,90 @@ SECTION("DMRG with QNs")
   CHECK_CLOSE((energy-energy_exact)/energy_exact,0.);
   }
 
+SECTION("DMRG writing to disk")
+  {
+  //LocalMPO and MPS tensors are written to spill files,
+  //with "Mapped" read back with storage in the mapped files
+  int N = 16;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto psi0 = randomMPS(InitState(sites,"Up"));
+
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j)
+      {
+      ampo += -1.0,"Sx",j,"Sx",j+1;
+      ampo += -0.5,"Sz",j;
+      }
+  ampo += -0.5,"Sz",N;
+  auto H = toMPO(ampo);
+
+  auto sweeps = Sweeps(5);
+  sweeps.maxdim() = 10,20,30;
+  sweeps.cutoff() = 1E-12;
+  auto [E1,psi1] = dmrg(H,psi0,sweeps,{"Silent",true});
+  auto dir = mkTempDir("dmrg_test");
+  auto [E2,psi2] = dmrg(H,psi0,sweeps,{"Silent",true,"WriteDim",10,"WriteDir",dir});
+  CHECK_CLOSE(E1,E2);
+  CHECK_CLOSE(std::abs(inner(psi1,psi2)),1.);
+  auto [E3,psi3] = dmrg(H,psi0,sweeps,{"Silent",true,"WriteDim",10,"WriteDir",dir,
+                                       "WriteCompression","Mapped"});
+  CHECK_CLOSE(E1,E3);
+  CHECK_CLOSE(std::abs(inner(psi1,psi3)),1.);
+  std::filesystem::remove_all(dir);
+  }
+
+SECTION("applyExpHAdaptive")
+  {
+  int N = 8;
+  auto sites = SpinHalf(N,{"ConserveQNs=",false});
+  auto ampo = AutoMPO(sites);
+  for(int j = 1; j < N; ++j)
+      {
+      ampo += 0.5,"S+",j,"S-",j+1;
+      ampo += 0.5,"S-",j,"S+",j+1;
+      ampo +=     "Sz",j,"Sz",j+1;
+      }
+  auto H = toMPO(ampo);
+  auto state = InitState(sites);
+  for(auto j : range1(N)) state.set(j,j%2==1 ? "Up" : "Dn");
+  auto psi0 = MPS(state);
+
+  auto ttotal = 0.5;
+  auto args = Args("Cutoff",1E-12,"MaxDim",100,"ErrorGoal",1E-6,"ShowPercent",false);
+  auto obs = TEvolObserver(args);
+  auto psi = MPS();
+  applyExpHAdaptive(psi0,H,ttotal,0.01,psi,obs,args);
+
+  auto& steps = obs.steps();
+  REQUIRE(steps.size() > 1);
+  CHECK_CLOSE(steps.front().tau,0.01);
+  CHECK_CLOSE(steps.back().time,ttotal);
+  auto tsum = 0.;
+  for(auto n : range(steps.size()))
+      {
+      auto& st = steps[n];
+      tsum += st.tau;
+      CHECK_CLOSE(st.time,tsum);
+      CHECK(st.error > 0.);
+      CHECK(st.error <= 1E-6);
+      //Each step after the first is the one proposed
+      //by the step before, except the last which is cut
+      //to end at ttotal
+      if(n > 0 && n+1 < steps.size()) CHECK_CLOSE(st.tau,steps[n-1].next_tau);
+      }
+  //Step grows from the (too small) initial step
+  CHECK(steps.size() < 50);
+
+  auto ref = psi0;
+  for(auto n : range(50))
+      {
+      (void)n;
+      auto next = ref;
+      applyExpH(ref,H,ttotal/50,next,args);
+      ref = next;
+      ref.normalize();
+      }
+  CHECK(std::abs(inner(psi,ref)) > 1-1E-6);
+  }
+
 }
@@ -1,5 +1,11 @@
 #include "test.h"
 #include "itensor/mps/mps.h"
+#include "itensor/mps/tevol.h"
+#include "itensor/mps/tebd.h"
+#include "itensor/mps/swapnetwork.h"
+#include "itensor/mps/mpsreader.h"
+#include "itensor/mps/metts.h"
+#include "itensor/mps/autompo.h"
 #include "itensor/mps/sites/spinhalf.h"
 #include "itensor/mps/sites/fermion.h"
 #include "itensor/util/print_macro.h"
@@ -348,6 +354,364 @@ SECTION("replaceSiteInds")
       CHECK( siteIndex(psi1_new,n)==siteIndex(psi2,n) );
     }
 
+SECTION("applyGate reduced update")
+    {
+    auto psi = MPS(shsites,4);
+    for(auto n : range1(N)) psi.ref(n).randomize();
+    psi.position(5);
+    //Truncate bond 5 so the outer links of sites 5, 6
+    //are larger than the part touched by the gate
+    psi.svdBond(5,psi(5)*psi(6),Fromright,{"MaxDim",1});
+    psi.normalize();
+
+    auto s5 = siteIndex(psi,5);
+    auto s6 = siteIndex(psi,6);
+    auto gate = randomITensor(prime(s5),prime(s6),dag(s5),dag(s6));
+
+    for(auto dir : {Fromleft,Fromright})
+        {
+        auto psi1 = psi;
+        auto psi2 = psi;
+        psi1.applyGate(5,gate,dir,{"Cutoff",1E-15});
+        psi2.applyGate(5,gate,dir,{"Cutoff",1E-15,"ReducedUpdate",true});
+        CHECK(isOrtho(psi2));
+        CHECK(dim(linkIndex(psi2,5)) == dim(linkIndex(psi1,5)));
+        auto exact = psi(5)*psi(6)*gate;
+        exact.mapPrime(1,0);
+        CHECK_CLOSE(norm(psi2(5)*psi2(6)-exact),0.);
+        CHECK_CLOSE(diff(psi1,psi2),0.);
+        }
+
+    //The free applyGate takes the same path
+    auto psi3 = psi;
+    applyGate(gate,psi3,{"Cutoff",1E-15,"ReducedUpdate",true});
+    auto exact = psi(5)*psi(6)*gate;
+    exact.mapPrime(1,0);
+    CHECK(isOrtho(psi3));
+    CHECK_CLOSE(norm(psi3(5)*psi3(6)-exact),0.);
+
+    //Both paths of the free applyGate unprime the same
+    //way, also for site indices not tagged "Site"
+    auto psi4 = removeTags(psi,"Site");
+    auto t5 = siteIndex(psi4,5);
+    auto t6 = siteIndex(psi4,6);
+    auto tgate = randomITensor(prime(t5),prime(t6),dag(t5),dag(t6));
+    auto psi5 = psi4;
+    applyGate(tgate,psi4,{"Cutoff",1E-15});
+    applyGate(tgate,psi5,{"Cutoff",1E-15,"ReducedUpdate",true});
+    CHECK(hasIndex(psi5(5),t5));
+    CHECK(hasIndex(psi5(6),t6));
+    CHECK_CLOSE(norm(psi4(5)*psi4(6)-psi5(5)*psi5(6)),0.);
+    }
+
+SECTION("VidalMPS TEBD")
+    {
+    auto hb = [&](int b)
+        {
+        auto& s = shsitesQNs;
+        return op(s,"Sz",b)*op(s,"Sz",b+1)
+             + 0.5*op(s,"S+",b)*op(s,"S-",b+1)
+             + 0.5*op(s,"S-",b)*op(s,"S+",b+1);
+        };
+    Real tau = 0.05;
+    auto gates = vector<BondGate>();
+    for(int b = 1; b < N; b += 2) gates.emplace_back(shsitesQNs,b,b+1,BondGate::tReal,tau/2,hb(b));
+    for(int b = 2; b < N; b += 2) gates.emplace_back(shsitesQNs,b,b+1,BondGate::tReal,tau,hb(b));
+    for(int b = 1; b < N; b += 2) gates.emplace_back(shsitesQNs,b,b+1,BondGate::tReal,tau/2,hb(b));
+
+    auto layers = gateLayers(gates);
+    CHECK(layers.size() == 3);
+
+    auto args = Args("Cutoff",1E-12,"ShowPercent",false);
+    auto psi = MPS(shNeelQNs);
+    gateTEvol(gates,0.5,tau,psi,args);
+
+    auto v = VidalMPS(MPS(shNeelQNs));
+    tebd(layers,0.5,tau,v,args);
+    auto phi = v.toMPS();
+    CHECK(isOrtho(phi));
+    CHECK_CLOSE(norm(phi),1.);
+    CHECK_CLOSE(std::abs(innerC(psi,phi)),1.);
+
+    for(auto b : range1(2,N-2))
+        {
+        CHECK_CLOSE(norm(v.Gamma(b)*v.Lambda(b)-v.B(b)),0.);
+        }
+
+    //Converting back to Vidal form preserves the state
+    auto w = VidalMPS(phi);
+    CHECK_CLOSE(std::abs(innerC(phi,w.toMPS())),1.);
+
+    //An exception thrown by a gate of a layer reaches the caller
+    auto& s = shsitesQNs;
+    auto bad = setElt(prime(s(1))=1,prime(s(2))=2);
+    CHECK_THROWS_AS(applyLayer({BondGate(s,1,2,bad)},w,args),ITError);
+    }
+
+SECTION("swapNetwork")
+    {
+    auto& sites = shsitesQNs;
+    auto hb = [&](int i, int j)
+        {
+        return op(sites,"Sz",i)*op(sites,"Sz",j)
+             + 0.5*op(sites,"S+",i)*op(sites,"S-",j)
+             + 0.5*op(sites,"S-",i)*op(sites,"S+",j);
+        };
+    auto full = [](MPS const& x)
+        {
+        auto T = x(1);
+        for(auto j : range1(2,length(x))) T *= x(j);
+        return T;
+        };
+
+    auto args = Args("Cutoff",1E-15,"ShowPercent",false);
+    auto psi = MPS(shNeelQNs);
+    auto nn = vector<BondGate>();
+    for(auto b : range1(N-1)) nn.emplace_back(sites,b,b+1,BondGate::tReal,0.7,hb(b,b+1));
+    gateTEvol(nn,1.,1.,psi,args);
+
+    auto gates = vector<BondGate>();
+    for(auto p : vector<std::pair<int,int>>{{1,4},{1,5},{2,5},{7,3},{3,9},{4,5},{2,10}})
+        {
+        gates.emplace_back(sites,p.first,p.second,BondGate::tReal,0.3,hb(p.first,p.second));
+        }
+    auto stats = SwapNetworkStats();
+    auto compiled = swapNetwork(sites,gates,stats);
+    CHECK(stats.ngates == 7);
+    CHECK(stats.cancelled_swaps > 0);
+    CHECK(stats.svdsSaved() > 0);
+    CHECK(stats.svds == int(compiled.size()));
+    for(auto& g : compiled) CHECK(g.i2() == g.i1()+1);
+
+    auto T = full(psi);
+    for(auto& g : gates)
+        {
+        T *= g.gate();
+        T.mapPrime(1,0);
+        }
+    gateTEvol(compiled,1.,1.,psi,args);
+    CHECK_CLOSE(norm(full(psi)-T),0.);
+    }
+
+SECTION("GateCache and fused steps")
+    {
+    auto& sites = shsitesQNs;
+    auto hb = [&](int b)
+        {
+        return op(sites,"Sz",b)*op(sites,"Sz",b+1)
+             + 0.5*op(sites,"S+",b)*op(sites,"S-",b+1)
+             + 0.5*op(sites,"S-",b)*op(sites,"S+",b+1);
+        };
+    Real tau = 0.05;
+    auto cache = GateCache();
+    auto gates = vector<BondGate>();
+    for(int b = 1; b < N; b += 2) gates.push_back(cache.get(sites,b,b+1,BondGate::tReal,tau/2,hb(b)));
+    for(int b = 2; b < N; b += 2) gates.push_back(cache.get(sites,b,b+1,BondGate::tReal,tau,hb(b)));
+    for(int b = 1; b < N; b += 2) gates.push_back(cache.get(sites,b,b+1,BondGate::tReal,tau/2,hb(b)));
+    CHECK(cache.size() == size_t(N-1));
+    CHECK(cache.hits() == size_t(N/2));
+    auto g = BondGate(sites,1,2,BondGate::tReal,tau/2,hb(1));
+    CHECK_CLOSE(norm(g.gate()-gates.front().gate()),0.);
+
+    //Continuously varying tau does not grow the cache without bound
+    auto h1 = hb(1);
+    auto bounded = GateCache();
+    for(auto n : range1(GateCache::maxSize()+1))
+        {
+        bounded.get(sites,1,2,BondGate::tReal,n*1E-4,h1);
+        }
+    CHECK(bounded.size() == 1);
+    CHECK(bounded.hits() == 0);
+
+    //Second order Trotter: odd half steps of 
+    //consecutive steps merge into full steps
+    auto fs = fuseSteps(gates);
+    CHECK(fs.first.size() == gates.size()-N/2);
+    CHECK(fs.middle.size() == gates.size()-N/2);
+    CHECK(fs.last.size() == size_t(N/2));
+
+    auto args = Args("Cutoff",1E-14,"ShowPercent",false);
+    auto psi1 = MPS(shNeelQNs);
+    gateTEvol(gates,0.5,tau,psi1,args);
+    auto psi2 = MPS(shNeelQNs);
+    gateTEvol(gates,0.5,tau,psi2,{args,"FuseSteps",true});
+    CHECK_CLOSE(std::abs(innerC(psi1,psi2)),1.);
+
+    //Consecutive gates on the same bond are merged
+    auto two = vector<BondGate>{gates.front(),gates.front()};
+    auto fused = fuseGates(two);
+    CHECK(fused.size() == 1);
+    auto full = BondGate(sites,1,2,BondGate::tReal,tau,hb(1));
+    CHECK_CLOSE(norm(fused.front().gate()-full.gate()),0.);
+    }
+
+SECTION("gateTEvolAdaptive")
+    {
+    auto& sites = shsitesQNs;
+    auto hb = [&](int b)
+        {
+        return op(sites,"Sz",b)*op(sites,"Sz",b+1)
+             + 0.5*op(sites,"S+",b)*op(sites,"S-",b+1)
+             + 0.5*op(sites,"S-",b)*op(sites,"S+",b+1);
+        };
+    auto cache = GateCache();
+    auto makeGates = [&](Real tau)
+        {
+        auto gates = vector<BondGate>();
+        for(int b = 1; b < N; b += 2) gates.push_back(cache.get(sites,b,b+1,BondGate::tReal,tau/2,hb(b)));
+        for(int b = 2; b < N; b += 2) gates.push_back(cache.get(sites,b,b+1,BondGate::tReal,tau,hb(b)));
+        for(int b = 1; b < N; b += 2) gates.push_back(cache.get(sites,b,b+1,BondGate::tReal,tau/2,hb(b)));
+        return gates;
+        };
+
+    auto args = Args("Cutoff",1E-12,"ShowPercent",false,"ErrorGoal",1E-5);
+    auto psi = MPS(shNeelQNs);
+    auto obs = TEvolObserver(args);
+    gateTEvolAdaptive(makeGates,0.7,0.01,psi,obs,args);
+
+    auto& steps = obs.steps();
+    REQUIRE(steps.size() > 1);
+    CHECK_CLOSE(steps.back().time,0.7);
+    //Step grows from the (too small) initial step
+    CHECK(steps[1].tau > steps[0].tau);
+    for(auto& st : steps) CHECK(st.error <= 1E-5);
+
+    auto ref = MPS(shNeelQNs);
+    gateTEvol(makeGates(0.01),0.7,0.01,ref,args);
+    CHECK(std::abs(innerC(psi,ref)) > 1-1E-6);
+
+    //The error estimate resolves differences
+    //far below the square root of the precision
+    CHECK(stepError(psi,psi) < 1E-13);
+    CHECK(std::abs(stepError((1+1E-11)*psi,psi)-1E-11) < 1E-14);
+    }
+
+SECTION("TensorFile")
+    {
+    auto psi = randomMPS(shNeelQNs);
+    psi.position(3);
+    auto fname = "mps_tensorfile_test.dat";
+    writeTensorFile(fname,psi);
+
+    auto phi = MPS();
+    readTensorFile(fname,phi);
+    CHECK(length(phi) == length(psi));
+    CHECK(orthoCenter(phi) == 3);
+    CHECK_CLOSE(diff(phi,psi),0.);
+
+    //Read a single site
+    TensorFile F(fname);
+    CHECK(norm(F.read(1)-psi(2)) < 1E-14);
+    std::remove(fname);
+    }
+
+SECTION("Compressed doWrite")
+    {
+    auto psi = randomMPS(shsites,4);
+    auto psi0 = psi;
+    auto st0 = spillStats();
+    psi.doWrite(true,{"WriteCompression","LZ","WriteAll",true});
+    psi.position(1);
+    psi.position(N);
+    psi.doWrite(false);
+    CHECK(spillStats().nwrite > st0.nwrite);
+    CHECK(spillStats().nread > st0.nread);
+    CHECK_CLOSE(inner(psi,psi0),inner(psi0,psi0));
+    }
+
+SECTION("METTS")
+    {
+    auto rng = std::mt19937_64(1);
+
+    //Collapsing a product state gives it back
+    auto states = std::vector<int>(N+1,0);
+    for(auto j : range1(N)) states[j] = (j%3 == 0) ? 2 : 1;
+    auto psi = productMPS(shsites,states);
+    CHECK(collapse(psi,rng,{"Direction=","Z"}) == states);
+    psi = productMPS(shsites,states,"X");
+    CHECK(collapse(psi,rng,{"Direction=","X"}) == states);
+
+    //Sampling frequencies match |psi|^2
+    auto phi = randomMPS(shsites,3);
+    phi.normalize();
+    auto nup = 0;
+    int nsample = 2000;
+    for(int n = 0; n < nsample; ++n)
+        {
+        auto p = phi;
+        if(collapse(p,rng)[2] == 1) nup += 1;
+        }
+    phi.position(2);
+    auto C = phi(2);
+    auto pup = 0.5+elt(dag(prime(C,"Site"))*op(shsites,"Sz",2)*C);
+    CHECK(std::fabs(Real(nup)/nsample-pup) < 0.05);
+
+    //Checkpointing a chain
+    std::seed_seq seed{1,2,3};
+    auto chain = METTSChain(shsites,seed);
+    auto evolve = [](MPS&) { };
+    auto s1 = chain.sample(evolve);
+    chain.collapse(s1);
+    auto ss = std::stringstream();
+    chain.write(ss);
+    auto copy = METTSChain(shsites,seed);
+    copy.read(ss);
+    CHECK(copy.step() == 1);
+    CHECK(copy.direction() == "X");
+    auto a = chain.sample(evolve),
+         b = copy.sample(evolve);
+    chain.collapse(a);
+    copy.collapse(b);
+    CHECK(chain.state() == copy.state());
+    }
+
+SECTION("MPSReader")
+    {
+    auto psi = randomMPS(shsites,4);
+    psi.ref(2) *= 1.7;
+    psi.position(4);
+    auto fname = "mps_reader_test.dat";
+
+    //Write one site at a time
+        {
+        TensorFileWriter W(fname);
+        for(auto j : range1(N)) W.append(psi(j));
+        W.close("MPS",{long(N),long(psi.leftLim()),long(psi.rightLim())});
+        }
+
+    auto r = MPSReader(fname);
+    CHECK(length(r) == N);
+    CHECK(r.orthoCenter() == 4);
+    CHECK_CLOSE(inner(r,r),inner(psi,psi));
+
+    auto ampo = AutoMPO(shsites);
+    for(auto j : range1(N-1)) ampo += "Sz",j,"Sz",j+1;
+    auto H = toMPO(ampo);
+    CHECK_CLOSE(inner(r,H,r),inner(psi,H,psi));
+
+    auto ex = expect(r,shsites,"Sz");
+    auto S = entanglementEntropies(r);
+    auto nrm2 = inner(psi,psi);
+    for(auto j : range1(N))
+        {
+        psi.position(j);
+        auto C = psi(j);
+        auto Sz = elt(dag(prime(C,"Site"))*op(shsites,"Sz",j)*C)/nrm2;
+        CHECK_CLOSE(ex[j-1],Sz);
+        if(j == N) continue;
+        auto [U,D,V] = svd(C,uniqueInds(inds(C),inds(psi(j+1))));
+        auto u = commonIndex(U,D);
+        auto SvN = 0.;
+        for(auto n : range1(dim(u)))
+            {
+            auto p = sqr(elt(D,n,n))/nrm2;
+            if(p > 1E-16) SvN -= p*std::log(p);
+            }
+        CHECK_CLOSE(S[j-1],SvN);
+        }
+    std::remove(fname);
+    }
+
 SECTION("prime")
     {
     auto s = SpinHalf(N,{"ConserveQNs=",false});
@@ -161,5 +161,55 @@ SECTION("tJ")
     op(sites,"Adn",2); 
     op(sites,"F",2); 
     }
-}
 
+SECTION("Operator cache")
+    {
+    auto sites = SpinHalf(N,{"ConserveQNs=",false});
+
+    auto Sz = op(sites,"Sz",3);
+    CHECK(norm(op(sites,"Sz",3)-Sz) < 1E-12);
+
+    //Modifying a returned operator must not
+    //change what later calls return
+    auto T = op(sites,"Sz",3);
+    T.set(1,1,10.);
+    T *= 3.;
+    CHECK(norm(op(sites,"Sz",3)-Sz) < 1E-12);
+
+    //Operators on different sites have different indices
+    CHECK(hasIndex(op(sites,"Sz",4),sites(4)));
+
+    //Products of operators
+    auto SzSz = op(sites,"Sz*Sz",3);
+    CHECK(norm(SzSz-0.25*op(sites,"Id",3)) < 1E-12);
+
+    //Args are part of the cache key
+    auto P1 = op(sites,"Proj",3,{"State=",1});
+    auto P2 = op(sites,"Proj",3,{"State=",2});
+    CHECK(elt(P1,1,1) == 1.);
+    CHECK(elt(P1,2,2) == 0.);
+    CHECK(elt(P2,1,1) == 0.);
+    CHECK(elt(P2,2,2) == 1.);
+
+    //Args are compared exactly, and the
+    //cache stays bounded for Real args
+    auto cache = OpCache();
+    auto s = sites(1);
+    auto count = 0;
+    auto make = [&count,&s]() { ++count; return ITensor(s); };
+    cache.get(s,"A",{"t",1.},make);
+    cache.get(s,"A",{"t",1.+1E-15},make);
+    cache.get(s,"A",{"t",1.},make);
+    CHECK(count == 2);
+    for(auto n : range(OpCache::maxSize()+10))
+        {
+        cache.get(s,"A",{"t",1E-3*n},make);
+        }
+    CHECK(cache.size() <= OpCache::maxSize());
+
+    //Empty args give an empty key without serializing
+    CHECK(Args().key().empty());
+    CHECK(not Args("t",1.).key().empty());
+    }
+
+}
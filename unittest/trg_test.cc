@@ -0,0 +1,56 @@
+#include "test.h"
+#include "itensor/tn/trg.h"
+#include "ising_test_helper.h"
+
+using namespace itensor;
+
+TEST_CASE("TRGTest")
+{
+auto betac = 0.5*std::log(1+std::sqrt(2.));
+auto beta = 1.1*betac;
+auto logZ = onsagerLogZ(beta);
+
+auto h = Index(2,"h"),
+     v = Index(2,"v");
+auto T = isingTensor(h,v,beta);
+
+SECTION("TRG")
+    {
+    auto trg = TRG(T,h,v,{"MaxDim",12});
+    auto lz = trg.run({"NScales",20});
+    CHECK(std::fabs(lz-logZ) < 1E-5);
+    CHECK(trg.scales().size() == 20);
+    CHECK(trg.scales().back().maxdim == 12);
+    CHECK(trg.scales().back().logZ == lz);
+    CHECK(trg.scales()[4].truncerr > 0.);
+    CHECK(trg.scales()[4].truncerr < 1E-4);
+
+    //Same truncation as with the full SVD
+    auto full = TRG(T,h,v,{"MaxDim",12,"SVDMethod","gesdd"});
+    CHECK(std::fabs(full.run({"NScales",20})-lz) < 1E-10);
+    }
+
+SECTION("HOTRG")
+    {
+    auto trg = TRG(T,h,v,{"MaxDim",10,"Method","HOTRG"});
+    auto lz = trg.run({"NScales",20});
+    CHECK(std::fabs(lz-logZ) < 1E-6);
+    CHECK(trg.scales().back().maxdim == 10);
+    }
+
+SECTION("QN")
+    {
+    auto hq = Index(QN({"P",0,2}),1,QN({"P",1,2}),1,"h"),
+         vq = Index(QN({"P",0,2}),1,QN({"P",1,2}),1,"v");
+    auto Tq = isingTensor(hq,vq,beta);
+    for(auto method : {"TRG","HOTRG"})
+        {
+        auto trg = TRG(Tq,hq,vq,{"MaxDim",10,"Method",method});
+        auto lz = trg.run({"NScales",20});
+        CHECK(hasQNs(trg.T()));
+        auto dense = TRG(T,h,v,{"MaxDim",10,"Method",method});
+        CHECK(std::fabs(dense.run({"NScales",20})-lz) < 1E-10);
+        }
+    }
+
+}
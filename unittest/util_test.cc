@@ -3,6 +3,9 @@
 #include "itensor/global.h"
 #include "itensor/util/infarray.h"
 #include "itensor/util/stats.h"
+#include "itensor/util/profiler.h"
+#include <fstream>
+#include <thread>
 
 using namespace itensor;
 using namespace std;
@@ -259,5 +262,95 @@ SECTION("BinErr")
     for(int n = 1; n <= N; ++n) st.putin(Global::random());
     CHECK(st.binerr(10) < 0.51/std::sqrt(N-1));
     }
+SECTION("BinningStats")
+    {
+    auto st = Stats();
+    auto bst = BinningStats();
+    int N = 1024;
+    for(int n = 1; n <= N; ++n)
+        {
+        auto x = Global::random();
+        st.putin(x);
+        bst.putin(x);
+        }
+    CHECK(bst.count() == N);
+    CHECK_CLOSE(bst.avg(),st.avg());
+    CHECK_CLOSE(bst.err(0),st.err());
+    CHECK_CLOSE(bst.err(3),st.binerr(8));
+
+    //Strongly correlated series: runs of 16 equal values
+    auto corr = BinningStats();
+    for(int n = 0; n < N; ++n) corr.putin((n/16)%2 == 0 ? 1. : 0.);
+    CHECK(corr.err() > 3*corr.err(0));
+    CHECK(corr.tau() > 4.);
+
+    //Combining chains
+    auto b1 = BinningStats(),
+         b2 = BinningStats();
+    for(int n = 0; n < 64; ++n) b1.putin(1.);
+    for(int n = 0; n < 64; ++n) b2.putin(3.);
+    b1 += b2;
+    CHECK(b1.count() == 128);
+    CHECK_CLOSE(b1.avg(),2.);
+    }
+}
+
+TEST_CASE("Profiler")
+{
+auto work = []
+    {
+    PROFILE_REGION("test outer");
+    for(int n = 0; n < 3; ++n)
+        {
+        PROFILE_START(p,"test inner");
+        volatile double x = 0;
+        for(int k = 0; k < 1000; ++k) x = x+k;
+        PROFILE_STOP(p);
+        }
+    };
+
+SECTION("Disabled")
+    {
+    profiler().enable(false);
+    profiler().reset();
+    work();
+    CHECK(profiler().calls("test outer") == 0);
+    }
+
+SECTION("Regions")
+    {
+    profiler().enable(true);
+    profiler().trace(true);
+    profiler().reset();
+    work();
+    auto t = std::thread(work);
+    t.join();
+    profiler().enable(false);
+
+    CHECK(profiler().calls("test outer") == 2);
+    CHECK(profiler().calls("test outer/test inner") == 6);
+    CHECK(profiler().calls("test inner") == 0);
+    CHECK(profiler().time("test outer") >= profiler().time("test outer/test inner"));
+
+    auto csv = "profile_test.csv";
+    profiler().writeCSV(csv);
+    std::ifstream f(csv);
+    auto line = std::string();
+    std::getline(f,line);
+    CHECK(line == "thread,path,calls,total_s,self_s");
+    auto nrows = 0;
+    while(std::getline(f,line)) if(line.find("test outer/test inner") != std::string::npos) ++nrows;
+    CHECK(nrows == 2);
+    std::remove(csv);
+
+    auto json = "profile_test.json";
+    profiler().writeChromeTrace(json);
+    std::ifstream j(json);
+    auto content = std::string((std::istreambuf_iterator<char>(j)),std::istreambuf_iterator<char>());
+    CHECK(content.find("\"name\":\"test inner\",\"ph\":\"X\"") != std::string::npos);
+    std::remove(json);
+    profiler().trace(false);
+    profiler().reset();
+    }
 }
 